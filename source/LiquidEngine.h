@@ -49,6 +49,7 @@
 #include "animation/Animator.h"
 
 #include "common/Camera.h"
+#include "common/ChunkProvider.h"
 #include "common/Entity.h"
 #include "common/GameManager.h"
 #include "common/GameScene.h"
@@ -56,12 +57,19 @@
 #include "common/LuaFuncs.h"
 #include "common/LuaManager.h"
 #include "common/Particle.h"
+#include "common/ParticleBuffer.h"
 #include "common/ParticleEmitter.h"
 #include "common/ResourceManager.h"
+#include "common/SystemRegistry.h"
+#include "common/TileMapLayer.h"
+#include "common/WorldChunk.h"
+#include "common/WorldStreamer.h"
 
+#include "data/AtlasPacker.h"
 #include "data/Bindings.h"
 #include "data/Directories.h"
 #include "data/ParticleData.h"
+#include "data/SceneSnapshot.h"
 #include "data/Settings.h"
 #include "data/TextureAtlas.h"
 
@@ -72,16 +80,34 @@
 #include "events/MouseEventData.h"
 #include "events/WindowEventData.h"
 
+#include "graphics/DrawList.h"
 #include "graphics/IRenderable.h"
 #include "graphics/Light.h"
+#include "graphics/LightCuller.h"
+#include "graphics/LightMeshCache.h"
 #include "graphics/LightingManager.h"
+#include "graphics/RenderCommandBuffer.h"
 #include "graphics/Renderer.h"
+#include "graphics/RenderSnapshot.h"
+#include "graphics/RenderSnapshotBuffer.h"
+#include "graphics/RenderStats.h"
+#include "graphics/RenderVertex.h"
+#include "graphics/ShadowCaster.h"
+#include "graphics/SpriteExpander.h"
+#include "graphics/SpriteInstance.h"
+
+#include "impl/null/NullEventManager.h"
+#include "impl/null/NullRenderer.h"
 
 #include "impl/sfml/SFMLBatchGroup.h"
 #include "impl/sfml/SFMLCamera.h"
 #include "impl/sfml/SFMLEventManager.h"
 #include "impl/sfml/SFMLLightingManager.h"
 #include "impl/sfml/SFMLRenderer.h"
+#include "impl/sfml/SFMLTextureCache.h"
+
+#include "impl/software/SoftwareLightingManager.h"
+#include "impl/software/SoftwareRenderer.h"
 
 #include "navigation/AStar.h"
 #include "navigation/NavEdge.h"
@@ -113,8 +139,13 @@
 #include "tweener/TweenerSequence.h"
 
 #include "utilities/DeltaTime.h"
+#include "utilities/DepthSorter.h"
+#include "utilities/MappedFile.h"
+#include "utilities/PNGWriter.h"
 #include "utilities/Random.h"
+#include "utilities/Span.h"
 #include "utilities/Stack.h"
+#include "utilities/ThreadPool.h"
 #include "utilities/Vertex2.h"
 
 #endif // _LIQUIDENGINE_H
@@ -94,6 +94,21 @@ int main()
     //tests.lighting();
     //tests.navigation();
     //tests.batchedSFMLRendering(texture);
+    //tests.sceneSnapshot();
+    //tests.spriteExpansion();
+    //tests.softwareRendering();
+    //tests.commandReplay();
+    //tests.atlasPacking();
+    //tests.shadowCasting();
+    //tests.softwareLighting();
+    //tests.particleSimulation();
+    //tests.frameLimiting();
+    //tests.headlessTicks();
+    //tests.worldStreaming();
+    //tests.systemDispatch();
+    //tests.depthSorting();
+    //tests.layerBaking();
+    //tests.tileMapLayer();
 
     liquid::events::EventDispatcher<liquid::events::KeyboardEventData>::addListener(
         [&cam = camera](const liquid::events::KeyboardEventData& evnt)->bool
@@ -383,7 +383,7 @@ void Tests::animation(sf::Texture& texture)
         animation.push_back(liquid::animation::AnimationFrame({ 650,450 }, { 780,450 }, { 780, 600 }, { 650,600 }, 35.0f));
 
         animator->insertAnimation("run", animation);*/
-        std::vector<liquid::utilities::Vertex2*> verts = player->getVertices();
+        liquid::utilities::Span<liquid::utilities::Vertex2* const> verts = player->getVertices();
 
         animator->transformAnimation("run");
         animator->setEntityPtr(player);
@@ -430,8 +430,8 @@ void Tests::ai(sf::Texture& texture)
     entity0->mAtlasID = resID;
     entity1->mAtlasID = resID;
 
-    std::vector<liquid::utilities::Vertex2*> entity0Verts = entity0->getVertices();
-    std::vector<liquid::utilities::Vertex2*> entity1Verts = entity1->getVertices();
+    liquid::utilities::Span<liquid::utilities::Vertex2* const> entity0Verts = entity0->getVertices();
+    liquid::utilities::Span<liquid::utilities::Vertex2* const> entity1Verts = entity1->getVertices();
 
     entity0->createAIAgent();
     entity1->createAIAgent();
@@ -512,3 +512,1109 @@ void Tests::ai(sf::Texture& texture)
     scene->addAnimator(animator0);
     scene->addAnimator(animator1);
 }
+
+void Tests::sceneSnapshot()
+{
+    const uint32_t entityCount = 100000;
+
+    liquid::common::GameScene* scene = new liquid::common::GameScene();
+    liquid::common::Layer* layer0 = new liquid::common::Layer(scene);
+    liquid::common::Layer* layer1 = new liquid::common::Layer(scene);
+    std::vector<liquid::common::Entity*> entities0, entities1;
+
+    for (uint32_t i = 0; i < entityCount; i++)
+    {
+        liquid::common::Entity* entity = new liquid::common::Entity();
+        entity->setEntityType(i % 7);
+        entity->setEntityUID("entity" + std::to_string(i));
+        entity->setPosition(liquid::utilities::Random::instance().randomRange(0.0f, 10000.0f),
+                            liquid::utilities::Random::instance().randomRange(0.0f, 10000.0f));
+        entity->mAtlasID = i % 3;
+        entity->mTextureName = (i % 2 == 0) ? "test.png" : "test2.png";
+
+        if (i % 10 == 0)
+        {
+            entity->createAIAgent();
+            entity->getAIAgent()->setVelocityX(1.0f);
+            entity->getAIAgent()->setMass(2.0f);
+        }
+
+        // Give every hundredth Entity the previous one as a parent
+        if (i % 100 == 99)
+            entity->setParentEntity((i % 2 == 0) ? entities0.back() : entities1.back());
+
+        if (i % 2 == 0)
+            entities0.push_back(entity);
+        else
+            entities1.push_back(entity);
+    }
+
+    layer0->insertEntity(entities0);
+    layer1->insertEntity(entities1);
+    scene->insertLayer("background", layer0);
+    scene->insertLayer("foreground", layer1);
+
+    const std::string path = getTempPath("snapshot.lqss");
+    const std::string corruptPath = getTempPath("snapshot_corrupt.lqss");
+    const float targetTime = 100.0f;
+
+    liquid::data::SceneSnapshot saved, loaded, restored;
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+    bool written = saved.capture(scene) && saved.save(path);
+    std::chrono::high_resolution_clock::time_point saveEnd = std::chrono::high_resolution_clock::now();
+
+    liquid::common::GameScene* restoredScene = new liquid::common::GameScene();
+    bool read = loaded.load(path) && loaded.restore(restoredScene);
+    std::chrono::high_resolution_clock::time_point restoreEnd = std::chrono::high_resolution_clock::now();
+
+    restored.capture(restoredScene);
+
+    float saveTime = std::chrono::duration<float, std::milli>(saveEnd - start).count();
+    float restoreTime = std::chrono::duration<float, std::milli>(restoreEnd - saveEnd).count();
+    bool matches = written && read && saved.getEntityCount() == entityCount && saved.equals(loaded) && saved.equals(restored);
+
+    std::cout << "Snapshot of " << saved.getEntityCount() << " entities, " << saved.getSize() << " bytes" << std::endl;
+    std::cout << "Capture and save: " << saveTime << "ms " << (saveTime < targetTime ? "(pass)" : "(FAIL)") << std::endl;
+    std::cout << "Load and restore: " << restoreTime << "ms " << (restoreTime < targetTime ? "(pass)" : "(FAIL)") << std::endl;
+    std::cout << "Round trip " << (matches ? "matches (pass)" : "DIFFERS (FAIL)") << std::endl;
+
+    // A vertex range that wraps past the end of the vertex blocks must be rejected on load
+    std::ifstream input(path, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    input.close();
+
+    liquid::data::SceneSnapshot::Header header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    uint32_t firstVertex = 1, vertexCount = 0xFFFFFFFF;
+    std::memcpy(&bytes[header.mBlocks[liquid::data::SceneSnapshot::BLOCK_ENTITY_FIRST_VERTEX]], &firstVertex, sizeof(firstVertex));
+    std::memcpy(&bytes[header.mBlocks[liquid::data::SceneSnapshot::BLOCK_ENTITY_VERTEX_COUNT]], &vertexCount, sizeof(vertexCount));
+
+    std::ofstream output(corruptPath, std::ios::binary);
+    output.write(bytes.data(), bytes.size());
+    output.close();
+
+    liquid::data::SceneSnapshot corrupt;
+    std::cout << "Corrupt vertex range " << (corrupt.load(corruptPath) ? "ACCEPTED (FAIL)" : "rejected (pass)") << std::endl;
+
+    // The mapped files have to be released before they can be removed
+    loaded.clear();
+    corrupt.clear();
+    std::remove(path.c_str());
+    std::remove(corruptPath.c_str());
+
+    scene->removeAllLayers();
+    restoredScene->removeAllLayers();
+    delete scene;
+    delete restoredScene;
+}
+
+void Tests::spriteExpansion()
+{
+    const uint32_t spriteCount = 100003;
+    const uint32_t repeats = 20;
+
+    std::vector<liquid::graphics::SpriteInstance> instances(spriteCount);
+    std::vector<liquid::graphics::RenderVertex> expected(spriteCount * 4), vertices(spriteCount * 4);
+    liquid::utilities::Random& random = liquid::utilities::Random::instance();
+
+    for (uint32_t i = 0; i < spriteCount; i++)
+    {
+        liquid::graphics::SpriteInstance& instance = instances[i];
+        instance.mPositionX = random.randomRange(0.0f, 1920.0f);
+        instance.mPositionY = random.randomRange(0.0f, 1080.0f);
+        instance.mOriginX = 0.5f;
+        instance.mOriginY = 0.5f;
+        instance.mWidth = random.randomRange(8.0f, 64.0f);
+        instance.mHeight = random.randomRange(8.0f, 64.0f);
+        instance.mRotation = (i % 3 == 0) ? 0.0f : random.randomRange(-360.0f, 360.0f);
+        instance.mTexLeft = random.randomRange(0.0f, 256.0f);
+        instance.mTexTop = random.randomRange(0.0f, 256.0f);
+        instance.mTexWidth = 32.0f;
+        instance.mTexHeight = 32.0f;
+        instance.mColour[0] = i & 255;
+        instance.mColour[1] = (i >> 8) & 255;
+        instance.mColour[2] = 128;
+        instance.mColour[3] = 255;
+    }
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    for (uint32_t r = 0; r < repeats; r++)
+        liquid::graphics::SpriteExpander::expandScalar(instances.data(), spriteCount, expected.data());
+
+    std::chrono::high_resolution_clock::time_point scalarEnd = std::chrono::high_resolution_clock::now();
+    for (uint32_t r = 0; r < repeats; r++)
+        liquid::graphics::SpriteExpander::expand(instances.data(), spriteCount, vertices.data());
+
+    std::chrono::high_resolution_clock::time_point vectorEnd = std::chrono::high_resolution_clock::now();
+
+    // The vector kernels approximate sine and cosine, positions only need to agree closely
+    uint32_t mismatches = 0;
+    for (uint32_t v = 0; v < spriteCount * 4; v++)
+    {
+        if (std::fabs(expected[v].mPositionX - vertices[v].mPositionX) > 1e-3f ||
+            std::fabs(expected[v].mPositionY - vertices[v].mPositionY) > 1e-3f ||
+            expected[v].mTexCoordX != vertices[v].mTexCoordX ||
+            expected[v].mTexCoordY != vertices[v].mTexCoordY ||
+            std::memcmp(expected[v].mColour, vertices[v].mColour, 4) != 0)
+            mismatches++;
+    }
+
+    std::cout << "Expanded " << spriteCount << " sprites with " << liquid::graphics::SpriteExpander::getInstructionSetName() << std::endl;
+    std::cout << "Scalar: " << std::chrono::duration<float, std::milli>(scalarEnd - start).count() / repeats << "ms" << std::endl;
+    std::cout << "Vector: " << std::chrono::duration<float, std::milli>(vectorEnd - scalarEnd).count() / repeats << "ms" << std::endl;
+    std::cout << "Vertices " << (mismatches == 0 ? "match" : "DIFFER") << " (" << mismatches << " mismatches)" << std::endl;
+}
+
+void Tests::createSpriteSnapshot(liquid::graphics::RenderSnapshot& snapshot, uint32_t spriteCount)
+{
+    liquid::utilities::Random& random = liquid::utilities::Random::instance();
+
+    // One layer per blend mode, drawn over an opaque grey background
+    snapshot.mLayers.resize(5);
+    snapshot.mLayerCount = 5;
+
+    for (uint32_t i = 0; i <= spriteCount; i++)
+    {
+        uint32_t layer = (i == 0) ? 0 : 1 + i % 4;
+        float x = (i == 0) ? 0.0f : random.randomRange(0.0f, 1900.0f);
+        float y = (i == 0) ? 0.0f : random.randomRange(0.0f, 1060.0f);
+        float size = (i == 0) ? 1920.0f : random.randomRange(8.0f, 64.0f);
+        uint8_t colour = (i == 0) ? 64 : (uint8_t)random.randomRange(0, 255);
+
+        liquid::graphics::RenderSnapshot::Sprite sprite;
+        sprite.mAtlasID = -1;
+        sprite.mShaderID = -1;
+        sprite.mBlendMode = (i == 0) ? 3 : i % 4;
+        sprite.mPrimitiveType = 0;
+        sprite.mFirstVertex = snapshot.mVertices.size();
+        sprite.mVertexCount = 4;
+        sprite.mDepth = 0;
+        snapshot.mLayers[layer].mSprites.push_back(sprite);
+
+        const float cornerX[4] = { 0.0f, 1.0f, 1.0f, 0.0f };
+        const float cornerY[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            liquid::graphics::RenderVertex vertex;
+            vertex.mPositionX = x + cornerX[c] * size;
+            vertex.mPositionY = y + cornerY[c] * ((i == 0) ? 1080.0f : size);
+            vertex.mColour[0] = colour;
+            vertex.mColour[1] = 255 - colour;
+            vertex.mColour[2] = (i == 0) ? 64 : 128;
+            vertex.mColour[3] = (i == 0) ? 255 : 160;
+            snapshot.mVertices.push_back(vertex);
+        }
+    }
+}
+
+std::string Tests::getTempPath(const std::string& fileName)
+{
+    return (std::experimental::filesystem::temp_directory_path() / fileName).string();
+}
+
+bool Tests::matchesTexel(uint32_t texel, std::array<uint8_t, 4> expected, uint8_t tolerance)
+{
+    // Texels are packed RGBA8 with red in the lowest byte
+    for (uint32_t c = 0; c < 4; c++)
+    {
+        int32_t channel = (texel >> (c * 8)) & 0xFF;
+        if (std::abs(channel - (int32_t)expected[c]) > tolerance)
+            return false;
+    }
+
+    return true;
+}
+
+void Tests::softwareRendering()
+{
+    const uint32_t spriteCount = 20000;
+    const uint32_t frames = 10;
+
+    liquid::impl::SoftwareRenderer renderer;
+    liquid::graphics::RenderSnapshot snapshot;
+    createSpriteSnapshot(snapshot, spriteCount);
+
+    float total = 0.0f;
+    for (uint32_t f = 0; f < frames; f++)
+    {
+        renderer.drawSnapshot(snapshot);
+        total += renderer.getFrameTime();
+    }
+
+    std::string path = getTempPath("software_frame.png");
+    std::cout << "Software rendered " << spriteCount << " sprites at " << renderer.getWidth() << "x" << renderer.getHeight() << std::endl;
+    std::cout << "Frame: " << total / frames << "ms, " << renderer.getBatchCount() << " draw calls" << std::endl;
+    std::cout << "Saved frame " << (renderer.savePNG(path) ? "(pass)" : "FAILED (FAIL)") << std::endl;
+    std::remove(path.c_str());
+
+    // Golden frame: an 8x8 quad of (200, 50, 0, 128) per blend mode over a (100, 100, 100, 255)
+    // background, then a 2x2 red, green, blue and white texture stretched over 8x8 pixels with
+    // nearest and linear sampling
+    const uint8_t texels[16] = { 255, 0, 0, 255,  0, 255, 0, 255,  0, 0, 255, 255,  255, 255, 255, 255 };
+    renderer.resize(64, 8);
+    renderer.setClearColour(100, 100, 100, 255);
+    renderer.setTexture(1, 2, 2, texels, false);
+    renderer.setTexture(2, 2, 2, texels, true);
+
+    liquid::graphics::RenderCommandBuffer golden;
+    for (int32_t q = 0; q < 6; q++)
+    {
+        liquid::graphics::RenderCommandBuffer::State state;
+        state.mAtlasID = (q < 4) ? -1 : q - 3;
+        state.mShaderID = -1;
+        state.mBlendMode = (q < 4) ? q : 3;
+        state.mPrimitiveType = 0;
+        golden.setState(state);
+
+        const float cornerX[4] = { 0.0f, 1.0f, 1.0f, 0.0f };
+        const float cornerY[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+        liquid::graphics::RenderVertex quad[4];
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            quad[c].mPositionX = q * 8.0f + cornerX[c] * 8.0f;
+            quad[c].mPositionY = cornerY[c] * 8.0f;
+            quad[c].mTexCoordX = cornerX[c] * 2.0f;
+            quad[c].mTexCoordY = cornerY[c] * 2.0f;
+
+            if (q < 4)
+            {
+                quad[c].mColour[0] = 200;
+                quad[c].mColour[1] = 50;
+                quad[c].mColour[2] = 0;
+                quad[c].mColour[3] = 128;
+            }
+        }
+
+        golden.draw(quad, 4);
+    }
+
+    renderer.execute(golden);
+    const uint32_t* pixels = renderer.getPixels();
+
+    // Alpha weights the colour by 128 / 255, add saturates, multiply scales the background, none replaces it
+    bool blending = matchesTexel(pixels[3 * 64 + 3], { 150, 75, 50, 255 }, 1) &&
+                    matchesTexel(pixels[3 * 64 + 11], { 200, 125, 100, 255 }, 1) &&
+                    matchesTexel(pixels[3 * 64 + 19], { 78, 20, 0, 128 }, 1) &&
+                    matchesTexel(pixels[3 * 64 + 27], { 200, 50, 0, 128 }, 1) &&
+                    matchesTexel(pixels[3 * 64 + 60], { 100, 100, 100, 255 }, 0);
+    std::cout << "Blend modes " << (blending ? "match (pass)" : "DIFFER (FAIL)") << std::endl;
+
+    // Nearest repeats each texel over 4x4 pixels
+    bool nearest = matchesTexel(pixels[1 * 64 + 33], { 255, 0, 0, 255 }, 0) &&
+                   matchesTexel(pixels[1 * 64 + 38], { 0, 255, 0, 255 }, 0) &&
+                   matchesTexel(pixels[6 * 64 + 33], { 0, 0, 255, 255 }, 0) &&
+                   matchesTexel(pixels[6 * 64 + 38], { 255, 255, 255, 255 }, 0);
+    std::cout << "Nearest sampling " << (nearest ? "matches (pass)" : "DIFFERS (FAIL)") << std::endl;
+
+    // Linear clamps at the corners and blends between texel centres, the centre of pixel 3
+    // is 3 / 8 of the way from the red texel to the green one
+    bool linear = matchesTexel(pixels[0 * 64 + 40], { 255, 0, 0, 255 }, 1) &&
+                  matchesTexel(pixels[7 * 64 + 47], { 255, 255, 255, 255 }, 1) &&
+                  matchesTexel(pixels[0 * 64 + 43], { 159, 96, 0, 255 }, 2) &&
+                  matchesTexel(pixels[7 * 64 + 43], { 96, 96, 255, 255 }, 2);
+    std::cout << "Linear sampling " << (linear ? "matches (pass)" : "DIFFERS (FAIL)") << std::endl;
+}
+
+void Tests::commandReplay()
+{
+    const uint32_t spriteCount = 20000;
+    const uint32_t frames = 10;
+
+    liquid::graphics::RenderSnapshot snapshot;
+    liquid::graphics::RenderCommandBuffer commands;
+    createSpriteSnapshot(snapshot, spriteCount);
+
+    // The front end on its own
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    for (uint32_t f = 0; f < frames; f++)
+        commands.record(snapshot);
+
+    float recordTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    std::string path = getTempPath("frame.lqrc");
+    bool saved = commands.save(path);
+
+    // Replay the dumped frame, the scene is no longer involved
+    liquid::graphics::RenderCommandBuffer loaded;
+    bool read = saved && loaded.load(path);
+    std::remove(path.c_str());
+
+    if (read == false)
+    {
+        std::cout << "Failed to " << (saved ? "load " : "save ") << path << " (FAIL)" << std::endl;
+        return;
+    }
+
+    liquid::impl::SoftwareRenderer renderer;
+    float total = 0.0f;
+    for (uint32_t f = 0; f < frames; f++)
+    {
+        renderer.execute(loaded);
+        total += renderer.getFrameTime();
+    }
+
+    // The loaded frame must hold the recorded commands and draw the same pixels
+    std::vector<uint32_t> replayed(renderer.getPixels(), renderer.getPixels() + renderer.getWidth() * renderer.getHeight());
+    renderer.execute(commands);
+
+    const std::vector<liquid::graphics::RenderCommandBuffer::Command>& recorded = commands.getCommands();
+    bool matches = loaded.getCommands().size() == recorded.size() && loaded.getStates().size() == commands.getStates().size() &&
+                   loaded.getViews().size() == commands.getViews().size() && loaded.getVertices().size() == commands.getVertices().size() &&
+                   loaded.getDrawCount() == commands.getDrawCount() &&
+                   std::memcmp(loaded.getCommands().data(), recorded.data(), recorded.size() * sizeof(recorded[0])) == 0 &&
+                   std::memcmp(loaded.getStates().data(), commands.getStates().data(), commands.getStates().size() * sizeof(commands.getStates()[0])) == 0 &&
+                   std::memcmp(loaded.getVertices().data(), commands.getVertices().data(), commands.getVertices().size() * sizeof(commands.getVertices()[0])) == 0 &&
+                   std::memcmp(replayed.data(), renderer.getPixels(), replayed.size() * sizeof(uint32_t)) == 0;
+
+    std::cout << "Recorded " << loaded.getCommands().size() << " commands, " << loaded.getDrawCount() << " draws, "
+              << loaded.getVertices().size() << " vertices" << std::endl;
+    std::cout << "Record: " << recordTime / frames << "ms, Replay: " << total / frames << "ms" << std::endl;
+    std::cout << "Round trip " << (matches ? "matches (pass)" : "DIFFERS (FAIL)") << std::endl;
+}
+
+void Tests::atlasPacking()
+{
+    const uint32_t imageCount = 500;
+
+    // Loose sprites of mixed sizes, each of them its own atlas before packing
+    liquid::utilities::Random& random = liquid::utilities::Random::instance();
+    liquid::data::AtlasPacker packer(2048, 1);
+    std::vector<uint8_t> pixels(256 * 256 * 4, 255);
+    for (uint32_t i = 0; i < imageCount; i++)
+    {
+        uint32_t width = (16 << random.randomRange(0, 4)) + random.randomRange(0, 16);
+        uint32_t height = (16 << random.randomRange(0, 4)) + random.randomRange(0, 16);
+        packer.addImage("sprite" + std::to_string(i), width, height, pixels.data(), i);
+    }
+
+    if (packer.pack() == false)
+    {
+        std::cout << "Failed to pack the atlas (FAIL)" << std::endl;
+        return;
+    }
+
+    std::cout << "Packed " << imageCount << " images into " << packer.getPageCount() << " pages in "
+              << packer.getPackingTime() << "ms" << std::endl;
+
+    for (uint32_t p = 0; p < packer.getPageCount(); p++)
+        std::cout << "Page " << p << ": " << packer.getOccupancy(p) * 100.0f << "% occupied" << std::endl;
+
+    // Every image must lie on its page without touching another one
+    std::vector<const liquid::data::AtlasPacker::Placement*> placements;
+    for (uint32_t i = 0; i < imageCount; i++)
+        placements.push_back(packer.getPlacement("sprite" + std::to_string(i)));
+
+    uint32_t overlaps = 0;
+    for (uint32_t i = 0; i < imageCount; i++)
+    {
+        const liquid::data::AtlasPacker::Placement* a = placements[i];
+        if (a == nullptr || a->mX + a->mWidth > 2048 || a->mY + a->mHeight > 2048)
+        {
+            overlaps++;
+            continue;
+        }
+
+        for (uint32_t j = i + 1; j < imageCount; j++)
+        {
+            const liquid::data::AtlasPacker::Placement* b = placements[j];
+            if (b != nullptr && a->mPage == b->mPage && a->mX < b->mX + b->mWidth && b->mX < a->mX + a->mWidth &&
+                a->mY < b->mY + b->mHeight && b->mY < a->mY + a->mHeight)
+                overlaps++;
+        }
+    }
+
+    std::cout << "Placement errors: " << overlaps << (overlaps == 0 ? " (pass)" : " (FAIL)") << std::endl;
+
+    std::string prefix = getTempPath("packed");
+    bool published = packer.publish(prefix);
+    std::cout << "Published pages " << (published ? "(pass)" : "FAILED (FAIL)") << std::endl;
+
+    // An Entity drawn from a packed image moves onto its page along with its children,
+    // Entities of other atlases are left alone
+    liquid::common::Entity* packed = new liquid::common::Entity();
+    liquid::common::Entity* child = new liquid::common::Entity();
+    liquid::common::Entity* unpacked = new liquid::common::Entity();
+    packed->mAtlasID = 5;
+    child->mAtlasID = 7;
+    unpacked->mAtlasID = -1;
+    packed->addVertex2(new liquid::utilities::Vertex2({ 0.0f, 0.0f }, { 255.0f, 255.0f, 255.0f, 255.0f }, { 1.0f, 2.0f }));
+    child->setParentEntity(packed);
+
+    std::vector<liquid::common::Entity*> entities = { packed, unpacked };
+    uint32_t remapped = packer.remapEntities(entities);
+
+    const liquid::data::AtlasPacker::Placement* placement = placements[5];
+    std::array<float, 2> texCoord = packed->getVertices().back()->getTexCoord();
+    bool remaps = remapped == 1 && packed->mAtlasID == packer.getPages()[placement->mPage].mAtlasID &&
+                  child->mAtlasID == packer.getPages()[placements[7]->mPage].mAtlasID && unpacked->mAtlasID == -1 &&
+                  texCoord[0] == 1.0f + placement->mX && texCoord[1] == 2.0f + placement->mY;
+    std::cout << "Remapped " << remapped << " entities " << (remaps ? "(pass)" : "(FAIL)") << std::endl;
+
+    delete packed;
+    delete child;
+    delete unpacked;
+
+    // The pages were registered globally and written next to the temp path
+    for (const liquid::data::AtlasPacker::Page& page : packer.getPages())
+    {
+        liquid::data::TextureAtlas* atlas = liquid::common::ResourceManager<liquid::data::TextureAtlas>::getResource(page.mAtlasID);
+        liquid::common::ResourceManager<liquid::data::TextureAtlas>::removeResource(page.mAtlasID);
+        delete atlas;
+    }
+
+    for (uint32_t p = 0; p < packer.getPageCount(); p++)
+    {
+        std::string name = prefix + "_" + std::to_string(p);
+        std::remove((name + ".png").c_str());
+        std::remove((name + ".atlas").c_str());
+    }
+}
+
+void Tests::shadowCasting()
+{
+    const uint32_t lightCount = 300;
+    const uint32_t wallCount = 3000;
+    const uint32_t rayCount = 720;
+    const float worldSize = 4000.0f;
+    const float radius = 300.0f;
+
+    liquid::graphics::ShadowCaster caster;
+    std::vector<std::array<float, 4>> walls;
+    std::vector<liquid::graphics::Light*> lights;
+    liquid::utilities::Random& random = liquid::utilities::Random::instance();
+
+    for (uint32_t i = 0; i < wallCount; i++)
+    {
+        float x = random.randomRange(0.0f, worldSize);
+        float y = random.randomRange(0.0f, worldSize);
+        float angle = random.randomRange(0.0f, 6.283f);
+        float length = random.randomRange(20.0f, 150.0f);
+
+        walls.push_back({ x, y, x + length * std::cos(angle), y + length * std::sin(angle) });
+        caster.addOccluder(walls.back());
+    }
+
+    for (uint32_t i = 0; i < lightCount; i++)
+    {
+        lights.push_back(new liquid::graphics::Light({ random.randomRange(0.0f, worldSize), random.randomRange(0.0f, worldSize) },
+                                                     { 255.f, 220.f, 180.f, 255.f }, .8f, radius));
+    }
+
+    // Casts a ray from a point and returns the distance to the nearest segment it hits
+    auto castRay = [](std::array<float, 2> origin, float dx, float dy, const std::vector<std::array<float, 4>>& segments) {
+        float nearest = std::numeric_limits<float>::max();
+        for (const std::array<float, 4>& segment : segments)
+        {
+            float ax = segment[0] - origin[0], ay = segment[1] - origin[1];
+            float ex = segment[2] - segment[0], ey = segment[3] - segment[1];
+            float denominator = dx * ey - dy * ex;
+            if (denominator == 0.0f)
+                continue;
+
+            float t = (ax * ey - ay * ex) / denominator;
+            float u = (ax * dy - ay * dx) / denominator;
+            if (t > 0.0f && u >= 0.0f && u <= 1.0f)
+                nearest = std::min(nearest, t);
+        }
+
+        return nearest;
+    };
+
+    // Reference: brute force rays against every wall and the rim, compared with the swept outline
+    uint32_t mismatches = 0;
+    std::vector<std::array<float, 2>> polygon;
+    for (liquid::graphics::Light* light : lights)
+    {
+        std::array<float, 2> position = light->getLightPosition();
+        liquid::graphics::ShadowCaster::computeVisibility(position, radius, 32, walls, polygon);
+
+        std::vector<std::array<float, 4>> reference = walls, outline;
+        for (uint32_t i = 0; i < 32; i++)
+        {
+            float angle1 = 6.28318530718f * (float)i / 32.0f, angle2 = 6.28318530718f * (float)(i + 1) / 32.0f;
+            reference.push_back({ position[0] + radius * std::cos(angle1), position[1] + radius * std::sin(angle1),
+                                  position[0] + radius * std::cos(angle2), position[1] + radius * std::sin(angle2) });
+        }
+
+        for (uint32_t i = 0; i < polygon.size(); i++)
+        {
+            const std::array<float, 2>& a = polygon[i];
+            const std::array<float, 2>& b = polygon[(i + 1) % polygon.size()];
+            outline.push_back({ a[0], a[1], b[0], b[1] });
+        }
+
+        for (uint32_t r = 0; r < rayCount; r++)
+        {
+            float angle = 6.28318530718f * ((float)r + 0.5f) / (float)rayCount;
+            float expected = castRay(position, std::cos(angle), std::sin(angle), reference);
+            float swept = castRay(position, std::cos(angle), std::sin(angle), outline);
+            if (std::fabs(expected - swept) > radius * 0.001f)
+                mismatches++;
+        }
+    }
+
+    std::cout << "Visibility polygons: " << mismatches << " of " << lightCount * rayCount
+              << " rays differ from the reference" << std::endl;
+
+    caster.update(lights);
+    std::cout << "First update: " << caster.getRecomputedCount() << " lights in " << caster.getUpdateTime() << "ms" << std::endl;
+
+    caster.update(lights);
+    std::cout << "Nothing moved: " << caster.getRecomputedCount() << " lights in " << caster.getUpdateTime() << "ms" << std::endl;
+
+    for (uint32_t i = 0; i < lightCount / 10; i++)
+    {
+        std::array<float, 2> position = lights[i]->getLightPosition();
+        lights[i]->setLightPosition({ position[0] + 5.0f, position[1] });
+    }
+
+    caster.update(lights);
+    std::cout << "Tenth moved: " << caster.getRecomputedCount() << " lights in " << caster.getUpdateTime() << "ms" << std::endl;
+
+    for (liquid::graphics::Light* light : lights)
+        delete light;
+}
+
+void Tests::softwareLighting()
+{
+    const uint32_t lightCounts[] = { 100, 1000, 10000 };
+    const uint32_t downscales[] = { 1, 2, 4 };
+    const uint32_t frames = 10;
+
+    liquid::impl::SoftwareRenderer renderer;
+    liquid::graphics::RenderSnapshot snapshot;
+    createSpriteSnapshot(snapshot, 1000);
+    renderer.drawSnapshot(snapshot);
+
+    liquid::utilities::Random& random = liquid::utilities::Random::instance();
+    std::vector<liquid::graphics::Light> lights;
+    for (uint32_t i = 0; i < lightCounts[2]; i++)
+    {
+        lights.push_back(liquid::graphics::Light({ random.randomRange(0.0f, (float)renderer.getWidth()),
+                                                   random.randomRange(0.0f, (float)renderer.getHeight()) },
+                                                 { random.randomRange(100.0f, 255.0f), random.randomRange(100.0f, 255.0f),
+                                                   random.randomRange(100.0f, 255.0f), 255.0f },
+                                                 .5f, random.randomRange(30.0f, 150.0f)));
+    }
+
+    // The framebuffer is lit repeatedly, only the timings matter
+    for (uint32_t downscale : downscales)
+    {
+        liquid::impl::SoftwareLightingManager lighting({ 40.0f, 40.0f, 60.0f, 255.0f }, downscale);
+        for (uint32_t lightCount : lightCounts)
+        {
+            float accumulate = 0.0f, composite = 0.0f;
+            for (uint32_t f = 0; f < frames; f++)
+            {
+                lighting.drawLights(&renderer, lighting.getAmbientColour(), lights.data(), lightCount);
+                accumulate += lighting.getAccumulateTime();
+                composite += lighting.getCompositeTime();
+            }
+
+            std::cout << lightCount << " lights, " << lighting.getLightmapWidth() << "x" << lighting.getLightmapHeight()
+                      << " lightmap: accumulate " << accumulate / frames << "ms, composite " << composite / frames << "ms" << std::endl;
+        }
+    }
+
+    // A full resolution lightmap of two lights centred on texels, the second behind a wall
+    const std::array<float, 4> ambient = { 40.0f, 40.0f, 60.0f, 255.0f };
+    renderer.resize(256, 256);
+    std::vector<liquid::graphics::Light> shadowed = {
+        liquid::graphics::Light({ 64.5f, 64.5f }, { 200.0f, 100.0f, 50.0f, 255.0f }, 1.0f, 40.0f),
+        liquid::graphics::Light({ 64.5f, 180.5f }, { 200.0f, 200.0f, 200.0f, 255.0f }, 1.0f, 60.0f)
+    };
+
+    liquid::graphics::ShadowCaster caster;
+    caster.addOccluder({ 84.0f, 150.0f, 84.0f, 210.0f });
+    std::vector<liquid::graphics::Light*> casting = { &shadowed[0], &shadowed[1] };
+    caster.update(casting);
+
+    liquid::impl::SoftwareLightingManager lighting(ambient, 1);
+    lighting.drawLights(&renderer, ambient, shadowed.data(), shadowed.size());
+
+    const float* lightmap = lighting.getLightmap();
+    auto matchesLightmap = [lightmap, &lighting](uint32_t x, uint32_t y, std::array<float, 4> expected, float tolerance) {
+        const float* texel = &lightmap[((size_t)y * lighting.getLightmapWidth() + x) * 4];
+        for (uint32_t c = 0; c < 3; c++)
+        {
+            if (std::fabs(texel[c] - expected[c]) > tolerance)
+                return false;
+        }
+
+        return true;
+    };
+
+    // The centre adds the full colour to the ambient light, past the radius and behind the
+    // wall only the ambient light is left, in front of the wall the light still reaches
+    bool centre = matchesLightmap(64, 64, { 240.0f, 140.0f, 110.0f, 255.0f }, 1.0f);
+    bool outside = matchesLightmap(64, 110, ambient, 0.0f) && matchesLightmap(200, 64, ambient, 0.0f);
+    bool shadow = matchesLightmap(100, 180, ambient, 0.0f) && matchesLightmap(75, 180, ambient, 0.0f) == false;
+    std::cout << "Light centre " << (centre ? "matches (pass)" : "DIFFERS (FAIL)") << std::endl;
+    std::cout << "Ambient outside the radius " << (outside ? "matches (pass)" : "DIFFERS (FAIL)") << std::endl;
+    std::cout << "Texel behind the wall " << (shadow ? "shadowed (pass)" : "LIT (FAIL)") << std::endl;
+}
+
+void Tests::particleSimulation()
+{
+    const uint32_t particleCount = 10000;
+    const uint32_t frames = 120;
+    const uint32_t seed = 1234;
+
+    liquid::parser::ParserConfig particleParser;
+    particleParser.parseString(liquid::data::ParticleData::mDefaultParticle);
+    liquid::data::ParticleData particleData(particleParser);
+
+    // Both simulations run on a fixed step and the same random sequence, so every particle must match
+    liquid::utilities::DeltaTime& deltaTime = liquid::utilities::DeltaTime::instance();
+    float previousStep = deltaTime.getFixedStep();
+    deltaTime.setFixedStep(16.0f);
+
+    // Random seeds itself from the clock when first used, so it has to exist before reseeding
+    liquid::utilities::Random::instance();
+    std::srand(seed);
+    std::vector<liquid::common::Particle*> particles;
+    for (uint32_t i = 0; i < particleCount; i++)
+        particles.push_back(new liquid::common::Particle(particleData));
+
+    float particleTime = 0.0f;
+    for (uint32_t f = 0; f < frames; f++)
+    {
+        for (uint32_t i = 0; i < particleCount; i++)
+        {
+            if (particles[i]->isAlive() == false)
+                particles[i]->emit(950.0f, 500.0f);
+        }
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        for (uint32_t i = 0; i < particleCount; i++)
+            particles[i]->update();
+
+        particleTime += std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    std::srand(seed);
+    liquid::common::ParticleBuffer buffer(particleData, particleCount);
+
+    float bufferTime = 0.0f;
+    for (uint32_t f = 0; f < frames; f++)
+    {
+        for (uint32_t i = 0; i < particleCount; i++)
+        {
+            if (buffer.isAlive(i) == false)
+                buffer.emit(i, 950.0f, 500.0f);
+        }
+
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        buffer.update(liquid::utilities::DELTA);
+
+        bufferTime += std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    deltaTime.setFixedStep(previousStep);
+
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < particleCount; i++)
+    {
+        if (particles[i]->getPositionX() != buffer.getPositionX()[i] || particles[i]->getPositionY() != buffer.getPositionY()[i] ||
+            particles[i]->getLifeTime() != buffer.getLifeTime()[i] || particles[i]->getColour() != buffer.getColour(i))
+            mismatches++;
+
+        delete particles[i];
+    }
+
+    std::cout << particleCount << " particles over " << frames << " frames: Particle " << particleTime / frames
+              << "ms, ParticleBuffer " << bufferTime / frames << "ms, " << mismatches << " mismatches" << std::endl;
+}
+
+void Tests::frameLimiting()
+{
+    liquid::utilities::DeltaTime& deltaTime = liquid::utilities::DeltaTime::instance();
+
+    // One slow wake-up from the OS must not leave the limiter spinning for good
+    for (uint32_t i = 0; i < 20; i++)
+        deltaTime.recordSleep(1.0f);
+
+    deltaTime.recordSleep(15.0f);
+    float spike = deltaTime.getOversleep();
+
+    uint32_t slices = 0;
+    while (deltaTime.getOversleep() > 1.5f && slices < 1000)
+    {
+        deltaTime.recordSleep(1.0f);
+        slices++;
+    }
+
+    std::cout << "Oversleep after a 15ms spike: " << spike << "ms, back under 1.5ms after " << slices << " slices "
+              << (slices < 1000 ? "(pass)" : "(FAIL)") << std::endl;
+
+    const int32_t frameLimit = 60;
+    const uint32_t frames = 30;
+
+    deltaTime.start();
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    for (uint32_t f = 0; f < frames; f++)
+    {
+        deltaTime.tick();
+        deltaTime.limitFrame(frameLimit);
+    }
+
+    float elapsed = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    std::cout << frames << " frames limited to " << frameLimit << "fps: " << elapsed / frames << "ms per frame, oversleep "
+              << deltaTime.getOversleep() << "ms" << std::endl;
+}
+
+void Tests::headlessTicks()
+{
+    // Moves at a constant speed by whatever DELTA reports
+    class DriftingEntity : public liquid::common::Entity
+    {
+    public:
+        virtual void update() override { addPosition(0.1f * liquid::utilities::DELTA, 0.0f); }
+    };
+
+    const uint32_t tickCount = 100;
+    const float injectedDelta = 10.0f;
+
+    liquid::utilities::DeltaTime& deltaTime = liquid::utilities::DeltaTime::instance();
+    liquid::impl::NullEventManager eventManager;
+    liquid::common::GameManager manager;
+    manager.setEventManagerClass(&eventManager);
+    manager.setTickRate(60);
+
+    liquid::common::GameScene* scene = new liquid::common::GameScene();
+    liquid::common::Layer* layer = new liquid::common::Layer(scene);
+    DriftingEntity* entity = new DriftingEntity();
+    layer->insertEntity(entity);
+    scene->insertLayer("default", layer);
+    manager.addGameSceneFront(scene);
+
+    deltaTime.setInjectedDelta(injectedDelta);
+    deltaTime.start();
+    uint32_t ticks = manager.simulateTicks(tickCount);
+
+    // A tick rate is set as well, the injected delta must still win so DELTA and TIME agree
+    float expected = 0.1f * injectedDelta * tickCount;
+    bool moved = std::fabs(entity->getPositionX() - expected) < 0.001f;
+    bool timed = std::fabs(deltaTime.getTimeSinceStart() - injectedDelta * tickCount) < 0.001f;
+
+    std::cout << ticks << " injected ticks of " << injectedDelta << "ms: entity at " << entity->getPositionX()
+              << " (expected " << expected << "), time " << deltaTime.getTimeSinceStart() << "ms "
+              << ((moved && timed) ? "(pass)" : "(FAIL)") << std::endl;
+
+    deltaTime.setInjectedDelta(0.0f);
+    deltaTime.setFixedStep(0.0f);
+    delete layer;
+    delete scene;
+}
+
+void Tests::worldStreaming()
+{
+    // Two Entities per chunk, one more for a Layer the scene lacks, and chunk (1,0) fails its first load
+    class TestProvider : public liquid::common::ChunkProvider
+    {
+    public:
+        virtual bool loadChunk(liquid::common::WorldChunk* chunk) override
+        {
+            if (chunk->mChunkX == 1 && chunk->mChunkY == 0 && mFailures.fetch_add(1) == 0)
+                return false;
+
+            for (uint32_t i = 0; i < 2; i++)
+            {
+                liquid::common::Entity* entity = new liquid::common::Entity();
+                entity->setPosition(chunk->mChunkX * 256.0f + i, chunk->mChunkY * 256.0f);
+                chunk->insertEntity("default", entity);
+            }
+
+            chunk->insertEntity("missing", new liquid::common::Entity());
+            return true;
+        }
+
+        virtual void saveChunk(liquid::common::WorldChunk* /*chunk*/) override { mSaves++; }
+
+        std::atomic<uint32_t> mFailures{ 0 };
+        std::atomic<uint32_t> mSaves{ 0 };
+    };
+
+    TestProvider provider;
+    liquid::common::WorldStreamer* streamer = new liquid::common::WorldStreamer(&provider, 256.0f, 2);
+    streamer->setFollowCamera(false);
+    streamer->setRadius(1, 2);
+    streamer->setActivationBudget(1000.0f);
+    streamer->addInterestPoint({ 128.0f, 128.0f });
+
+    liquid::common::GameScene* scene = new liquid::common::GameScene();
+    liquid::common::Layer* layer = new liquid::common::Layer(scene);
+    scene->insertLayer("default", layer);
+    scene->setWorldStreamer(streamer);
+
+    // Updates until a condition holds, the loads and saves finish on background threads
+    auto updateUntil = [scene](std::function<bool()> condition) {
+        for (uint32_t frame = 0; frame < 5000; frame++)
+        {
+            scene->update();
+            if (condition())
+                return true;
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        return false;
+    };
+
+    // The failed chunk is only retried after its back-off, then all 9 chunks around the point are active
+    bool loaded = updateUntil([&]() { return streamer->getActiveChunkCount() == 9; });
+    scene->update();
+    bool retried = provider.mFailures == 2 && streamer->getChunk(1, 0) != nullptr &&
+                   streamer->getChunk(1, 0)->mState == liquid::common::WorldChunk::CHUNKSTATE_ACTIVE;
+    bool inserted = layer->getEntities().size() == 18;
+
+    // Far enough that every chunk passes the unload radius, the new ones come in around it
+    streamer->setInterestPoint(0, { 256.0f * 10.5f, 128.0f });
+    bool unloaded = updateUntil([&]() {
+        return streamer->getChunk(0, 0) == nullptr && streamer->getActiveChunkCount() == 9 && provider.mSaves == 9;
+    });
+
+    scene->update();
+    bool moved = layer->getEntities().size() == 18;
+    for (liquid::common::Entity* entity : layer->getEntities())
+        moved = moved && entity->getPositionX() >= 256.0f * 9.0f;
+
+    std::cout << "Streamed " << streamer->getChunkCount() << " chunks, " << layer->getEntities().size() << " entities: load "
+              << (loaded ? "ok" : "TIMED OUT") << ", retry " << (retried ? "ok" : "MISSING") << ", activate "
+              << (inserted ? "ok" : "WRONG") << ", unload " << (unloaded && moved ? "ok" : "WRONG") << " "
+              << ((loaded && retried && inserted && unloaded && moved) ? "(pass)" : "(FAIL)") << std::endl;
+
+    scene->setWorldStreamer(nullptr);
+    delete streamer;
+    delete layer;
+    delete scene;
+}
+
+void Tests::systemDispatch()
+{
+    const int32_t batchedType = 1;
+    const int32_t callbackType = 2;
+    const uint32_t entityCount = 100;
+    const uint32_t frames = 3;
+
+    liquid::common::GameScene* scene = new liquid::common::GameScene();
+    liquid::common::Layer* layers[2] = { new liquid::common::Layer(scene), new liquid::common::Layer(scene) };
+    scene->insertLayer("background", layers[0]);
+    scene->insertLayer("foreground", layers[1]);
+
+    // Alternating types across both Layers, every Entity counts its callback updates in its X position
+    std::vector<liquid::common::Entity*> entities;
+    for (uint32_t i = 0; i < entityCount; i++)
+    {
+        liquid::common::Entity* entity = new liquid::common::Entity();
+        entity->setEntityType((i % 2 == 0) ? batchedType : callbackType);
+        entity->mFuncCallbackUpdate = [](liquid::common::Entity* entity) { entity->addPosition(1.0f, 0.0f); };
+        layers[i % 4 < 2 ? 0 : 1]->insertEntity(entity);
+        entities.push_back(entity);
+    }
+
+    // A sleeping Entity of the batched type must be left out of the batch
+    entities[0]->setEntityState(liquid::common::Entity::ENTITYSTATE_SLEEP);
+
+    // The batched system counts in the Y position instead, and checks every batch holds one type
+    uint32_t batches = 0;
+    bool mixed = false;
+    liquid::common::SystemRegistry& systems = liquid::common::SystemRegistry::instance();
+    systems.registerSystem(batchedType, [&batches, &mixed, batchedType](liquid::utilities::Span<liquid::common::Entity* const> batch) {
+        batches++;
+        for (liquid::common::Entity* entity : batch)
+        {
+            mixed = mixed || entity->getEntityType() != batchedType;
+            entity->addPosition(0.0f, 1.0f);
+        }
+    });
+
+    for (uint32_t f = 0; f < frames; f++)
+        scene->update();
+
+    systems.clearSystems();
+
+    uint32_t wrong = 0;
+    for (uint32_t i = 0; i < entityCount; i++)
+    {
+        bool batched = entities[i]->getEntityType() == batchedType;
+        float expectedX = batched ? 0.0f : (float)frames;
+        float expectedY = (batched && i != 0) ? (float)frames : 0.0f;
+        if (entities[i]->getPositionX() != expectedX || entities[i]->getPositionY() != expectedY)
+            wrong++;
+    }
+
+    // One batch per Layer per frame
+    bool dispatched = batches == frames * 2 && mixed == false;
+    std::cout << "System dispatch: " << batches << " batches, " << wrong << " of " << entityCount
+              << " entities updated wrongly " << ((dispatched && wrong == 0) ? "(pass)" : "(FAIL)") << std::endl;
+
+    delete layers[0];
+    delete layers[1];
+    delete scene;
+}
+
+void Tests::depthSorting()
+{
+    const uint32_t itemCount = 100000;
+    const char* methodNames[3] = { "none", "insertion", "radix" };
+
+    // Items are indices into the depths, which repeat so that stability shows, and go negative
+    liquid::utilities::Random& random = liquid::utilities::Random::instance();
+    std::vector<float> depths(itemCount);
+    for (uint32_t i = 0; i < itemCount; i++)
+        depths[i] = (float)random.randomRange(-500, 500);
+
+    std::function<uint32_t(uint32_t)> keyFunc = [&depths](uint32_t item)
+    {
+        return liquid::utilities::DepthSorter<uint32_t>::toKey(depths[item]);
+    };
+
+    std::function<bool(uint32_t, uint32_t)> compare = [&depths](uint32_t a, uint32_t b)
+    {
+        return depths[a] < depths[b];
+    };
+
+    std::vector<uint32_t> shuffled(itemCount);
+    for (uint32_t i = 0; i < itemCount; i++)
+        shuffled[i] = i;
+
+    std::vector<uint32_t> sorted = shuffled;
+    std::stable_sort(sorted.begin(), sorted.end(), compare);
+
+    // A few neighbours swapped, like Entities that moved past each other since the last frame
+    std::vector<uint32_t> nearlySorted = sorted;
+    for (uint32_t i = 0; i < itemCount / 100; i++)
+    {
+        uint32_t position = random.randomRange(0, (int32_t)itemCount - 1);
+        std::swap(nearlySorted[position], nearlySorted[position + 1]);
+    }
+
+    const std::vector<uint32_t>* inputs[3] = { &sorted, &nearlySorted, &shuffled };
+    const char* inputNames[3] = { "Sorted", "Nearly sorted", "Shuffled" };
+    const uint32_t expectedMethods[3] = { 0, 1, 2 };
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        // The reference keeps equal depths in the order of this input
+        std::vector<uint32_t> expected = *inputs[i];
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        std::stable_sort(expected.begin(), expected.end(), compare);
+        float referenceTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+        liquid::utilities::DepthSorter<uint32_t> sorter;
+        std::vector<uint32_t> items = *inputs[i];
+        start = std::chrono::high_resolution_clock::now();
+        sorter.sort(items, keyFunc);
+        float sortTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+        bool matches = items == expected && sorter.getLastMethod() == expectedMethods[i];
+        std::cout << inputNames[i] << " " << itemCount << " items: " << sortTime << "ms by " << methodNames[sorter.getLastMethod()]
+                  << ", std::stable_sort " << referenceTime << "ms " << (matches ? "(pass)" : "(FAIL)") << std::endl;
+    }
+}
+
+void Tests::layerBaking()
+{
+    liquid::common::GameScene* scene = new liquid::common::GameScene();
+    liquid::common::Layer* layer = new liquid::common::Layer(scene);
+    scene->insertLayer("static", layer);
+    layer->setStatic(true, 100.0f);
+    layer->setSortMode(liquid::common::Layer::SORTMODE_Z);
+
+    // Four Entities of alternating atlases in the first chunk, out of depth order, and two in
+    // the chunk to its right. The red channel of their vertices tells them apart once baked
+    const float depths[6] = { 3.0f, 1.0f, 2.0f, 0.0f, 5.0f, 4.0f };
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        liquid::common::Entity* entity = new liquid::common::Entity();
+        entity->setPosition((i < 4) ? 10.0f + i * 10.0f : 140.0f + i * 10.0f, 10.0f);
+        entity->setDepth(depths[i]);
+        entity->mAtlasID = (i < 4) ? 1 + i % 2 : 1;
+        for (liquid::utilities::Vertex2* vertex : entity->getVertices())
+            vertex->setColour((float)i, 0.0f, 0.0f, 255.0f);
+
+        layer->insertEntity(entity);
+    }
+
+    scene->update();
+
+    std::vector<liquid::common::Layer::GeometryBlock> blocks;
+    layer->getGeometry({ 0.0f, 0.0f, 0.0f, 0.0f }, blocks);
+
+    // Depth order within each chunk, a new block wherever the atlas changes
+    std::vector<uint32_t> order;
+    for (const liquid::common::Layer::GeometryBlock& block : blocks)
+    {
+        for (uint32_t v = 0; v < block.mVertexCount; v += 4)
+            order.push_back(block.mVertices[v].mColour[0]);
+    }
+
+    bool sorted = layer->isStatic() && blocks.size() == 3 && order == std::vector<uint32_t>({ 3, 1, 2, 0, 5, 4 }) &&
+                  blocks[0].mAtlasID == 2 && blocks[1].mAtlasID == 1 && blocks[2].mAtlasID == 1;
+    std::cout << "Baked " << blocks.size() << " blocks in depth order " << (sorted ? "(pass)" : "(FAIL)") << std::endl;
+
+    // Only the chunk on the right overlaps the region
+    blocks.clear();
+    layer->getGeometry({ 120.0f, 0.0f, 200.0f, 50.0f }, blocks);
+    bool culled = blocks.size() == 1 && blocks[0].mVertexCount == 8;
+    std::cout << "Culled to " << blocks.size() << " blocks " << (culled ? "(pass)" : "(FAIL)") << std::endl;
+
+    // Without a sort mode the first chunk is grouped into one block per atlas
+    layer->setSortMode(liquid::common::Layer::SORTMODE_NONE);
+    scene->update();
+    blocks.clear();
+    layer->getGeometry({ 0.0f, 0.0f, 0.0f, 0.0f }, blocks);
+    bool grouped = layer->isStatic() && blocks.size() == 3 && blocks[0].mVertexCount == 8 && blocks[1].mVertexCount == 8;
+    std::cout << "Rebaked " << blocks.size() << " blocks grouped by state " << (grouped ? "(pass)" : "(FAIL)") << std::endl;
+
+    delete layer;
+    delete scene;
+}
+
+void Tests::tileMapLayer()
+{
+    const uint16_t empty = liquid::common::TileMapLayer::EMPTY_TILE;
+
+    // 40x40 tiles of 16 units split into 2x2 chunks, a tile set of 4 columns of 8x8 pixel tiles
+    liquid::common::GameScene* scene = new liquid::common::GameScene();
+    liquid::common::TileMapLayer* map = new liquid::common::TileMapLayer(scene, 40, 40, 16.0f, 16.0f);
+    scene->insertLayer("tiles", map);
+    map->setTileSet(3, 4, 8.0f, 8.0f);
+    scene->update();
+
+    // One tile only rebuilds its own chunk, its quad covers the tile and tile 5 of the set
+    map->setTile(1, 2, 5);
+    scene->update();
+
+    std::vector<liquid::common::Layer::GeometryBlock> blocks;
+    map->getGeometry({ 0.0f, 0.0f, 0.0f, 0.0f }, blocks);
+
+    const liquid::graphics::RenderVertex* quad = blocks.empty() ? nullptr : blocks[0].mVertices;
+    bool single = map->getChunkCount() == 4 && map->getRebuiltChunkCount() == 1 && blocks.size() == 1 &&
+                  blocks[0].mVertexCount == 4 && blocks[0].mAtlasID == 3 &&
+                  quad[0].mPositionX == 16.0f && quad[0].mPositionY == 32.0f && quad[2].mPositionX == 32.0f && quad[2].mPositionY == 48.0f &&
+                  quad[0].mTexCoordX == 8.0f && quad[0].mTexCoordY == 8.0f && quad[2].mTexCoordX == 16.0f && quad[2].mTexCoordY == 16.0f;
+    std::cout << "Single tile " << (single ? "built (pass)" : "WRONG (FAIL)") << std::endl;
+
+    bool lookup = map->getTile(1, 2) == 5 && map->getTileAtPoint(20.0f, 40.0f) == 5 && map->getTile(2, 2) == empty &&
+                  map->getTileAtPoint(-1.0f, 0.0f) == empty && map->getTile(40, 0) == empty;
+    std::cout << "Tile lookup " << (lookup ? "matches (pass)" : "DIFFERS (FAIL)") << std::endl;
+
+    // Filling rebuilds every chunk once, the top left chunk alone covers the region
+    map->fill(0);
+    map->setTile(0, 0, 1);
+    scene->update();
+    uint32_t rebuilt = map->getRebuiltChunkCount();
+    scene->update();
+
+    blocks.clear();
+    map->getGeometry({ 0.0f, 0.0f, 100.0f, 100.0f }, blocks);
+    const uint32_t chunkSize = liquid::common::TileMapLayer::CHUNK_SIZE;
+    bool filled = rebuilt == 4 && map->getRebuiltChunkCount() == 0 && blocks.size() == 1 &&
+                  blocks[0].mVertexCount == chunkSize * chunkSize * 4;
+    std::cout << "Filled map rebuilt " << rebuilt << " chunks, " << blocks.size() << " visible " << (filled ? "(pass)" : "(FAIL)") << std::endl;
+
+    delete map;
+    delete scene;
+}
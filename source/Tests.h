@@ -4,6 +4,16 @@
 #include "LiquidEngine.h"
 #include <cstdint>
 #include <iostream>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <experimental/filesystem>
 
 class Tests
 {
@@ -20,9 +30,27 @@ public:
     void parserXML();
     void quadTree();
     void ai(sf::Texture& texture);
+    void sceneSnapshot();
+    void spriteExpansion();
+    void softwareRendering();
+    void commandReplay();
+    void atlasPacking();
+    void shadowCasting();
+    void softwareLighting();
+    void particleSimulation();
+    void frameLimiting();
+    void headlessTicks();
+    void worldStreaming();
+    void systemDispatch();
+    void depthSorting();
+    void layerBaking();
+    void tileMapLayer();
 
     void createOverlay(liquid::spatial::QuadNode* node, liquid::common::Entity* entity);
     void createEntities(liquid::spatial::QuadNode* node, liquid::common::Entity* entity);
+    void createSpriteSnapshot(liquid::graphics::RenderSnapshot& snapshot, uint32_t spriteCount);
+    std::string getTempPath(const std::string& fileName);
+    bool matchesTexel(uint32_t texel, std::array<uint8_t, 4> expected, uint8_t tolerance);
 
 public:
     liquid::common::Entity* mEntity;
@@ -15,7 +15,11 @@ namespace animation {
         mCurrentFrame = 0;
         mBeginFrame = 0;
         mEndFrame = 0;
+        mAccumulator = 0.f;
         mFrameDelay = 0.f;
+        mFlippedX = false;
+        mFlippedY = false;
+        mEntityPtr = nullptr;
     }
 
     Animator::Animator(AnimationParser animationParser)
@@ -34,7 +38,10 @@ namespace animation {
         mCurrentFrame = 0;
         mBeginFrame = 0;
         mEndFrame = (mAnimationTable[mCurrentAnimation].size() - 1);
+        mAccumulator = 0.f;
         mFrameDelay = 0.f;
+        mFlippedX = false;
+        mFlippedY = false;
         mEntityPtr = nullptr;
 
         updateFrame(getAnimation(0)[0]);
@@ -201,6 +208,24 @@ namespace animation {
         updateFrame(getAnimation(mCurrentAnimation)[mCurrentFrame]);
     }
 
+    void Animator::restoreState(common::Entity* entityPtr, std::string animation, eAnimationMode mode,
+                                eAnimationDirection direction, int32_t beginFrame, int32_t endFrame,
+                                int32_t currentFrame, float accumulator)
+    {
+        mEntityPtr = entityPtr;
+        mCurrentAnimation = animation;
+        mAnimationMode = mode;
+        mAnimationDirection = direction;
+        mBeginFrame = beginFrame;
+        mEndFrame = endFrame;
+        mCurrentFrame = currentFrame;
+        mAccumulator = accumulator;
+
+        AnimationTable::iterator it = mAnimationTable.find(mCurrentAnimation);
+        if (it != mAnimationTable.end() && mCurrentFrame >= 0 && mCurrentFrame < (int32_t)(*it).second.size())
+            updateFrame((*it).second[mCurrentFrame]);
+    }
+
     const bool Animator::isFlippedX() const
     {
         return mFlippedX;
@@ -272,6 +297,16 @@ namespace animation {
         return mCurrentFrame;
     }
 
+    const float Animator::getAccumulator() const
+    {
+        return mAccumulator;
+    }
+
+    common::Entity* Animator::getEntityPtr() const
+    {
+        return mEntityPtr;
+    }
+
     void Animator::updateFrame(AnimationFrame frame)
     {
         mFrameDelay = frame.getFrameDelay();
@@ -279,7 +314,7 @@ namespace animation {
         if (mEntityPtr == nullptr)
             return;
 
-        std::vector<utilities::Vertex2*> verts = mEntityPtr->getVertices();
+        utilities::Span<utilities::Vertex2* const> verts = mEntityPtr->getVertices();
         float positionX = mEntityPtr->getPositionX();
         float positionY = mEntityPtr->getPositionY();
         float width = frame.getTexCoord2()[0] - frame.getTexCoord1()[0];
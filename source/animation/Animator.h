@@ -110,6 +110,20 @@ public:
       */
     void setEntityPtr(common::Entity* entityPtr);
 
+    /** \brief Puts the Animator back into a previously saved playback state
+      * \param entityPtr Pointer to the Entity to animate, may be null
+      * \param animation Name of the Animation that was playing
+      * \param mode Mode the Animation was playing in
+      * \param direction Direction of a ping-pong Animation
+      * \param beginFrame Beginning frame of the Animation
+      * \param endFrame Ending frame of the Animation
+      * \param currentFrame Frame that was being shown
+      * \param accumulator Time accumulated towards the next frame in milliseconds
+      */
+    void restoreState(common::Entity* entityPtr, std::string animation, eAnimationMode mode,
+                      eAnimationDirection direction, int32_t beginFrame, int32_t endFrame,
+                      int32_t currentFrame, float accumulator);
+
     const bool isFlippedX() const;
     const bool isFlippedY() const;
 
@@ -152,6 +166,12 @@ public:
     /// \return Gets the current frame index of the Animation
     const int32_t getCurrentFrame() const;
 
+    /// \return Gets the time accumulated towards the next frame in milliseconds
+    const float getAccumulator() const;
+
+    /// \return Gets the animating common::Entity, nullptr if none
+    common::Entity* getEntityPtr() const;
+
 protected:
     /** \brief Uses the given frame to update the texture coordinates of the Vertices
       * \param frame Next frame to use for the Animation
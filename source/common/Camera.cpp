@@ -26,4 +26,14 @@ namespace common {
         return mRotation;
     }
 
+    const std::array<float, 2> Camera::getViewCentre() const
+    {
+        return mCentre;
+    }
+
+    const std::array<float, 2> Camera::getViewDimensions() const
+    {
+        return mDimensions;
+    }
+
 }}
@@ -92,6 +92,12 @@ public:
     /// \return Gets the Rotation of the Camera
     const float getRotation() const;
 
+    /// \return Gets the Centre the Camera is actually viewing, including any screenshake
+    virtual const std::array<float, 2> getViewCentre() const;
+
+    /// \return Gets the Dimensions the Camera is actually viewing, including any zoom
+    virtual const std::array<float, 2> getViewDimensions() const;
+
 protected:
     std::array<float, 2> mCentre;     ///< Centre of the Camera in 2D space
     std::array<float, 2> mDimensions; ///< Dimensions of the Camera in 2D space
@@ -0,0 +1,51 @@
+#include "WorldChunk.h"
+
+namespace liquid { namespace common {
+#ifndef _CHUNKPROVIDER_H
+#define _CHUNKPROVIDER_H
+
+/**
+ * \class ChunkProvider
+ *
+ * \ingroup Common
+ * \brief Interface the WorldStreamer uses to read and write the contents of a WorldChunk
+ *
+ * loadChunk() and saveChunk() run on the WorldStreamer's background threads, so they
+ * must not touch the GameScene, the Lua state or anything else owned by the main
+ * thread. Anything that does (attaching Lua scripts for example) belongs in
+ * activateChunk(), which is called on the main thread at a frame boundary.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class ChunkProvider
+{
+public:
+    /// ChunkProvider Constructor
+    ChunkProvider() {}
+
+    /// ChunkProvider Destructor
+    virtual ~ChunkProvider() {}
+
+    /** \brief Creates the Entities of a chunk, called on a background thread
+      * \param chunk Chunk to fill using WorldChunk::insertEntity()
+      * \return True if the chunk loaded, false if it failed
+      */
+    virtual bool loadChunk(WorldChunk* chunk) = 0;
+
+    /** \brief Serialises the Entities of a chunk before they are freed, called on a background thread
+      * \param chunk Chunk that is being unloaded, its Entities are no longer in the GameScene
+      */
+    virtual void saveChunk(WorldChunk* chunk) = 0;
+
+    /** \brief Called on the main thread once the Entities of a chunk are in the GameScene
+      * \param chunk Chunk that has just become active
+      */
+    virtual void activateChunk(WorldChunk* /*chunk*/) {}
+};
+
+#endif // _CHUNKPROVIDER_H
+}}
@@ -21,6 +21,7 @@ namespace common {
         mOriginY = 0.5f;
         mWidth = 0.0f;
         mHeight = 0.0f;
+        mDepth = 0.0f;
         mUniqueID = "Invalid";
         mParentEntity = nullptr;
         mParentGameScene = nullptr;
@@ -30,6 +31,7 @@ namespace common {
         mAtlasID = -1;
         mShaderID = -1;
         mBlendMode = 0;
+        mPrimitiveType = 0;
         mVertices.resize(4);
 
         for (uint32_t i = 0; i < 4; i++)
@@ -124,6 +126,11 @@ namespace common {
         setPosition(mPositionX, mPositionY);
     }
 
+    void Entity::setDepth(float depth)
+    {
+        mDepth = depth;
+    }
+
     void Entity::setTexCoords(float x, float y, float w, float h)
     {
         mVertices[0]->setTexCoord(x, y);
@@ -132,6 +139,24 @@ namespace common {
         mVertices[3]->setTexCoord(x, y + h);
     }
     
+    void Entity::setOrigin(float x, float y)
+    {
+        mOriginX = x;
+        mOriginY = y;
+
+        setPosition(mPositionX, mPositionY);
+    }
+
+    void Entity::restoreTransform(float x, float y, float originX, float originY, float w, float h)
+    {
+        mPositionX = x;
+        mPositionY = y;
+        mOriginX = originX;
+        mOriginY = originY;
+        mWidth = w;
+        mHeight = h;
+    }
+
     bool Entity::isPointInside(float x, float y) const
     {
         return (x >= mPositionX && x <= mPositionX + mWidth &&
@@ -150,6 +175,11 @@ namespace common {
             mState = eEntityState::ENTITYSTATE_ACTIVE;
     }
     
+    void Entity::setEntityState(eEntityState state)
+    {
+        mState = state;
+    }
+
     void Entity::kill()
     {
         mState = eEntityState::ENTITYSTATE_DEAD;
@@ -181,7 +211,7 @@ namespace common {
         mParentGameScene = scene;
     }
     
-    void Entity::setParentEntity(Entity* entity)
+    void Entity::setParentEntity(Entity* entity, bool relative)
     {
         if (entity == nullptr)
         {
@@ -191,7 +221,7 @@ namespace common {
         }
         
         mParentEntity = entity;
-        mParentEntity->addChild(this);
+        mParentEntity->addChild(this, relative);
     }
 
     void Entity::createAIAgent()
@@ -255,12 +285,32 @@ namespace common {
         return mOriginY;
     }
 
+    const float Entity::getDepth() const
+    {
+        return mDepth;
+    }
+
+    const float Entity::getWidth() const
+    {
+        return mWidth;
+    }
+
+    const float Entity::getHeight() const
+    {
+        return mHeight;
+    }
+
+    std::string Entity::getLuaScript() const
+    {
+        return mLuaScript;
+    }
+
     std::string Entity::getEntityUID() const
     {
         return mUniqueID;
     }
     
-    std::vector<Entity*> Entity::getChildren() const
+    utilities::Span<Entity* const> Entity::getChildren() const
     {
         return mChildren;
     }
@@ -280,10 +330,15 @@ namespace common {
         return mAIAgent;
     }
 
-    std::vector<utilities::Vertex2*> Entity::getVertices()
+    utilities::Span<utilities::Vertex2* const> Entity::getVertices()
     {
         return mVertices;
     }
+
+    bool Entity::getSpriteInstances(std::vector<graphics::SpriteInstance>& /*instances*/)
+    {
+        return false;
+    }
     
     const uint32_t Entity::getVerticesCount() const
     {
@@ -296,11 +351,15 @@ namespace common {
         mVerticesCount = 0;
     }
 
-    void Entity::addChild(Entity* entity)
+    void Entity::addChild(Entity* entity, bool relative)
     {
         mChildren.push_back(entity);
-        entity->setPosition(entity->getPositionX() + mPositionX, 
-                            entity->getPositionY() + mPositionY);
+
+        if (relative)
+        {
+            entity->setPosition(entity->getPositionX() + mPositionX, 
+                                entity->getPositionY() + mPositionY);
+        }
     }
     
     void Entity::removeChild(Entity* entity)
@@ -11,9 +11,12 @@ extern "C" {
 #include <functional>
 #include <algorithm>
 #include <array>
+#include "../utilities/Span.h"
 #include "../utilities/Vertex2.h"
 #include "../ai/Agent.h"
 
+namespace liquid { namespace graphics { class SpriteInstance; } }
+
 namespace liquid { namespace common {
 #ifndef _ENTITY_H
 #define _ENTITY_H
@@ -82,6 +85,9 @@ public:
       *
       * If you need to get the delta time to compute something without relying on
       * the steps of frames look at the DeltaTime class in Utilities.
+      *
+      * None of the update steps are called for an Entity whose type has a system in
+      * the SystemRegistry, that system updates it as part of a batch instead.
       */
     virtual void update();
 
@@ -118,6 +124,30 @@ public:
 
     virtual void setTexCoords(float x, float y, float w, float h);
 
+    /** \brief Sets the origin of the Entity relative to its size
+      * \param x Origin on the X-Axis (0-1)
+      * \param y Origin on the Y-Axis (0-1)
+      */
+    void setOrigin(float x, float y);
+
+    /** \brief Sets the explicit depth of the Entity
+      * \param depth Depth used by Layers sorted with Layer::SORTMODE_Z, lower is drawn first
+      */
+    void setDepth(float depth);
+
+    /** \brief Assigns the transform of the Entity as-is, used when restoring saved state
+      * \param x X-Coordinate of the Entity
+      * \param y Y-Coordinate of the Entity
+      * \param originX Origin on the X-Axis (0-1)
+      * \param originY Origin on the Y-Axis (0-1)
+      * \param w Width of the Entity
+      * \param h Height of the Entity
+      *
+      * Unlike setPosition() and setSize() this does not move the vertices or any
+      * children and fires no callbacks, the saved vertices are expected to follow.
+      */
+    void restoreTransform(float x, float y, float originX, float originY, float w, float h);
+
     /** \brief Computes if a point is inside of this Entity
       * \param x X-Coordinate to be tested
       * \param y Y-Coordinate to be tested
@@ -131,6 +161,11 @@ public:
     /// Sets m_State to eEntityState::ENTITYSTATE_SLEEP
     void sleep();
 
+    /** \brief Sets m_State directly, without firing the kill callbacks
+      * \param state State to assign
+      */
+    void setEntityState(eEntityState state);
+
     /// Sets m_State to eEntityState::ENTITYSTATE_ACTIVE
     void wake();
 
@@ -159,8 +194,11 @@ public:
       * is a nullptr then the function will instead remove this Entity as a child from
       * the current Parent Entity and set its Parent Entity to null, essentially resetting
       * itself.
+      *
+      * When relative is true the position of this Entity is offset by the position of the
+      * parent, pass false to attach it where it already is.
       */
-    void setParentEntity(Entity* entity);
+    void setParentEntity(Entity* entity, bool relative = true);
 
     /// \brief Creates an AI Agent (ai::Agent) for this Entity
     void createAIAgent();
@@ -210,15 +248,27 @@ public:
     const float getOriginX() const;
     const float getOriginY() const;
 
+    /// \return Explicit depth of the Entity, default: 0.0f
+    const float getDepth() const;
+
+    /// \return Width of the Entity in 2D space
+    const float getWidth() const;
+
+    /// \return Height of the Entity in 2D space
+    const float getHeight() const;
+
+    /// \return Path of the Lua script attached to this Entity, empty if none
+    std::string getLuaScript() const;
+
     /** \brief Gets the unique string identifier of this Entity
       * \return Unique ID of the Entity, empty string if nothing
       */
     std::string getEntityUID() const;
 
     /** \brief Gets the children of this Entity
-      * \return Children of the Entity as a std::vector
+      * \return View of the children, valid until a child is added or removed
       */
-    std::vector<Entity*> getChildren() const;
+    utilities::Span<Entity* const> getChildren() const;
 
     /** \brief Gets the Parent of this Entity
       * \return Parent of this Entity, nullptr if there isn't one
@@ -236,9 +286,18 @@ public:
     ai::Agent* getAIAgent() const;
 
     /** \brief Gets the stored Vertex2* objects
-      * \return Array of the Vertex objects
+      * \return View of the Vertex objects, valid until the vertices of the Entity change
+      */
+    virtual utilities::Span<utilities::Vertex2* const> getVertices();
+
+    /** \brief Publishes the quads of this Entity as compact sprite instances
+      * \param instances Collection to append one graphics::SpriteInstance per quad to
+      * \return True if this Entity draws through instances, False to use getVertices()
+      *
+      * Entities made only of plain quads can override this so the renderer expands
+      * them with graphics::SpriteExpander instead of copying four vertices each.
       */
-    virtual std::vector<utilities::Vertex2*> getVertices();
+    virtual bool getSpriteInstances(std::vector<graphics::SpriteInstance>& instances);
 
     /// \return Number of Vertices in this Entity
     const uint32_t getVerticesCount() const;
@@ -256,7 +315,7 @@ protected:
       * Entity you must search the mChildren vector and go from bottom up pruning
       * the tree as you intend, using setParentEntity(nullptr).
       */
-    void addChild(Entity* child);
+    void addChild(Entity* child, bool relative = true);
 
     /** \brief Removes a child from this Entity
       * \param child The child Entity to remove
@@ -299,6 +358,7 @@ protected:
     float                mOriginY;         ///< Origin on Y-Axis relative to position (0-1)
     float                mWidth;           ///< Width of the Entity in 2D space
     float                mHeight;          ///< Height of the Entity in 2D space
+    float                mDepth;           ///< Explicit depth within a Layer sorted by Z
     std::string          mUniqueID;        ///< Unique identifier of the Entity
     std::vector<Entity*> mChildren;        ///< Collection of Entity ptrs that represent the children
     std::list<int32_t>   mFrameEvents;     ///< Collection of integers that denotes what has happened
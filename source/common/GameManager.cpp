@@ -1,6 +1,7 @@
 #include "GameManager.h"
 #include "LuaFuncs.h"
 #include "../utilities/DeltaTime.h"
+#include <cmath>
 
 namespace liquid {
 namespace common {
@@ -11,10 +12,17 @@ namespace common {
         mSettings = nullptr;
         mEventManager = nullptr;
         mRenderer = nullptr;
+        mSnapshotBuffer = nullptr;
+        mPipelined = false;
+        mSnapshotCount = 2;
         mPopNextSceneFront = false;
         mPopNextSceneBack = false;
         mGameSuspended = false;
         mGameRunning = true;
+        mTickRate = 0;
+        mMaxTicksPerFrame = 5;
+        mFrameLimit = 0;
+        mTickAccumulator = 0.0f;
     }
 
     GameManager::~GameManager()
@@ -33,32 +41,154 @@ namespace common {
 
     void GameManager::simulate()
     {
+        utilities::DeltaTime& deltaTime = utilities::DeltaTime::instance();
+
+        if (mPipelined && mRenderer != nullptr)
+        {
+            mSnapshotBuffer = new graphics::RenderSnapshotBuffer(mSnapshotCount);
+            mRenderer->setRenderThreadActive(false);
+            mRenderThread = std::thread(&GameManager::renderLoop, this);
+        }
+
         while (mGameRunning == true)
         {
-            utilities::DeltaTime::instance().tick();
+            deltaTime.tick();
 
             if (mGameSuspended == false)
             {
+                if (mEventManager != nullptr)
+                    mEventManager->updateEvents();
+
+                updateScene();
+                presentScene();
+                popPendingScenes();
+            }
+
+            // TODO: Flush stale event data (?)
+            deltaTime.limitFrame(mFrameLimit);
+        }
+
+        if (mSnapshotBuffer != nullptr)
+        {
+            mSnapshotBuffer->shutdown();
+            mRenderThread.join();
+            mRenderer->setRenderThreadActive(true);
+
+            delete mSnapshotBuffer;
+            mSnapshotBuffer = nullptr;
+        }
+    }
+
+    uint32_t GameManager::simulateTicks(uint32_t tickCount)
+    {
+        utilities::DeltaTime& deltaTime = utilities::DeltaTime::instance();
+        uint32_t ticks = 0;
+
+        // An injected delta is what the simulated clock advances by, so it is also the step
+        float step = deltaTime.getInjectedDelta();
+        if (step <= 0.0f)
+            step = (mTickRate > 0) ? 1000.0f / (float)mTickRate : 0.0f;
+
+        while (ticks < tickCount && mGameRunning && mGameSuspended == false && mGameScenes.empty() == false)
+        {
+            deltaTime.tick();
+
+            if (mEventManager != nullptr)
                 mEventManager->updateEvents();
+
+            deltaTime.setFixedStep(step);
+            deltaTime.setInterpolation(1.0f);
+            mGameScenes.front()->update();
+
+            presentScene();
+            popPendingScenes();
+            ticks++;
+        }
+
+        return ticks;
+    }
+
+    void GameManager::updateScene()
+    {
+        utilities::DeltaTime& deltaTime = utilities::DeltaTime::instance();
+
+        if (mTickRate > 0)
+        {
+            float step = 1000.0f / (float)mTickRate;
+            int32_t ticks = 0;
+
+            deltaTime.setFixedStep(step);
+            mTickAccumulator += deltaTime.getFrameDelta();
+
+            while (mTickAccumulator >= step && ticks < mMaxTicksPerFrame)
+            {
                 mGameScenes.front()->update();
-                mRenderer->draw(mGameScenes.front());
-
-                if (mPopNextSceneFront && mGameScenes.size() > 1)
-                {
-                    mGameScenes.pop_front();
-                    mPopNextSceneFront = false;
-                }
-                else if (mPopNextSceneBack && mGameScenes.size() > 1)
-                {
-                    mGameScenes.pop_back();
-                    mPopNextSceneBack = false;
-                }
+                mTickAccumulator -= step;
+                ticks++;
             }
 
-            // TODO: Flush stale event data (?)
+            // Drop whatever could not be caught up on rather than carrying it forward
+            if (mTickAccumulator >= step)
+                mTickAccumulator = std::fmod(mTickAccumulator, step);
+
+            deltaTime.setInterpolation(mTickAccumulator / step);
+        }
+        else
+        {
+            deltaTime.setFixedStep(0.0f);
+            deltaTime.setInterpolation(1.0f);
+            mGameScenes.front()->update();
         }
     }
 
+    void GameManager::presentScene()
+    {
+        if (mRenderer == nullptr)
+            return;
+
+        if (mSnapshotBuffer == nullptr)
+        {
+            mRenderer->draw(mGameScenes.front());
+            return;
+        }
+
+        // Blocks only when every snapshot is still queued or being drawn
+        graphics::RenderSnapshot* snapshot = mSnapshotBuffer->acquireWrite();
+        if (snapshot != nullptr)
+        {
+            mRenderer->captureSnapshot(mGameScenes.front(), *snapshot);
+            mSnapshotBuffer->publish(snapshot);
+        }
+    }
+
+    void GameManager::popPendingScenes()
+    {
+        if (mPopNextSceneFront && mGameScenes.size() > 1)
+        {
+            mGameScenes.pop_front();
+            mPopNextSceneFront = false;
+        }
+        else if (mPopNextSceneBack && mGameScenes.size() > 1)
+        {
+            mGameScenes.pop_back();
+            mPopNextSceneBack = false;
+        }
+    }
+
+    void GameManager::renderLoop()
+    {
+        mRenderer->setRenderThreadActive(true);
+
+        graphics::RenderSnapshot* snapshot = nullptr;
+        while ((snapshot = mSnapshotBuffer->acquireRead()) != nullptr)
+        {
+            mRenderer->drawSnapshot(*snapshot);
+            mSnapshotBuffer->release(snapshot);
+        }
+
+        mRenderer->setRenderThreadActive(false);
+    }
+
     void GameManager::terminate()
     {
         for (auto&& sc : mGameScenes)
@@ -152,6 +282,15 @@ namespace common {
     void GameManager::setSettingsClass(data::Settings* settings)
     {
         mSettings = settings;
+
+        if (mSettings != nullptr)
+        {
+            mTickRate = std::max(mSettings->getTickRate(), 0);
+            mFrameLimit = std::max(mSettings->getFrameLimit(), 0);
+
+            if (mSettings->getMaxTicksPerFrame() > 0)
+                mMaxTicksPerFrame = mSettings->getMaxTicksPerFrame();
+        }
     }
 
     void GameManager::setEventManagerClass(events::EventManager* eventManager)
@@ -174,6 +313,48 @@ namespace common {
         return mRenderer;
     }
 
+    void GameManager::setTickRate(int32_t tickRate)
+    {
+        mTickRate = std::max(tickRate, 0);
+        mTickAccumulator = 0.0f;
+    }
+
+    void GameManager::setMaxTicksPerFrame(int32_t maxTicks)
+    {
+        mMaxTicksPerFrame = std::max(maxTicks, 1);
+    }
+
+    void GameManager::setFrameLimit(int32_t frameLimit)
+    {
+        mFrameLimit = std::max(frameLimit, 0);
+    }
+
+    void GameManager::setPipelinedRendering(bool pipelined, uint32_t bufferCount)
+    {
+        mPipelined = pipelined;
+        mSnapshotCount = bufferCount;
+    }
+
+    bool GameManager::getPipelinedRendering() const
+    {
+        return mPipelined;
+    }
+
+    int32_t GameManager::getTickRate() const
+    {
+        return mTickRate;
+    }
+
+    int32_t GameManager::getMaxTicksPerFrame() const
+    {
+        return mMaxTicksPerFrame;
+    }
+
+    int32_t GameManager::getFrameLimit() const
+    {
+        return mFrameLimit;
+    }
+
     void GameManager::setGameSuspended(bool suspended)
     {
         mGameSuspended = suspended;
@@ -4,11 +4,13 @@
 #include <algorithm>
 #include <time.h>
 #include <cstdlib>
+#include <thread>
 #include "GameScene.h"
 #include "../data/Bindings.h"
 #include "../data/Settings.h"
 #include "../events/EventManager.h"
 #include "../graphics/Renderer.h"
+#include "../graphics/RenderSnapshotBuffer.h"
 
 namespace liquid { namespace common {
 #ifndef _GAMEMANAGER_H
@@ -54,11 +56,33 @@ public:
       * subsystems are updated and the Scenes are managed. This method also passes and
       * processes input events and makes sure that DeltaTime is updated.
       *
+      * When a tick rate is set the Scene is stepped in fixed ticks from an accumulator,
+      * running at most mMaxTicksPerFrame ticks per frame, and the left over fraction of a
+      * tick is handed to the Renderer as DeltaTime::getInterpolation(). A tick rate of 0
+      * falls back to one variable step per rendered frame.
+      *
+      * With pipelined rendering enabled the Scene is not drawn here; instead a
+      * graphics::RenderSnapshot is captured and handed to a render thread, so the
+      * next frame is simulated while the previous one is being drawn.
+      *
       * You only need to call this method once in your main() function, but make sure
       * that GameManager::execute() has been called first.
       */
     void simulate();
 
+    /** \brief Runs a fixed number of simulation ticks as fast as possible, then returns
+      * \param tickCount Number of ticks to run
+      * \return Number of ticks actually run, fewer if the game stopped or was suspended
+      *
+      * Intended for headless runs (see impl::NullRenderer and impl::NullEventManager)
+      * together with DeltaTime::setInjectedDelta(). Every call to this method updates
+      * the front GameScene exactly once per tick, stepping by the injected delta so
+      * DELTA and TIME agree, or by the tick rate when no delta is injected, and never
+      * waits on the frame limit.
+      * Either the EventManager or the Renderer may be left unset.
+      */
+    uint32_t simulateTicks(uint32_t tickCount);
+
     /// Called when the game has finished running, cleaning up resources
     void terminate();
 
@@ -151,6 +175,42 @@ public:
     /// \return Pointer to the Renderer class being used
     graphics::Renderer* getRendererClass() const;
 
+    /** \brief Sets the number of fixed simulation ticks per second
+      * \param tickRate Ticks per second, 0 steps once per frame with a variable delta
+      */
+    void setTickRate(int32_t tickRate);
+
+    /** \brief Sets the cap on simulation ticks run in one frame when falling behind
+      * \param maxTicks Maximum ticks per frame, any time beyond this is dropped
+      */
+    void setMaxTicksPerFrame(int32_t maxTicks);
+
+    /** \brief Sets the maximum frames rendered per second
+      * \param frameLimit Frames per second, 0 to run uncapped
+      */
+    void setFrameLimit(int32_t frameLimit);
+
+    /** \brief Draws on a separate thread from captured snapshots, applied when simulate() starts
+      * \param pipelined True to overlap simulation and rendering, false to draw in sequence
+      * \param bufferCount Number of snapshots in flight (1 - 3), more hides spikes but adds latency
+      *
+      * The latency of every frame, from capture to present, is recorded in the
+      * graphics::RenderStats of the Renderer.
+      */
+    void setPipelinedRendering(bool pipelined, uint32_t bufferCount = 2);
+
+    /// \return True if rendering is pipelined onto its own thread
+    bool getPipelinedRendering() const;
+
+    /// \return Fixed simulation ticks per second, 0 if stepping is variable
+    int32_t getTickRate() const;
+
+    /// \return Maximum simulation ticks run in one frame
+    int32_t getMaxTicksPerFrame() const;
+
+    /// \return Maximum frames rendered per second, 0 if uncapped
+    int32_t getFrameLimit() const;
+
     /** \brief Suspends the game based on passed value
       * \param suspend Boolean, true suspends the game, false resumes
       */
@@ -175,10 +235,33 @@ protected:
     graphics::Renderer*   mRenderer;     ///< Pointer to an instance of the Renderer class
 
 private:
-    bool mPopNextSceneFront; ///< Flag denotes if the front scene should be popped next frame
-    bool mPopNextSceneBack;  ///< Flag denotes if the bac scene should be popped next frame
-    bool mGameSuspended;     ///< Flag denotes if the game should be suspended in its current state
-    bool mGameRunning;       ///< Flag denotes if the game is being simulated, set to false to terminate
+    /// \brief Updates the front GameScene by one frame, either in fixed ticks or one variable step
+    void updateScene();
+
+    /// \brief Draws the front GameScene, or hands a snapshot of it to the render thread
+    void presentScene();
+
+    /// \brief Pops any GameScene flagged by popGameSceneFront() or popGameSceneBack()
+    void popPendingScenes();
+
+    /// \brief Body of the render thread, draws published snapshots until shut down
+    void renderLoop();
+
+private:
+    graphics::RenderSnapshotBuffer* mSnapshotBuffer; ///< Snapshots passed to the render thread, nullptr if not pipelined
+    std::thread                     mRenderThread;   ///< Thread drawing snapshots when pipelined
+
+private:
+    bool     mPipelined;         ///< Flag denotes if rendering runs on its own thread
+    uint32_t mSnapshotCount;     ///< Number of snapshots to cycle through when pipelined
+    bool     mPopNextSceneFront; ///< Flag denotes if the front scene should be popped next frame
+    bool     mPopNextSceneBack;  ///< Flag denotes if the bac scene should be popped next frame
+    bool     mGameSuspended;     ///< Flag denotes if the game should be suspended in its current state
+    bool     mGameRunning;       ///< Flag denotes if the game is being simulated, set to false to terminate
+    int32_t  mTickRate;          ///< Fixed simulation ticks per second, 0 for variable stepping
+    int32_t  mMaxTicksPerFrame;  ///< Cap on catch-up ticks per frame to avoid a spiral of death
+    int32_t  mFrameLimit;        ///< Maximum frames per second, 0 for uncapped
+    float    mTickAccumulator;   ///< Unsimulated time carried between frames (in milliseconds)
 };
 
 #endif // _GAMEMANAGER_H
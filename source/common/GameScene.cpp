@@ -1,5 +1,6 @@
 #include "GameScene.h"
 #include "Entity.h"
+#include "WorldStreamer.h"
 
 namespace liquid {
 namespace common {
@@ -7,6 +8,8 @@ namespace common {
     GameScene::GameScene()
     {
         mSceneName = "";
+        mCamera = nullptr;
+        mWorldStreamer = nullptr;
         mAllowUpdate = true;
         mAllowUpdateEvents = true;
         mAllowRenderer = true;
@@ -25,6 +28,9 @@ namespace common {
         if (mAllowUpdate == false)
             return;
 
+        if (mWorldStreamer != nullptr)
+            mWorldStreamer->update(this);
+
         for (Layer* layer : mLayers)
             layer->update();
 
@@ -65,6 +71,26 @@ namespace common {
         return nullptr;
     }
 
+    std::string GameScene::getLayerName(uint32_t index) const
+    {
+        for (auto& entry : mLayerIndexer)
+        {
+            if (entry.second == index)
+                return entry.first;
+        }
+
+        return "";
+    }
+
+    void GameScene::removeAllLayers()
+    {
+        for (Layer* layer : mLayers)
+            delete layer;
+
+        mLayers.clear();
+        mLayerIndexer.clear();
+    }
+
     Entity* GameScene::getEntityAtPoint(float x, float y)
     {
         Entity* entity = nullptr;
@@ -94,11 +120,21 @@ namespace common {
         mAnimators.push_back(animator);
     }
 
+    const std::list<animation::Animator*>& GameScene::getAnimators() const
+    {
+        return mAnimators;
+    }
+
     void GameScene::setCamera(Camera* camera)
     {
         mCamera = camera;
     }
 
+    void GameScene::setWorldStreamer(WorldStreamer* worldStreamer)
+    {
+        mWorldStreamer = worldStreamer;
+    }
+
     void GameScene::setAllowUpdate(bool isAllowed)
     {
         mAllowUpdate = isAllowed;
@@ -119,19 +155,13 @@ namespace common {
         mAllowPostProcesses = isAllowed;
     }
 
-    std::vector<Entity*> GameScene::getEntities()
+    utilities::ConcatView<Layer, Entity* const> GameScene::getEntities() const
     {
-        std::vector<Entity*> entities;
-        for (Layer* layer : mLayers)
-        {
-            std::vector<Entity*> layerEnts = layer->getEntities();
-            entities.insert(entities.begin(), layerEnts.begin(), layerEnts.end());
-        }
-
-        return entities;
+        return utilities::ConcatView<Layer, Entity* const>(mLayers,
+            [](const Layer* layer) { return layer->getEntities(); }, true);
     }
 
-    std::vector<Layer*> GameScene::getLayers()
+    utilities::Span<Layer* const> GameScene::getLayers() const
     {
         return mLayers;
     }
@@ -146,6 +176,11 @@ namespace common {
         return mCamera;
     }
 
+    WorldStreamer* GameScene::getWorldStreamer() const
+    {
+        return mWorldStreamer;
+    }
+
     bool GameScene::isAllowedUpdate() const
     {
         return mAllowUpdate;
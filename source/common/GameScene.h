@@ -21,6 +21,7 @@ namespace liquid { namespace common {
  *
  */
 
+class WorldStreamer;
 class GameScene
 {
 public:
@@ -62,6 +63,15 @@ public:
       */
     virtual Layer* getLayer(std::string name);
 
+    /** \brief Gets the name a Layer was inserted with
+      * \param index Index of the Layer in draw order
+      * \return Name of the Layer, empty string if out of range
+      */
+    std::string getLayerName(uint32_t index) const;
+
+    /// \brief Removes and deletes every Layer in the Scene
+    void removeAllLayers();
+
     /** \brief Find if an Entity is at the given point
       * \param x X-Coordinate to check against
       * \param y Y-Coordinate to check against
@@ -87,8 +97,16 @@ public:
 
     void addAnimator(animation::Animator* animator);
 
+    /// \return Every animation::Animator added to the Scene, in the order they were added
+    const std::list<animation::Animator*>& getAnimators() const;
+
     void setCamera(Camera* camera);
 
+    /** \brief Streams this GameScene in chunks, the WorldStreamer runs at the start of update()
+      * \param worldStreamer WorldStreamer to use, nullptr to stop streaming (not deleted)
+      */
+    void setWorldStreamer(WorldStreamer* worldStreamer);
+
     /** \brief Denotes if the GameScene is allowed to Update
       * \param isAllowed Value to assign the flag, default: true
       */
@@ -110,14 +128,17 @@ public:
     void setAllowPostProcesses(bool isAllowed = true);
 
     /** \brief Gets the current Collection of Entities in the Scene
-      * \return Collection of Entities as a std::vector
+      * \return View over the Entities of every Layer, use toVector() to keep a copy
+      *
+      * The topmost Layer comes first, so the Entities drawn last are found first, while
+      * the Entities of each Layer keep their order within it.
       */
-    std::vector<Entity*> getEntities();
+    utilities::ConcatView<Layer, Entity* const> getEntities() const;
 
     /** \brief Gets the layers associated with this GameScene
-      * \return Collection of Layer objects as a std::list
+      * \return View of the Layer objects, valid until a Layer is inserted or removed
       */
-    std::vector<Layer*> getLayers();
+    utilities::Span<Layer* const> getLayers() const;
 
     /** \brief Gets the name of the Scene
       * \return Name of the GameScene as a std::string, default: ""
@@ -126,6 +147,9 @@ public:
 
     Camera* getCamera() const;
 
+    /// \return The WorldStreamer of this GameScene, nullptr if not streamed
+    WorldStreamer* getWorldStreamer() const;
+
     /** \brief Denotes if the GameScene is allowed to Update
       * \return Boolean value of True or False
       */
@@ -152,6 +176,7 @@ protected:
     std::vector<Layer*>             mLayers;
     std::string                     mSceneName;      ///< String identifier for the Scene
     Camera*                         mCamera;         ///< Camera of the current Scene
+    WorldStreamer*                  mWorldStreamer;  ///< Streams chunks in and out, nullptr if not streamed
 
 private:
     bool mAllowUpdate;        ///< Flag that denotes if the scene should update
@@ -1,4 +1,6 @@
 #include "Layer.h"
+#include "../graphics/SpriteExpander.h"
+#include <cmath>
 
 namespace liquid {
 namespace common {
@@ -6,12 +8,20 @@ namespace common {
     Layer::Layer(GameScene* parentScene)
     {
         mParentScene = parentScene;
+        mSpatialHash = nullptr;
+        mSortMode = SORTMODE_NONE;
+        mSortKey = nullptr;
+        mStatic = false;
+        mBaked = false;
+        mChunkSize = 1024.0f;
     }
 
     Layer::~Layer()
     {
         for (Entity* entity : mEntities)
             delete entity;
+        for (Entity* entity : mEntitiesBuffer)
+            delete entity;
 
         mEntities.clear();
         mEntitiesBuffer.clear();
@@ -30,14 +40,47 @@ namespace common {
 
         mEntitiesBuffer.clear();
 
-        for (auto entity : mEntities)
+        SystemRegistry& systems = SystemRegistry::instance();
+        if (systems.isEmpty())
+        {
+            for (auto entity : mEntities)
+            {
+                if (entity->getEntityState() == Entity::eEntityState::ENTITYSTATE_ACTIVE)
+                {
+                    entity->updatePre();
+                    entity->update();
+                    entity->updatePost();
+                }
+            }
+        }
+        else
         {
-            if (entity->getEntityState() == Entity::eEntityState::ENTITYSTATE_ACTIVE)
+            // Group Entities handled by a system by type, the rest use their callbacks
+            if (mSystemBatches.size() < systems.getTypeRange())
+                mSystemBatches.resize(systems.getTypeRange());
+
+            for (auto& batch : mSystemBatches)
+                batch.clear();
+
+            for (auto entity : mEntities)
             {
-                entity->updatePre();
-                entity->update();
-                entity->updatePost();
+                if (entity->getEntityState() != Entity::eEntityState::ENTITYSTATE_ACTIVE)
+                    continue;
+
+                if (systems.hasSystem(entity->getEntityType()))
+                {
+                    mSystemBatches[entity->getEntityType()].push_back(entity);
+                }
+                else
+                {
+                    entity->updatePre();
+                    entity->update();
+                    entity->updatePost();
+                }
             }
+
+            for (uint32_t type = 0; type < mSystemBatches.size(); ++type)
+                systems.runSystem(type, mSystemBatches[type]);
         }
 
         std::vector<Entity*>::iterator it;
@@ -46,20 +89,82 @@ namespace common {
             if ((*it)->getEntityState() == Entity::eEntityState::ENTITYSTATE_DEAD)
             {
                 it = mEntities.erase(it);
+                mBaked = false;
                 if (it == mEntities.end())
                     break;
             }
         }
+
+        if (mSortMode != SORTMODE_NONE)
+        {
+            // A static Layer bakes its Entities in depth order, so a new order needs a rebake
+            if (mSorter.sort(mEntities, [this](const Entity* entity) {
+                    return utilities::DepthSorter<Entity*>::toKey(getSortDepth(entity));
+                }))
+                mBaked = false;
+        }
+
+        if (mStatic && mBaked == false)
+            bakeGeometry();
     }
 
     void Layer::insertEntity(Entity* entity)
     {
         mEntitiesBuffer.push_back(entity);
+        mBaked = false;
     }
 
     void Layer::insertEntity(std::vector<Entity*> entities)
     {
         mEntitiesBuffer.insert(mEntitiesBuffer.begin(), entities.begin(), entities.end());
+        mBaked = false;
+    }
+
+    bool Layer::removeEntity(Entity* entity)
+    {
+        std::vector<Entity*>::iterator it = std::find(mEntities.begin(), mEntities.end(), entity);
+        if (it == mEntities.end())
+        {
+            it = std::find(mEntitiesBuffer.begin(), mEntitiesBuffer.end(), entity);
+            if (it == mEntitiesBuffer.end())
+                return false;
+
+            mEntitiesBuffer.erase(it);
+        }
+        else
+        {
+            mEntities.erase(it);
+        }
+
+        entity->setParentGameScene(nullptr);
+        mBaked = false;
+        return true;
+    }
+
+    uint32_t Layer::removeEntities(const std::vector<Entity*>& entities)
+    {
+        if (entities.empty())
+            return 0;
+
+        std::unordered_set<const Entity*> removed(entities.begin(), entities.end());
+        uint32_t count = 0;
+
+        auto isRemoved = [&removed, &count](Entity* entity) {
+            if (removed.count(entity) == 0)
+                return false;
+
+            entity->setParentGameScene(nullptr);
+            count++;
+            return true;
+        };
+
+        mEntities.erase(std::remove_if(mEntities.begin(), mEntities.end(), isRemoved), mEntities.end());
+        mEntitiesBuffer.erase(std::remove_if(mEntitiesBuffer.begin(), mEntitiesBuffer.end(), isRemoved), mEntitiesBuffer.end());
+
+        if (count > 0)
+            mBaked = false;
+
+        return count;
     }
 
     void Layer::setSpatialHash(spatial::Spatial* spatialHash)
@@ -73,6 +178,203 @@ namespace common {
         mSpatialHash = spatialHash;
     }
 
+    void Layer::getGeometry(std::array<float, 4> region, std::vector<GeometryBlock>& blocks) const
+    {
+        if (mStatic == false || mBaked == false)
+            return;
+
+        bool cull = region[0] != 0 || region[1] != 0 || region[2] != 0 || region[3] != 0;
+        for (const BakedBlock& baked : mBakedBlocks)
+        {
+            if (cull && (baked.mBounds[2] < region[0] || baked.mBounds[0] > region[2] ||
+                         baked.mBounds[3] < region[1] || baked.mBounds[1] > region[3]))
+                continue;
+
+            GeometryBlock block;
+            block.mVertices = &mBakedVertices[baked.mFirstVertex];
+            block.mVertexCount = baked.mVertexCount;
+            block.mAtlasID = baked.mAtlasID;
+            block.mShaderID = baked.mShaderID;
+            block.mBlendMode = baked.mBlendMode;
+            block.mPrimitiveType = baked.mPrimitiveType;
+            blocks.push_back(block);
+        }
+    }
+
+    void Layer::setStatic(bool isStatic, float chunkSize)
+    {
+        mStatic = isStatic;
+        mChunkSize = (chunkSize > 0.0f) ? chunkSize : 1024.0f;
+        mBaked = false;
+
+        if (isStatic == false)
+        {
+            mBakedBlocks.clear();
+            mBakedBlocks.shrink_to_fit();
+            mBakedVertices.clear();
+            mBakedVertices.shrink_to_fit();
+        }
+    }
+
+    void Layer::invalidateGeometry()
+    {
+        mBaked = false;
+    }
+
+    bool Layer::isStatic() const
+    {
+        return mStatic;
+    }
+
+    void Layer::setSortMode(eSortMode sortMode)
+    {
+        mSortMode = sortMode;
+        mBaked = false;
+    }
+
+    void Layer::setSortKey(SortKeyFunc sortKey)
+    {
+        mSortKey = sortKey;
+        mSortMode = (sortKey != nullptr) ? SORTMODE_CUSTOM : SORTMODE_NONE;
+        mBaked = false;
+    }
+
+    Layer::eSortMode Layer::getSortMode() const
+    {
+        return mSortMode;
+    }
+
+    float Layer::getSortDepth(const Entity* entity) const
+    {
+        switch (mSortMode)
+        {
+        case SORTMODE_Y:
+            return entity->getPositionY();
+        case SORTMODE_Z:
+            return entity->getDepth();
+        case SORTMODE_CUSTOM:
+            return (mSortKey != nullptr) ? mSortKey(entity) : 0.0f;
+        default:
+            return 0.0f;
+        }
+    }
+
+    void Layer::bakeGeometry()
+    {
+        /// Vertices of one Entity waiting to be grouped into a block
+        struct Record
+        {
+            int32_t              mCellX;
+            int32_t              mCellY;
+            const Entity*        mEntity;
+            uint32_t             mFirstVertex;
+            uint32_t             mVertexCount;
+            std::array<float, 4> mBounds;
+        };
+
+        std::vector<graphics::RenderVertex> vertices;
+        std::vector<graphics::SpriteInstance> instances;
+        std::vector<Record> records;
+
+        for (Entity* entity : mEntities)
+        {
+            if (entity->getEntityState() != Entity::ENTITYSTATE_ACTIVE)
+                continue;
+
+            uint32_t first = vertices.size();
+            instances.clear();
+            if (entity->getSpriteInstances(instances))
+            {
+                vertices.resize(first + instances.size() * 4);
+                graphics::SpriteExpander::expand(instances.data(), instances.size(), &vertices[first]);
+            }
+            else
+            {
+                for (utilities::Vertex2* vertex : entity->getVertices())
+                    vertices.push_back(graphics::RenderVertex(*vertex));
+            }
+
+            if (vertices.size() == first)
+                continue;
+
+            Record record;
+            record.mEntity = entity;
+            record.mFirstVertex = first;
+            record.mVertexCount = vertices.size() - first;
+            record.mBounds = { vertices[first].mPositionX, vertices[first].mPositionY,
+                               vertices[first].mPositionX, vertices[first].mPositionY };
+
+            for (uint32_t v = first; v < vertices.size(); v++)
+            {
+                record.mBounds[0] = std::min(record.mBounds[0], vertices[v].mPositionX);
+                record.mBounds[1] = std::min(record.mBounds[1], vertices[v].mPositionY);
+                record.mBounds[2] = std::max(record.mBounds[2], vertices[v].mPositionX);
+                record.mBounds[3] = std::max(record.mBounds[3], vertices[v].mPositionY);
+            }
+
+            // Entities belong to the chunk holding their centre, a block's bounds grow to fit them
+            record.mCellX = (int32_t)std::floor((record.mBounds[0] + record.mBounds[2]) * 0.5f / mChunkSize);
+            record.mCellY = (int32_t)std::floor((record.mBounds[1] + record.mBounds[3]) * 0.5f / mChunkSize);
+            records.push_back(record);
+        }
+
+        // Stable so Entities sharing a block keep the order of mEntities. A sorted Layer keeps
+        // its depth order within each chunk, a block then ends wherever the render state changes
+        bool sorted = mSortMode != SORTMODE_NONE;
+        std::stable_sort(records.begin(), records.end(), [sorted](const Record& a, const Record& b) {
+            if (a.mCellY != b.mCellY)
+                return a.mCellY < b.mCellY;
+            if (a.mCellX != b.mCellX || sorted)
+                return a.mCellX < b.mCellX;
+            if (a.mEntity->mShaderID != b.mEntity->mShaderID)
+                return a.mEntity->mShaderID < b.mEntity->mShaderID;
+            if (a.mEntity->mAtlasID != b.mEntity->mAtlasID)
+                return a.mEntity->mAtlasID < b.mEntity->mAtlasID;
+            if (a.mEntity->mBlendMode != b.mEntity->mBlendMode)
+                return a.mEntity->mBlendMode < b.mEntity->mBlendMode;
+
+            return a.mEntity->mPrimitiveType < b.mEntity->mPrimitiveType;
+        });
+
+        mBakedBlocks.clear();
+        mBakedVertices.clear();
+        mBakedVertices.reserve(vertices.size());
+
+        const Record* previous = nullptr;
+        for (const Record& record : records)
+        {
+            const Entity* entity = record.mEntity;
+            if (previous == nullptr || previous->mCellX != record.mCellX || previous->mCellY != record.mCellY ||
+                previous->mEntity->mShaderID != entity->mShaderID || previous->mEntity->mAtlasID != entity->mAtlasID ||
+                previous->mEntity->mBlendMode != entity->mBlendMode ||
+                previous->mEntity->mPrimitiveType != entity->mPrimitiveType)
+            {
+                BakedBlock block;
+                block.mBounds = record.mBounds;
+                block.mAtlasID = entity->mAtlasID;
+                block.mShaderID = entity->mShaderID;
+                block.mBlendMode = entity->mBlendMode;
+                block.mPrimitiveType = entity->mPrimitiveType;
+                block.mFirstVertex = mBakedVertices.size();
+                block.mVertexCount = 0;
+                mBakedBlocks.push_back(block);
+            }
+
+            BakedBlock& block = mBakedBlocks.back();
+            block.mBounds[0] = std::min(block.mBounds[0], record.mBounds[0]);
+            block.mBounds[1] = std::min(block.mBounds[1], record.mBounds[1]);
+            block.mBounds[2] = std::max(block.mBounds[2], record.mBounds[2]);
+            block.mBounds[3] = std::max(block.mBounds[3], record.mBounds[3]);
+            block.mVertexCount += record.mVertexCount;
+
+            mBakedVertices.insert(mBakedVertices.end(), vertices.begin() + record.mFirstVertex,
+                                  vertices.begin() + record.mFirstVertex + record.mVertexCount);
+            previous = &record;
+        }
+
+        mBaked = true;
+    }
+
     void Layer::setParentScene(GameScene* gameScene)
     {
         mParentScene = gameScene;
@@ -88,11 +390,16 @@ namespace common {
         return mParentScene;
     }
 
-    std::vector<Entity*> Layer::getEntities() const
+    utilities::Span<Entity* const> Layer::getEntities() const
     {
         return mEntities;
     }
 
+    utilities::Span<Entity* const> Layer::getPendingEntities() const
+    {
+        return mEntitiesBuffer;
+    }
+
     std::vector<Entity*> Layer::getEntities(std::array<float, 4> region)
     {
         if (region[0] == 0 && region[1] == 0 && region[2] == 0 && region[3] == 0)
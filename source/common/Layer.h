@@ -1,5 +1,10 @@
 #include "Entity.h"
+#include "SystemRegistry.h"
+#include "../graphics/RenderVertex.h"
 #include "../spatial/Spatial.h"
+#include "../utilities/DepthSorter.h"
+#include <functional>
+#include <unordered_set>
 
 namespace liquid { namespace common {
 #ifndef _LAYER_H
@@ -8,9 +13,33 @@ namespace liquid { namespace common {
 class GameScene;
 class Layer
 {
+public:
+    /// Order the Entities of a Layer are drawn in
+    enum eSortMode
+    {
+        SORTMODE_NONE = 0,   ///< Insertion order
+        SORTMODE_Y = 1,      ///< Ascending Y-Coordinate, for top-down views
+        SORTMODE_Z = 2,      ///< Ascending Entity::getDepth()
+        SORTMODE_CUSTOM = 3, ///< Ascending value of the function given to setSortKey()
+    };
+
+    /// Returns the depth of an Entity for SORTMODE_CUSTOM
+    typedef std::function<float(const Entity*)> SortKeyFunc;
+
+    /// Prebuilt vertices of a Layer that are drawn with one render state
+    struct GeometryBlock
+    {
+        const graphics::RenderVertex* mVertices;      ///< First vertex of the block
+        uint32_t                      mVertexCount;   ///< Number of vertices
+        int32_t                       mAtlasID;       ///< Texture atlas, -1 for none
+        int32_t                       mShaderID;      ///< Shader, -1 for none
+        int32_t                       mBlendMode;     ///< Blend mode
+        int32_t                       mPrimitiveType; ///< Primitive type of the vertices
+    };
+
 public:
     Layer(GameScene* parentScene);
-    ~Layer();
+    virtual ~Layer();
 
     virtual void update();
 
@@ -40,6 +69,24 @@ public:
       */
     virtual void insertEntity(std::vector<Entity*> entities);
 
+    /** \brief Takes an Entity out of the Layer without deleting it
+      * \param entity Entity you wish to remove from the Layer
+      * \return True if the Entity was found, ownership passes back to the caller
+      *
+      * Removes the Entity from the Layer immediately, whether it is already active or
+      * still waiting in mEntitiesBuffer. Must not be called while the Layer is updating.
+      */
+    virtual bool removeEntity(Entity* entity);
+
+    /** \brief Takes several Entities out of the Layer in one pass without deleting them
+      * \param entities Entities you wish to remove from the Layer
+      * \return Number of Entities found, ownership of them passes back to the caller
+      *
+      * Unlike calling removeEntity() for each, the Layer is only walked once, and the
+      * remaining Entities keep their order. Must not be called while the Layer is updating.
+      */
+    virtual uint32_t removeEntities(const std::vector<Entity*>& entities);
+
     /** \brief Sets the Spatial Hash of the Layer
       * \param spatial The Spatial Partitioning method as a class
       *
@@ -48,13 +95,71 @@ public:
       * work you need to pass an implemented Spatial class that implements it.
       */
     void setSpatialHash(spatial::Spatial* spatialHash);
+
+    /** \brief Marks the Layer as static scenery whose Entities are baked once
+      * \param isStatic True to bake the Layer, False to draw its Entities every frame
+      * \param chunkSize Width and height in 2D space of the chunks the geometry is split into
+      *
+      * At the end of the next update() the vertices of every active Entity are copied into
+      * immutable blocks, one per chunk and render state, which getGeometry() culls per chunk
+      * from then on. The Entities themselves are no longer culled or copied when drawing.
+      * Inserting or removing Entities rebakes the Layer, changes to the vertices of an
+      * Entity only show after invalidateGeometry(). Baked blocks are drawn chunk by chunk.
+      * Within a chunk the Entities are grouped by render state, unless the Layer has a sort
+      * mode, then they keep their depth order and a chunk has a block per change of state.
+      */
+    void setStatic(bool isStatic, float chunkSize = 1024.0f);
+
+    /// \brief Rebakes a static Layer at the end of the next update()
+    void invalidateGeometry();
+
+    /// \return True if the Layer is baked, see setStatic()
+    bool isStatic() const;
+
+    /** \brief Sets the order the Entities of this Layer are drawn in
+      * \param sortMode Order to use, SORTMODE_NONE keeps insertion order
+      *
+      * Sorted Layers reorder their active Entities at the end of every update. The
+      * previous order is the starting point, so Entities that did not pass each other
+      * since the last frame cost next to nothing. Within equal depths the renderer is
+      * free to group Entities by render state, so they can share a batch.
+      */
+    void setSortMode(eSortMode sortMode);
+
+    /** \brief Sorts this Layer by a custom depth, switching it to SORTMODE_CUSTOM
+      * \param sortKey Function returning the depth of an Entity, lower is drawn first
+      */
+    void setSortKey(SortKeyFunc sortKey);
+
+    /// \return Order the Entities of this Layer are drawn in
+    eSortMode getSortMode() const;
+
+    /** \brief Appends the cached geometry of this Layer that overlaps a region
+      * \param region Region as (x1, y1, x2, y2) to cull against, all zero for everything
+      * \param blocks Collection to append the visible blocks to
+      *
+      * Layers that keep their own vertices, like TileMapLayer, return them here so the
+      * renderer can draw them without going through Entities. Geometry is drawn beneath
+      * the Entities of the Layer and stays valid until the Layer next updates.
+      */
+    virtual void getGeometry(std::array<float, 4> region, std::vector<GeometryBlock>& blocks) const;
+
+    /** \brief Gets the depth an Entity is sorted by in this Layer
+      * \param entity Entity to measure
+      * \return Depth of the Entity, 0 if the Layer is not sorted
+      */
+    float getSortDepth(const Entity* entity) const;
     
     void setParentScene(GameScene* gameScene);
 
     spatial::Spatial* getSpatialHash() const;
     GameScene* getParentScene() const;
 
-    std::vector<Entity*> getEntities() const;
+    /// \return View of the active Entities, valid until the Layer next updates
+    utilities::Span<Entity* const> getEntities() const;
+
+    /// \return View of the Entities inserted this frame that become active on the next update
+    utilities::Span<Entity* const> getPendingEntities() const;
     std::vector<Entity*> getEntities(std::array<float, 4> region);
 
     Entity* getEntityAtPoint(float x, float y);
@@ -67,6 +172,34 @@ protected:
     std::vector<Entity*> mEntitiesBuffer; ///< Collection buffer to slowly introduce new Entities
     spatial::Spatial*    mSpatialHash;    ///< 
     GameScene*           mParentScene;    ///< 
+
+    std::vector<std::vector<Entity*>> mSystemBatches; ///< Active Entities grouped by type for their SystemRegistry system, reused every frame
+
+    eSortMode                       mSortMode; ///< Order the Entities are drawn in
+    SortKeyFunc                     mSortKey;  ///< Depth of an Entity for SORTMODE_CUSTOM
+    utilities::DepthSorter<Entity*> mSorter;   ///< Keeps mEntities sorted between frames
+
+protected:
+    /// Baked vertices of one chunk and render state
+    struct BakedBlock
+    {
+        std::array<float, 4> mBounds;        ///< Bounding box of the vertices as (x1, y1, x2, y2)
+        int32_t              mAtlasID;       ///< Texture atlas, -1 for none
+        int32_t              mShaderID;      ///< Shader, -1 for none
+        int32_t              mBlendMode;     ///< Blend mode
+        int32_t              mPrimitiveType; ///< Primitive type of the vertices
+        uint32_t             mFirstVertex;   ///< Index of the first vertex in mBakedVertices
+        uint32_t             mVertexCount;   ///< Number of vertices
+    };
+
+    /// \brief Copies the vertices of the active Entities into mBakedBlocks
+    void bakeGeometry();
+
+    bool                                mStatic;        ///< True if the Layer is baked
+    bool                                mBaked;         ///< True if mBakedBlocks is up to date
+    float                               mChunkSize;     ///< Size of a baked chunk in 2D space
+    std::vector<BakedBlock>             mBakedBlocks;   ///< Blocks ordered by chunk then state or depth
+    std::vector<graphics::RenderVertex> mBakedVertices; ///< Vertices of every baked block
 };
 
 #endif // _LAYER_H
@@ -51,6 +51,19 @@ namespace common {
                 .addFunction("shakeCamera", luaShakeCamera)
             .endNamespace()
 
+            .beginNamespace("renderer")
+                .addFunction("getDrawCalls", luaGetDrawCalls)
+                .addFunction("getBatches", luaGetBatches)
+                .addFunction("getVertices", luaGetVertices)
+                .addFunction("getTextureSwitches", luaGetTextureSwitches)
+                .addFunction("getFrameTime", luaGetFrameTime)
+                .addFunction("getPhaseTime", luaGetPhaseTime)
+                .addFunction("getVisibleEntities", luaGetVisibleEntities)
+                .addFunction("getCulledEntities", luaGetCulledEntities)
+                .addFunction("exportStats", luaExportStats)
+                .addFunction("saveStatsHistory", luaSaveStatsHistory)
+            .endNamespace()
+
             .beginNamespace("shapes")
                 .addFunction("createRectangle", luaCreateRectangle)
                 .addFunction("createCircle", luaCreateCircle)
@@ -321,6 +334,110 @@ namespace common {
         scene->getCamera()->shake(duration, radius, (common::Camera::eShakeAxis)axis);
     }
 
+    uint32_t LuaFuncs::luaGetDrawCalls()
+    {
+        graphics::RenderStats* stats = getRenderStats();
+
+        if (stats != nullptr)
+            return stats->getLastDrawCalls();
+
+        return 0;
+    }
+
+    uint32_t LuaFuncs::luaGetBatches()
+    {
+        graphics::RenderStats* stats = getRenderStats();
+
+        if (stats != nullptr)
+            return stats->getLastBatches();
+
+        return 0;
+    }
+
+    uint32_t LuaFuncs::luaGetVertices()
+    {
+        graphics::RenderStats* stats = getRenderStats();
+
+        if (stats != nullptr)
+            return stats->getLastVertices();
+
+        return 0;
+    }
+
+    uint32_t LuaFuncs::luaGetTextureSwitches()
+    {
+        graphics::RenderStats* stats = getRenderStats();
+
+        if (stats != nullptr)
+            return stats->getLastTextureSwitches();
+
+        return 0;
+    }
+
+    float LuaFuncs::luaGetFrameTime()
+    {
+        graphics::RenderStats* stats = getRenderStats();
+
+        if (stats != nullptr)
+            return stats->getLastFrameTime();
+
+        return 0.f;
+    }
+
+    float LuaFuncs::luaGetPhaseTime(int32_t phase)
+    {
+        graphics::RenderStats* stats = getRenderStats();
+
+        if (stats != nullptr && phase >= 0 && phase < graphics::RenderStats::PHASE_COUNT)
+            return stats->getLastPhaseTime((graphics::RenderStats::ePhase)phase);
+
+        return 0.f;
+    }
+
+    uint32_t LuaFuncs::luaGetVisibleEntities(int32_t layer)
+    {
+        graphics::RenderStats* stats = getRenderStats();
+        if (stats == nullptr)
+            return 0;
+
+        if (layer >= 0)
+            return stats->getLastLayer(layer).mVisible;
+
+        return 0;
+    }
+
+    uint32_t LuaFuncs::luaGetCulledEntities(int32_t layer)
+    {
+        graphics::RenderStats* stats = getRenderStats();
+        if (stats == nullptr)
+            return 0;
+
+        if (layer >= 0)
+            return stats->getLastLayer(layer).mCulled;
+
+        return 0;
+    }
+
+    bool LuaFuncs::luaExportStats(std::string file, std::string format)
+    {
+        graphics::RenderStats* stats = getRenderStats();
+
+        if (stats != nullptr)
+            return stats->setExportFile(file, (format == "json") ? graphics::RenderStats::EXPORT_JSON : graphics::RenderStats::EXPORT_CSV);
+
+        return false;
+    }
+
+    bool LuaFuncs::luaSaveStatsHistory(std::string file, std::string format)
+    {
+        graphics::RenderStats* stats = getRenderStats();
+
+        if (stats != nullptr)
+            return stats->exportHistory(file, (format == "json") ? graphics::RenderStats::EXPORT_JSON : graphics::RenderStats::EXPORT_CSV);
+
+        return false;
+    }
+
     shape::Rectangle LuaFuncs::luaCreateRectangle(float x, float y, float w, float h)
     {
         shape::Rectangle rectangle;
@@ -357,4 +474,10 @@ namespace common {
         return scene->getEntityWithUID(entity);
     }
 
+    graphics::RenderStats* LuaFuncs::getRenderStats()
+    {
+        graphics::Renderer* renderer = GameManager::instance().getRendererClass();
+        return (renderer != nullptr) ? &renderer->getStats() : nullptr;
+    }
+
 }}
@@ -5,6 +5,7 @@
 #include "../common/Camera.h"
 #include "../ai/BehaviourContext.h"
 #include "../ai/BehaviourTree.h"
+#include "../graphics/RenderStats.h"
 
 namespace liquid { namespace common {
 #ifndef _LUAFUNCS_H
@@ -46,6 +47,17 @@ public:
     static void luaSetCameraRotation(float rotation);
     static void luaShakeCamera(float duration, float radius, int32_t axis);
 
+    static uint32_t luaGetDrawCalls();
+    static uint32_t luaGetBatches();
+    static uint32_t luaGetVertices();
+    static uint32_t luaGetTextureSwitches();
+    static float luaGetFrameTime();
+    static float luaGetPhaseTime(int32_t phase);
+    static uint32_t luaGetVisibleEntities(int32_t layer);
+    static uint32_t luaGetCulledEntities(int32_t layer);
+    static bool luaExportStats(std::string file, std::string format);
+    static bool luaSaveStatsHistory(std::string file, std::string format);
+
     static shape::Rectangle luaCreateRectangle(float x, float y, float w, float h);
     static shape::Circle luaCreateCircle(float x, float y, float radius);
     static shape::LineSegment luaCreateLineSegment(float x1, float y1, float x2, float y2);
@@ -53,6 +65,7 @@ public:
     static float luaGetDeltaTime();
     static void luaPrintLn(std::string line);
     static Entity* getEntity(std::string entity);
+    static graphics::RenderStats* getRenderStats();
 };
 
 #endif // _LUAFUNCS_H
@@ -0,0 +1,215 @@
+#include "ParticleBuffer.h"
+#include "../utilities/Random.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define LIQUID_PARTICLE_SSE
+#endif
+
+namespace liquid {
+namespace common {
+
+    namespace
+    {
+#if defined(LIQUID_PARTICLE_SSE)
+
+        /// Picks value where mask is set and previous elsewhere
+        inline __m128 select(__m128 mask, __m128 value, __m128 previous)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, value), _mm_andnot_ps(mask, previous));
+        }
+
+#endif
+    }
+
+    ParticleBuffer::ParticleBuffer(const data::ParticleData& data, uint32_t count) :
+        mParticleData(data)
+    {
+        mCount = count;
+        mStarts = {
+            data.getVelocityX()[PARTICLE_VALUE],
+            data.getVelocityY()[PARTICLE_VALUE],
+            data.getColourR()[PARTICLE_VALUE],
+            data.getColourG()[PARTICLE_VALUE],
+            data.getColourB()[PARTICLE_VALUE],
+            data.getColourA()[PARTICLE_VALUE]
+        };
+
+        for (uint32_t c = 0; c < CHANNEL_COUNT; c++)
+        {
+            mTargets[c].resize(count);
+            mValues[c].assign(count, mStarts[c]);
+        }
+
+        mPositionX.assign(count, 0.0f);
+        mPositionY.assign(count, 0.0f);
+        mLifeTime.resize(count);
+        mLifeSpan.resize(count);
+
+        // Same draws in the same order as constructing count Particle objects
+        for (uint32_t i = 0; i < count; i++)
+        {
+            calculateTargets(i);
+            mLifeSpan[i] = data.getLifeSpan()[PARTICLE_VALUE] +
+                utilities::Random::instance().randomRange(
+                    data.getLifeSpan()[PARTICLE_VARIANCE_MIN],
+                    data.getLifeSpan()[PARTICLE_VARIANCE_MAX]
+                );
+
+            mLifeTime[i] = mLifeSpan[i];
+        }
+    }
+
+    ParticleBuffer::~ParticleBuffer()
+    {}
+
+    void ParticleBuffer::update(float delta)
+    {
+        uint32_t first = 0;
+
+#if defined(LIQUID_PARTICLE_SSE)
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 step = _mm_set1_ps(delta);
+
+        __m128 starts[CHANNEL_COUNT];
+        for (uint32_t c = 0; c < CHANNEL_COUNT; c++)
+            starts[c] = _mm_set1_ps(mStarts[c]);
+
+        for (; first + 4 <= mCount; first += 4)
+        {
+            __m128 lifeTime = _mm_loadu_ps(&mLifeTime[first]);
+            __m128 lifeSpan = _mm_loadu_ps(&mLifeSpan[first]);
+            __m128 alive = _mm_cmplt_ps(lifeTime, lifeSpan);
+
+            if (_mm_movemask_ps(alive) == 0)
+                continue;
+
+            // Tweener eases by the time elapsed before this step, quadratic out for velocity
+            // and linear for colour, so both keep exactly the float operations of Particle
+            __m128 linear = _mm_div_ps(lifeTime, lifeSpan);
+            __m128 inverse = _mm_sub_ps(one, linear);
+            __m128 quadratic = _mm_sub_ps(one, _mm_mul_ps(inverse, inverse));
+
+            __m128 values[CHANNEL_COUNT];
+            for (uint32_t c = 0; c < CHANNEL_COUNT; c++)
+            {
+                __m128 ease = (c <= CHANNEL_VELOCITY_Y) ? quadratic : linear;
+                __m128 target = _mm_loadu_ps(&mTargets[c][first]);
+                values[c] = _mm_add_ps(starts[c], _mm_mul_ps(ease, _mm_sub_ps(target, starts[c])));
+
+                _mm_storeu_ps(&mValues[c][first], select(alive, values[c], _mm_loadu_ps(&mValues[c][first])));
+            }
+
+            __m128 positionX = _mm_loadu_ps(&mPositionX[first]);
+            __m128 positionY = _mm_loadu_ps(&mPositionY[first]);
+            positionX = select(alive, _mm_add_ps(positionX, _mm_mul_ps(values[CHANNEL_VELOCITY_X], step)), positionX);
+            positionY = select(alive, _mm_add_ps(positionY, _mm_mul_ps(values[CHANNEL_VELOCITY_Y], step)), positionY);
+
+            _mm_storeu_ps(&mPositionX[first], positionX);
+            _mm_storeu_ps(&mPositionY[first], positionY);
+            _mm_storeu_ps(&mLifeTime[first], select(alive, _mm_add_ps(lifeTime, step), lifeTime));
+        }
+#endif
+
+        updateRange(first, mCount, delta);
+    }
+
+    void ParticleBuffer::updateRange(uint32_t first, uint32_t last, float delta)
+    {
+        for (uint32_t i = first; i < last; i++)
+        {
+            if (mLifeTime[i] >= mLifeSpan[i])
+                continue;
+
+            float linear = mLifeTime[i] / mLifeSpan[i];
+            float inverse = 1.0f - linear;
+            float quadratic = 1.0f - inverse * inverse;
+
+            for (uint32_t c = 0; c < CHANNEL_COUNT; c++)
+            {
+                float ease = (c <= CHANNEL_VELOCITY_Y) ? quadratic : linear;
+                mValues[c][i] = mStarts[c] + ease * (mTargets[c][i] - mStarts[c]);
+            }
+
+            mPositionX[i] += mValues[CHANNEL_VELOCITY_X][i] * delta;
+            mPositionY[i] += mValues[CHANNEL_VELOCITY_Y][i] * delta;
+            mLifeTime[i] += delta;
+        }
+    }
+
+    void ParticleBuffer::emit(uint32_t index, float x, float y)
+    {
+        mLifeTime[index] = 0.0f;
+        mPositionX[index] = x;
+        mPositionY[index] = y;
+
+        calculateTargets(index);
+    }
+
+    const bool ParticleBuffer::isAlive(uint32_t index) const
+    {
+        return (mLifeTime[index] < mLifeSpan[index]);
+    }
+
+    const std::array<float, 4> ParticleBuffer::getColour(uint32_t index) const
+    {
+        return {
+            mValues[CHANNEL_COLOUR_R][index],
+            mValues[CHANNEL_COLOUR_G][index],
+            mValues[CHANNEL_COLOUR_B][index],
+            mValues[CHANNEL_COLOUR_A][index]
+        };
+    }
+
+    const uint32_t ParticleBuffer::getCount() const
+    {
+        return mCount;
+    }
+
+    const float* ParticleBuffer::getValues(eChannel channel) const
+    {
+        return mValues[channel].data();
+    }
+
+    const float* ParticleBuffer::getPositionX() const
+    {
+        return mPositionX.data();
+    }
+
+    const float* ParticleBuffer::getPositionY() const
+    {
+        return mPositionY.data();
+    }
+
+    const float* ParticleBuffer::getLifeTime() const
+    {
+        return mLifeTime.data();
+    }
+
+    const float* ParticleBuffer::getLifeSpan() const
+    {
+        return mLifeSpan.data();
+    }
+
+    void ParticleBuffer::calculateTargets(uint32_t index)
+    {
+        const data::ParticleData::ParticleNode nodes[CHANNEL_COUNT] = {
+            mParticleData.getVelocityX(),
+            mParticleData.getVelocityY(),
+            mParticleData.getColourR(),
+            mParticleData.getColourG(),
+            mParticleData.getColourB(),
+            mParticleData.getColourA()
+        };
+
+        for (uint32_t c = 0; c < CHANNEL_COUNT; c++)
+        {
+            mTargets[c][index] = nodes[c][PARTICLE_TARGET_VALUE] +
+                utilities::Random::instance().randomRange(
+                    nodes[c][PARTICLE_VARIANCE_MIN],
+                    nodes[c][PARTICLE_VARIANCE_MAX]
+                );
+        }
+    }
+
+}}
@@ -1,6 +1,7 @@
 #include "ParticleEmitter.h"
 #include "../utilities/DeltaTime.h"
 #include "../data/TextureAtlas.h"
+#include "../graphics/SpriteInstance.h"
 #include "ResourceManager.h"
 
 namespace liquid {
@@ -8,55 +9,55 @@ namespace common {
 
     ParticleEmitter::ParticleEmitter(data::ParticleData& particleData, Layer* layerPtr, uint32_t count) :
         Entity(),
+        mParticles(particleData, count),
         mParticleData(particleData)
     {
-        mParticles.resize(count);
         mParticlesCount = count;
         mParticlesBirth = count;
         mBirthRate = 10.0f;
         mBirthAccumulator = 0.0f;
         mRepeat = true;
 
-        mParticles.resize(mParticlesCount);
         mAtlasID = ResourceManager<data::TextureAtlas>::getResourceID("particle");
         mBlendMode = 1;
 
-        for (uint32_t i = 0; i < mParticlesCount; i++)
-            mParticles[i] = new Particle(mParticleData);
+        mBorn.reserve(mParticlesCount);
+        mParticleVertices.resize(mParticlesCount * 4);
+        mParticleVertexPtrs.reserve(mParticlesCount * 4);
     }
 
     ParticleEmitter::~ParticleEmitter()
-    {
-        for (auto p : mParticles)
-            delete p;
-
-        mParticles.clear();
-    }
+    {}
 
     void ParticleEmitter::update()
     {
         if (mRepeat == true || (mRepeat == false && mParticlesBirth > 0))
             mBirthAccumulator += utilities::DELTA;
 
+        // Births are decided before advancing, so particles emitted this frame are not advanced
+        mBorn.clear();
         for (uint32_t i = 0; i < mParticlesCount; i++)
         {
-            if (mParticles[i]->isAlive())
-                mParticles[i]->update();
-            else
-            {
-                if (mRepeat == false && mParticlesBirth == 0)
-                    continue;
+            if (mParticles.isAlive(i))
+                continue;
 
-                if (mBirthAccumulator >= mBirthRate)
-                {
-                    mParticles[i]->emit(mPositionX, mPositionY);
-                    mBirthAccumulator -= mBirthRate;
+            if (mRepeat == false && mParticlesBirth == 0)
+                break;
 
-                    if (mRepeat == false)
-                        mParticlesBirth--;
-                }
+            if (mBirthAccumulator >= mBirthRate)
+            {
+                mBorn.push_back(i);
+                mBirthAccumulator -= mBirthRate;
+
+                if (mRepeat == false)
+                    mParticlesBirth--;
             }
         }
+
+        mParticles.update(utilities::DELTA);
+
+        for (uint32_t i : mBorn)
+            mParticles.emit(i, mPositionX, mPositionY);
     }
 
     void ParticleEmitter::updatePost()
@@ -110,26 +111,26 @@ namespace common {
         return mType;
     }
 
-    const std::vector<Particle*>& ParticleEmitter::getParticles()
+    const ParticleBuffer& ParticleEmitter::getParticles() const
     {
         return mParticles;
     }
 
-    std::vector<utilities::Vertex2*> ParticleEmitter::getVertices()
+    utilities::Span<utilities::Vertex2* const> ParticleEmitter::getVertices()
     {
-        std::vector<utilities::Vertex2*> vertices;
+        mParticleVertexPtrs.clear();
         mVerticesCount = 0;
 
         for (uint32_t i = 0; i < mParticlesCount; i++)
         {
-            if (mParticles[i]->isAlive())
+            if (mParticles.isAlive(i))
             {
+                utilities::Vertex2* vertex = &mParticleVertices[mVerticesCount * 4];
+                std::array<float, 4> colours = mParticles.getColour(i);
                 mVerticesCount++;
-                utilities::Vertex2* vertex = new utilities::Vertex2[4];
-                std::array<float, 4> colours = mParticles[i]->getColour();
 
-                float positionX = mParticles[i]->getPositionX();
-                float positionY = mParticles[i]->getPositionY();
+                float positionX = mParticles.getPositionX()[i];
+                float positionY = mParticles.getPositionY()[i];
 
                 vertex[0].setPosition(positionX, positionY);
                 vertex[1].setPosition(positionX + 64.0f, positionY);
@@ -144,12 +145,43 @@ namespace common {
                 for (uint32_t x = 0; x < 4; x++)
                 {
                     vertex[x].setColour(colours[0], colours[1], colours[2], colours[3]);
-                    vertices.push_back(&vertex[x]);
+                    mParticleVertexPtrs.push_back(&vertex[x]);
                 }
             }
         }
 
-        return vertices;
+        return mParticleVertexPtrs;
+    }
+
+    bool ParticleEmitter::getSpriteInstances(std::vector<graphics::SpriteInstance>& instances)
+    {
+        for (uint32_t i = 0; i < mParticlesCount; i++)
+        {
+            if (mParticles.isAlive(i) == false)
+                continue;
+
+            std::array<float, 4> colours = mParticles.getColour(i);
+            graphics::SpriteInstance instance;
+
+            instance.mPositionX = mParticles.getPositionX()[i];
+            instance.mPositionY = mParticles.getPositionY()[i];
+            instance.mOriginX = 0.0f;
+            instance.mOriginY = 0.0f;
+            instance.mWidth = 64.0f;
+            instance.mHeight = 64.0f;
+            instance.mRotation = 0.0f;
+            instance.mTexLeft = 0.0f;
+            instance.mTexTop = 0.0f;
+            instance.mTexWidth = 64.0f;
+            instance.mTexHeight = 64.0f;
+
+            for (uint32_t c = 0; c < 4; c++)
+                instance.mColour[c] = (uint8_t)std::max(std::min(colours[c], 255.0f), 0.0f);
+
+            instances.push_back(instance);
+        }
+
+        return true;
     }
 
 }}
@@ -1,5 +1,5 @@
 #include "Entity.h"
-#include "Particle.h"
+#include "ParticleBuffer.h"
 #include "Layer.h"
 #include "../data/ParticleData.h"
 
@@ -13,6 +13,9 @@ namespace liquid { namespace common {
  * \ingroup Common
  * \brief Subsystem that manages a Particle System for simulating
  *
+ * Particles are stored in a ParticleBuffer and advanced together each frame, with
+ * births decided and emitted in the same order as before so randomised targets match.
+ *
  * \author Jamie Massey
  * \version 2.0
  * \date 18/04/2017
@@ -44,9 +47,10 @@ public:
     /** \brief Called every frame
       *
       * Used to update active Particles and emit new ones when required, if the
-      * emitter is continuous it will keep respawning Particle objects using
-      * Particle::emit(float x, float y) and the mBirthRate variable to control
-      * how often they will spawn.
+      * emitter is continuous it will keep respawning particles using
+      * ParticleBuffer::emit and the mBirthRate variable to control
+      * how often they will spawn. Particles emitted this frame are not advanced
+      * until the next.
       */
     virtual void update() override;
 
@@ -100,23 +104,32 @@ public:
     /// Gets the type of this ParticleEmitter
     const eEmitterType getType() const;
 
-    /// Gets a referenced list to the collection of Particle objects stored
-    const std::vector<Particle*>& getParticles();
+    /// Gets the buffer holding the particles of this emitter
+    const ParticleBuffer& getParticles() const;
 
     /** \brief Gets the stored Vertex2* objects
-      * \return Array of the Vertex objects
+      * \return View of the quads of every live Particle, rebuilt on each call
+      */
+    virtual utilities::Span<utilities::Vertex2* const> getVertices() override;
+
+    /** \brief Publishes one 64x64 sprite instance per live Particle
+      * \param instances Collection to append the instances to
+      * \return Always True, particles are drawn through instances
       */
-    virtual std::vector<utilities::Vertex2*> getVertices();
+    virtual bool getSpriteInstances(std::vector<graphics::SpriteInstance>& instances) override;
 
 protected:
-    uint32_t               mParticlesBirth;   ///< Number of particles to birth
-    uint32_t               mParticlesCount;   ///< Number of particles stored in this emitter
-    float                  mBirthRate;        ///< Rate at which to birth new particles in milliseconds
-    float                  mBirthAccumulator; ///<  Accumulates for birthing new Particles
-    bool                   mRepeat;           ///< Denotes if the emitter should repeat
-    eEmitterType           mType;             ///< Stored type of this emitter
-    std::vector<Particle*> mParticles;        ///< Collection of Particle objects for use by this emitter
-    data::ParticleData&    mParticleData;     ///< Reference to the ParticleData (i.e. a template for birthing particles)
+    uint32_t                         mParticlesBirth;     ///< Number of particles to birth
+    uint32_t                         mParticlesCount;     ///< Number of particles stored in this emitter
+    float                            mBirthRate;          ///< Rate at which to birth new particles in milliseconds
+    float                            mBirthAccumulator;   ///<  Accumulates for birthing new Particles
+    bool                             mRepeat;             ///< Denotes if the emitter should repeat
+    eEmitterType                     mType;               ///< Stored type of this emitter
+    ParticleBuffer                   mParticles;          ///< Particles of this emitter
+    std::vector<uint32_t>            mBorn;               ///< Particles to emit this frame, reused every frame
+    std::vector<utilities::Vertex2>  mParticleVertices;   ///< Four vertices per Particle, reused every frame
+    std::vector<utilities::Vertex2*> mParticleVertexPtrs; ///< Pointers to the vertices of live particles
+    data::ParticleData&              mParticleData;       ///< Reference to the ParticleData (i.e. a template for birthing particles)
 };
 
 #endif // _PARTICLEEMITTER_H
@@ -46,7 +46,7 @@ public:
       */
     static void removeResource(ResourceID id)
     {
-        std::map<std::string, uint32_t>::iterator it;
+        typename std::map<std::string, ResourceID>::iterator it;
         for (it = getResourceIndexer().begin(); it != getResourceIndexer().end(); ++it)
         {
             if ((*it).second == id)
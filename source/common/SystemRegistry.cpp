@@ -0,0 +1,68 @@
+#include "SystemRegistry.h"
+
+namespace liquid {
+namespace common {
+
+    SystemRegistry::SystemRegistry()
+    {
+        mSystemCount = 0;
+    }
+
+    SystemRegistry::~SystemRegistry()
+    {
+        clearSystems();
+    }
+
+    bool SystemRegistry::registerSystem(int32_t entityType, System system)
+    {
+        if (entityType < 0 || system == nullptr)
+            return false;
+
+        if (static_cast<uint32_t>(entityType) >= mSystems.size())
+            mSystems.resize(entityType + 1);
+
+        if (!mSystems[entityType])
+            mSystemCount++;
+
+        mSystems[entityType] = system;
+        return true;
+    }
+
+    void SystemRegistry::removeSystem(int32_t entityType)
+    {
+        if (!hasSystem(entityType))
+            return;
+
+        mSystems[entityType] = nullptr;
+        mSystemCount--;
+    }
+
+    void SystemRegistry::clearSystems()
+    {
+        mSystems.clear();
+        mSystemCount = 0;
+    }
+
+    void SystemRegistry::runSystem(int32_t entityType, utilities::Span<Entity* const> entities) const
+    {
+        if (hasSystem(entityType) && !entities.empty())
+            mSystems[entityType](entities);
+    }
+
+    const bool SystemRegistry::isEmpty() const
+    {
+        return mSystemCount == 0;
+    }
+
+    const uint32_t SystemRegistry::getTypeRange() const
+    {
+        return static_cast<uint32_t>(mSystems.size());
+    }
+
+    SystemRegistry& SystemRegistry::instance()
+    {
+        static SystemRegistry singleton;
+        return singleton;
+    }
+
+}}
@@ -0,0 +1,91 @@
+#include "../utilities/Span.h"
+#include <vector>
+#include <functional>
+#include <stdint.h>
+
+namespace liquid { namespace common {
+#ifndef _SYSTEMREGISTRY_H
+#define _SYSTEMREGISTRY_H
+
+/**
+ * \class SystemRegistry
+ *
+ * \ingroup Common
+ * \brief Singleton registry of update systems keyed by Entity type
+ *
+ * A system is a single function that updates every active Entity of one type in a
+ * Layer, given as one contiguous batch each frame. Entities whose type has a system
+ * skip Entity::updatePre(), Entity::update() and Entity::updatePost() entirely, so
+ * the per-Entity std::function, Lua and ai::Agent calls are replaced by one call per
+ * type. Entities of any other type keep using those callbacks as before.
+ *
+ * Entity types are used as indices, so systems can only be registered for types
+ * from 0 upwards and are best kept to small enum values.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class Entity;
+class SystemRegistry
+{
+public:
+    /// Updates a batch of active Entities that all share one type
+    typedef std::function<void(utilities::Span<Entity* const>)> System;
+
+public:
+    /// SystemRegistry Constructor
+    SystemRegistry();
+
+    /// SystemRegistry Destructor
+    ~SystemRegistry();
+
+    /** \brief Registers the system that updates every Entity of a type
+      * \param entityType Type of Entity the system updates, see Entity::setEntityType()
+      * \param system Function called once per Layer per frame with the batch
+      * \return True if registered, False if the type is negative or system is empty
+      *
+      * Replaces any system already registered for the type.
+      */
+    bool registerSystem(int32_t entityType, System system);
+
+    /** \brief Removes the system of a type, its Entities fall back to their callbacks
+      * \param entityType Type of Entity to remove the system of
+      */
+    void removeSystem(int32_t entityType);
+
+    /// \brief Removes every registered system
+    void clearSystems();
+
+    /** \brief Checks whether a type is updated by a system
+      * \param entityType Type of Entity to check
+      * \return True if a system is registered for the type
+      */
+    bool hasSystem(int32_t entityType) const
+    {
+        return entityType >= 0 && static_cast<uint32_t>(entityType) < mSystems.size() && mSystems[entityType];
+    }
+
+    /** \brief Runs the system of a type on a batch of Entities
+      * \param entityType Type of the Entities in the batch
+      * \param entities Active Entities of that type
+      */
+    void runSystem(int32_t entityType, utilities::Span<Entity* const> entities) const;
+
+    /// \return True if no systems are registered
+    const bool isEmpty() const;
+
+    /// \return One past the highest type that can have a system, for sizing per-type batches
+    const uint32_t getTypeRange() const;
+
+    static SystemRegistry& instance();
+
+protected:
+    std::vector<System> mSystems;     ///< Systems indexed by Entity type, empty where none is registered
+    uint32_t            mSystemCount; ///< Number of registered systems
+};
+
+#endif // _SYSTEMREGISTRY_H
+}}
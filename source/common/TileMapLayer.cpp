@@ -0,0 +1,251 @@
+#include "TileMapLayer.h"
+#include "../utilities/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+
+namespace liquid {
+namespace common {
+
+    TileMapLayer::TileMapLayer(GameScene* parentScene, uint32_t width, uint32_t height, float tileWidth, float tileHeight)
+        : Layer(parentScene)
+    {
+        mWidth = width;
+        mHeight = height;
+        mChunksX = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        mChunksY = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        mTileWidth = tileWidth;
+        mTileHeight = tileHeight;
+        mPositionX = 0.0f;
+        mPositionY = 0.0f;
+
+        mAtlasID = -1;
+        mColumns = 1;
+        mTileTexWidth = tileWidth;
+        mTileTexHeight = tileHeight;
+        mOriginX = 0.0f;
+        mOriginY = 0.0f;
+        mRebuiltChunks = 0;
+
+        mChunks.resize(mChunksX * mChunksY);
+        for (Chunk& chunk : mChunks)
+        {
+            chunk.mTiles.fill(EMPTY_TILE);
+            chunk.mDirty = false;
+        }
+    }
+
+    TileMapLayer::~TileMapLayer()
+    {}
+
+    void TileMapLayer::update()
+    {
+        Layer::update();
+
+        // Edits are only collected until here, so a chunk edited many times is built once
+        mRebuiltChunks = mDirtyChunks.size();
+        if (mDirtyChunks.size() > 1)
+        {
+            utilities::ThreadPool::instance().parallelFor(mDirtyChunks.size(), [this](uint32_t i) {
+                buildChunk(mDirtyChunks[i]);
+            });
+        }
+        else if (mDirtyChunks.size() == 1)
+            buildChunk(mDirtyChunks[0]);
+
+        mDirtyChunks.clear();
+    }
+
+    void TileMapLayer::getGeometry(std::array<float, 4> region, std::vector<GeometryBlock>& blocks) const
+    {
+        uint32_t firstX = 0, firstY = 0;
+        uint32_t lastX = mChunksX, lastY = mChunksY;
+
+        // The grid is regular, so the visible chunks are found without testing each of them
+        if (region[0] != 0 || region[1] != 0 || region[2] != 0 || region[3] != 0)
+        {
+            float chunkWidth = mTileWidth * CHUNK_SIZE;
+            float chunkHeight = mTileHeight * CHUNK_SIZE;
+
+            float x1 = std::floor((region[0] - mPositionX) / chunkWidth);
+            float y1 = std::floor((region[1] - mPositionY) / chunkHeight);
+            float x2 = std::floor((region[2] - mPositionX) / chunkWidth) + 1.0f;
+            float y2 = std::floor((region[3] - mPositionY) / chunkHeight) + 1.0f;
+
+            firstX = (uint32_t)std::min(std::max(x1, 0.0f), (float)mChunksX);
+            firstY = (uint32_t)std::min(std::max(y1, 0.0f), (float)mChunksY);
+            lastX = (uint32_t)std::min(std::max(x2, 0.0f), (float)mChunksX);
+            lastY = (uint32_t)std::min(std::max(y2, 0.0f), (float)mChunksY);
+        }
+
+        for (uint32_t y = firstY; y < lastY; y++)
+        {
+            for (uint32_t x = firstX; x < lastX; x++)
+            {
+                const Chunk& chunk = mChunks[y * mChunksX + x];
+                if (chunk.mVertices.empty())
+                    continue;
+
+                GeometryBlock block;
+                block.mVertices = chunk.mVertices.data();
+                block.mVertexCount = chunk.mVertices.size();
+                block.mAtlasID = mAtlasID;
+                block.mShaderID = -1;
+                block.mBlendMode = 0;
+                block.mPrimitiveType = 0;
+                blocks.push_back(block);
+            }
+        }
+
+        // Baked Entities of a static map stay above the tiles
+        Layer::getGeometry(region, blocks);
+    }
+
+    void TileMapLayer::setTileSet(int32_t atlasID, uint32_t columns, float tileTexWidth, float tileTexHeight,
+                                  float originX, float originY)
+    {
+        mAtlasID = atlasID;
+        mColumns = std::max(columns, 1u);
+        mTileTexWidth = tileTexWidth;
+        mTileTexHeight = tileTexHeight;
+        mOriginX = originX;
+        mOriginY = originY;
+
+        invalidateChunks();
+    }
+
+    void TileMapLayer::setPosition(float x, float y)
+    {
+        mPositionX = x;
+        mPositionY = y;
+
+        invalidateChunks();
+    }
+
+    void TileMapLayer::setTile(uint32_t x, uint32_t y, uint16_t tile)
+    {
+        if (x >= mWidth || y >= mHeight)
+            return;
+
+        uint32_t index = (y / CHUNK_SIZE) * mChunksX + (x / CHUNK_SIZE);
+        uint16_t& slot = mChunks[index].mTiles[(y % CHUNK_SIZE) * CHUNK_SIZE + (x % CHUNK_SIZE)];
+        if (slot == tile)
+            return;
+
+        slot = tile;
+        if (mChunks[index].mDirty == false)
+        {
+            mChunks[index].mDirty = true;
+            mDirtyChunks.push_back(index);
+        }
+    }
+
+    void TileMapLayer::setTiles(const uint16_t* tiles)
+    {
+        for (uint32_t y = 0; y < mHeight; y++)
+        {
+            for (uint32_t x = 0; x < mWidth; x++)
+                setTile(x, y, tiles[y * mWidth + x]);
+        }
+    }
+
+    void TileMapLayer::fill(uint16_t tile)
+    {
+        for (uint32_t y = 0; y < mHeight; y++)
+        {
+            for (uint32_t x = 0; x < mWidth; x++)
+                setTile(x, y, tile);
+        }
+    }
+
+    uint16_t TileMapLayer::getTile(uint32_t x, uint32_t y) const
+    {
+        if (x >= mWidth || y >= mHeight)
+            return EMPTY_TILE;
+
+        const Chunk& chunk = mChunks[(y / CHUNK_SIZE) * mChunksX + (x / CHUNK_SIZE)];
+        return chunk.mTiles[(y % CHUNK_SIZE) * CHUNK_SIZE + (x % CHUNK_SIZE)];
+    }
+
+    uint16_t TileMapLayer::getTileAtPoint(float x, float y) const
+    {
+        float column = std::floor((x - mPositionX) / mTileWidth);
+        float row = std::floor((y - mPositionY) / mTileHeight);
+        if (column < 0.0f || row < 0.0f)
+            return EMPTY_TILE;
+
+        return getTile((uint32_t)column, (uint32_t)row);
+    }
+
+    const uint32_t TileMapLayer::getWidth() const
+    {
+        return mWidth;
+    }
+
+    const uint32_t TileMapLayer::getHeight() const
+    {
+        return mHeight;
+    }
+
+    const uint32_t TileMapLayer::getChunkCount() const
+    {
+        return mChunks.size();
+    }
+
+    const uint32_t TileMapLayer::getRebuiltChunkCount() const
+    {
+        return mRebuiltChunks;
+    }
+
+    void TileMapLayer::buildChunk(uint32_t index)
+    {
+        Chunk& chunk = mChunks[index];
+        chunk.mVertices.clear();
+        chunk.mDirty = false;
+
+        float chunkX = mPositionX + (index % mChunksX) * CHUNK_SIZE * mTileWidth;
+        float chunkY = mPositionY + (index / mChunksX) * CHUNK_SIZE * mTileHeight;
+
+        for (uint32_t t = 0; t < CHUNK_SIZE * CHUNK_SIZE; t++)
+        {
+            uint16_t tile = chunk.mTiles[t];
+            if (tile == EMPTY_TILE)
+                continue;
+
+            float x = chunkX + (t % CHUNK_SIZE) * mTileWidth;
+            float y = chunkY + (t / CHUNK_SIZE) * mTileHeight;
+            float u = mOriginX + (tile % mColumns) * mTileTexWidth;
+            float v = mOriginY + (tile / mColumns) * mTileTexHeight;
+
+            // Same corner order as an Entity's quad
+            graphics::RenderVertex vertex;
+            vertex.mPositionX = x;
+            vertex.mPositionY = y;
+            vertex.mTexCoordX = u;
+            vertex.mTexCoordY = v;
+            chunk.mVertices.push_back(vertex);
+
+            vertex.mPositionX = x + mTileWidth;
+            vertex.mTexCoordX = u + mTileTexWidth;
+            chunk.mVertices.push_back(vertex);
+
+            vertex.mPositionY = y + mTileHeight;
+            vertex.mTexCoordY = v + mTileTexHeight;
+            chunk.mVertices.push_back(vertex);
+
+            vertex.mPositionX = x;
+            vertex.mTexCoordX = u;
+            chunk.mVertices.push_back(vertex);
+        }
+    }
+
+    void TileMapLayer::invalidateChunks()
+    {
+        mDirtyChunks.clear();
+        for (uint32_t i = 0; i < mChunks.size(); i++)
+        {
+            mChunks[i].mDirty = true;
+            mDirtyChunks.push_back(i);
+        }
+    }
+
+}}
@@ -0,0 +1,158 @@
+#include "Layer.h"
+#include <array>
+#include <vector>
+#include <stdint.h>
+
+namespace liquid { namespace common {
+#ifndef _TILEMAPLAYER_H
+#define _TILEMAPLAYER_H
+
+/**
+ * \class TileMapLayer
+ *
+ * \ingroup Common
+ * \brief Layer that stores a grid of tiles instead of one Entity per tile
+ *
+ * Tiles are 16-bit indices into a tile set laid out in rows on a texture atlas. The
+ * grid is split into square chunks that each keep the quads of their tiles in a cached
+ * vertex block. A chunk is only rebuilt when one of its tiles changes, at the end of
+ * the next update(), and the renderer culls whole chunks against the camera through
+ * getGeometry().
+ *
+ * Entities can still be inserted and are drawn above the tiles.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class TileMapLayer : public Layer
+{
+public:
+    /// Width and height of a chunk in tiles
+    static const uint32_t CHUNK_SIZE = 32;
+
+    /// Tile index that draws nothing
+    static const uint16_t EMPTY_TILE = 0xFFFF;
+
+public:
+    /** \brief TileMapLayer Constructor, every tile starts as EMPTY_TILE
+      * \param parentScene Scene the Layer belongs to
+      * \param width Width of the map in tiles
+      * \param height Height of the map in tiles
+      * \param tileWidth Width of a tile in 2D space
+      * \param tileHeight Height of a tile in 2D space
+      */
+    TileMapLayer(GameScene* parentScene, uint32_t width, uint32_t height, float tileWidth, float tileHeight);
+
+    /// TileMapLayer Destructor
+    ~TileMapLayer();
+
+    /// \brief Updates the Entities of the Layer then rebuilds the edited chunks
+    virtual void update() override;
+
+    /// \brief Appends the chunks that overlap the region, followed by any baked geometry of the Layer
+    virtual void getGeometry(std::array<float, 4> region, std::vector<GeometryBlock>& blocks) const override;
+
+    /** \brief Sets the tile set the indices refer to, rebuilding every chunk
+      * \param atlasID Texture atlas holding the tile set
+      * \param columns Number of tiles in a row of the tile set
+      * \param tileTexWidth Width of a tile on the texture in pixels
+      * \param tileTexHeight Height of a tile on the texture in pixels
+      * \param originX Left edge of the tile set on the texture in pixels
+      * \param originY Top edge of the tile set on the texture in pixels
+      */
+    void setTileSet(int32_t atlasID, uint32_t columns, float tileTexWidth, float tileTexHeight,
+                    float originX = 0.0f, float originY = 0.0f);
+
+    /** \brief Moves the top left corner of the map, rebuilding every chunk
+      * \param x X-Coordinate of the corner
+      * \param y Y-Coordinate of the corner
+      */
+    void setPosition(float x, float y);
+
+    /** \brief Sets a tile, its chunk is rebuilt on the next update()
+      * \param x Column of the tile
+      * \param y Row of the tile
+      * \param tile Index into the tile set, EMPTY_TILE to clear
+      */
+    void setTile(uint32_t x, uint32_t y, uint16_t tile);
+
+    /** \brief Replaces every tile of the map
+      * \param tiles Rows of width * height indices, top row first
+      */
+    void setTiles(const uint16_t* tiles);
+
+    /** \brief Sets every tile of the map to the same index
+      * \param tile Index into the tile set, EMPTY_TILE to clear
+      */
+    void fill(uint16_t tile);
+
+    /** \brief Gets a tile
+      * \param x Column of the tile
+      * \param y Row of the tile
+      * \return Index of the tile, EMPTY_TILE if outside the map
+      */
+    uint16_t getTile(uint32_t x, uint32_t y) const;
+
+    /** \brief Gets the tile under a point in 2D space
+      * \param x X-Coordinate of the point
+      * \param y Y-Coordinate of the point
+      * \return Index of the tile, EMPTY_TILE if outside the map
+      */
+    uint16_t getTileAtPoint(float x, float y) const;
+
+    /// \return Width of the map in tiles
+    const uint32_t getWidth() const;
+
+    /// \return Height of the map in tiles
+    const uint32_t getHeight() const;
+
+    /// \return Number of chunks the map is split into
+    const uint32_t getChunkCount() const;
+
+    /// \return Number of chunks rebuilt by the last update()
+    const uint32_t getRebuiltChunkCount() const;
+
+protected:
+    /// Square block of tiles and the quads built from them
+    struct Chunk
+    {
+        std::array<uint16_t, CHUNK_SIZE * CHUNK_SIZE> mTiles;    ///< Rows of tile indices
+        std::vector<graphics::RenderVertex>           mVertices; ///< Quads of the non-empty tiles
+        bool                                          mDirty;    ///< True if mVertices is out of date
+    };
+
+    /** \brief Rebuilds the quads of a chunk
+      * \param index Index of the chunk
+      */
+    void buildChunk(uint32_t index);
+
+    /// \brief Marks every chunk for rebuilding
+    void invalidateChunks();
+
+protected:
+    uint32_t              mWidth;          ///< Width of the map in tiles
+    uint32_t              mHeight;         ///< Height of the map in tiles
+    uint32_t              mChunksX;        ///< Number of chunks across the map
+    uint32_t              mChunksY;        ///< Number of chunks down the map
+    float                 mTileWidth;      ///< Width of a tile in 2D space
+    float                 mTileHeight;     ///< Height of a tile in 2D space
+    float                 mPositionX;      ///< X-Coordinate of the top left corner
+    float                 mPositionY;      ///< Y-Coordinate of the top left corner
+
+    int32_t               mAtlasID;        ///< Texture atlas holding the tile set
+    uint32_t              mColumns;        ///< Number of tiles in a row of the tile set
+    float                 mTileTexWidth;   ///< Width of a tile on the texture
+    float                 mTileTexHeight;  ///< Height of a tile on the texture
+    float                 mOriginX;        ///< Left edge of the tile set on the texture
+    float                 mOriginY;        ///< Top edge of the tile set on the texture
+
+    std::vector<Chunk>    mChunks;         ///< Chunks in rows, top row first
+    std::vector<uint32_t> mDirtyChunks;    ///< Chunks edited since the last update()
+    uint32_t              mRebuiltChunks;  ///< Chunks rebuilt by the last update()
+};
+
+#endif // _TILEMAPLAYER_H
+}}
@@ -0,0 +1,88 @@
+#include <map>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "Entity.h"
+
+namespace liquid { namespace common {
+#ifndef _WORLDCHUNK_H
+#define _WORLDCHUNK_H
+
+/**
+ * \class WorldChunk
+ *
+ * \ingroup Common
+ * \brief One square cell of a streamed world and the Entities that live in it
+ *
+ * Chunks are created and owned by the WorldStreamer; a ChunkProvider fills in
+ * mEntities when the chunk is loaded and writes them out again before it is freed.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class WorldChunk
+{
+public:
+    /// Defines where a chunk is in its streaming lifetime
+    enum eChunkState
+    {
+        CHUNKSTATE_LOADING = 0,   ///< Being loaded on a background thread
+        CHUNKSTATE_LOADED = 1,    ///< Loaded, waiting for a frame with activation budget left
+        CHUNKSTATE_ACTIVE = 2,    ///< Entities are inserted into the GameScene
+        CHUNKSTATE_UNLOADING = 3, ///< Removed from the GameScene, being saved on a background thread
+        CHUNKSTATE_FAILED = 4,    ///< The ChunkProvider could not load the chunk, retried after mRetryFrame
+    };
+
+public:
+    /** \brief WorldChunk Constructor
+      * \param chunkX Chunk coordinate on the X-Axis
+      * \param chunkY Chunk coordinate on the Y-Axis
+      */
+    WorldChunk(int32_t chunkX, int32_t chunkY)
+    {
+        mChunkX = chunkX;
+        mChunkY = chunkY;
+        mState = CHUNKSTATE_LOADING;
+        mMemoryUsage = 0;
+        mFailures = 0;
+        mRetryFrame = 0;
+    }
+
+    /// WorldChunk Destructor
+    ~WorldChunk() {}
+
+    /** \brief Adds an Entity to the chunk, call from ChunkProvider::loadChunk()
+      * \param layerName Name of the Layer in the GameScene to insert the Entity into
+      * \param entity Entity to add, the chunk takes ownership
+      */
+    void insertEntity(std::string layerName, Entity* entity)
+    {
+        mEntities[layerName].push_back(entity);
+    }
+
+    /// \return Number of Entities in the chunk across every Layer
+    const uint32_t getEntityCount() const
+    {
+        uint32_t count = 0;
+        for (auto& layer : mEntities)
+            count += layer.second.size();
+
+        return count;
+    }
+
+public:
+    int32_t                                      mChunkX;         ///< Chunk coordinate on the X-Axis
+    int32_t                                      mChunkY;         ///< Chunk coordinate on the Y-Axis
+    eChunkState                                  mState;          ///< Current streaming state
+    uint64_t                                     mMemoryUsage;    ///< Resident size in bytes, estimated if the provider leaves it 0
+    std::map<std::string, std::vector<Entity*>>  mEntities;       ///< Entities of the chunk keyed by Layer name
+    std::vector<std::string>                     mInsertedLayers; ///< Layers that took their Entities on activation, the rest stay owned by the chunk
+    uint32_t                                     mFailures;       ///< Loads that failed in a row
+    uint32_t                                     mRetryFrame;     ///< WorldStreamer frame from which a failed load may be retried
+};
+
+#endif // _WORLDCHUNK_H
+}}
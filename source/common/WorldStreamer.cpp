@@ -0,0 +1,396 @@
+#include "WorldStreamer.h"
+#include "GameScene.h"
+#include <chrono>
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+namespace liquid {
+namespace common {
+
+    WorldStreamer::WorldStreamer(ChunkProvider* provider, float chunkSize, uint32_t threadCount)
+    {
+        mProvider = provider;
+        mThreadPool = new utilities::ThreadPool(std::max(threadCount, 1u));
+        mChunkSize = chunkSize;
+        mLoadRadius = 1;
+        mUnloadRadius = 2;
+        mActivationBudget = 2.0f;
+        mMemoryBudget = 0;
+        mMemoryUsage = 0;
+        mMaxPendingLoads = 4;
+        mPendingLoads = 0;
+        mActiveChunks = 0;
+        mFrame = 0;
+        mFollowCamera = true;
+    }
+
+    WorldStreamer::~WorldStreamer()
+    {
+        // Joining the workers finishes every queued load and save first
+        delete mThreadPool;
+        mThreadPool = nullptr;
+
+        // Active chunks have handed most of their Entities to the Layers, which delete them
+        for (auto& entry : mChunks)
+        {
+            deleteEntities(entry.second);
+            delete entry.second;
+        }
+
+        mChunks.clear();
+        mReady.clear();
+    }
+
+    void WorldStreamer::update(GameScene* gameScene)
+    {
+        mFrame++;
+        collectFinished();
+
+        std::vector<std::array<float, 2>> points;
+        if (mFollowCamera && gameScene->getCamera() != nullptr)
+        {
+            std::array<float, 2> centre = gameScene->getCamera()->getCentre();
+            points.push_back({ centre[0] / mChunkSize, centre[1] / mChunkSize });
+        }
+
+        for (std::array<float, 2>& point : mInterestPoints)
+            points.push_back({ point[0] / mChunkSize, point[1] / mChunkSize });
+
+        // Nothing to stream around, keep whatever is resident
+        if (points.empty() == false)
+        {
+            evictChunks(gameScene, points);
+            requestChunks(points);
+        }
+
+        activateChunks(gameScene);
+    }
+
+    void WorldStreamer::setRadius(int32_t loadRadius, int32_t unloadRadius)
+    {
+        mLoadRadius = std::max(loadRadius, 0);
+        mUnloadRadius = std::max(unloadRadius, mLoadRadius);
+    }
+
+    void WorldStreamer::setActivationBudget(float milliseconds)
+    {
+        mActivationBudget = milliseconds;
+    }
+
+    void WorldStreamer::setMemoryBudget(uint64_t bytes)
+    {
+        mMemoryBudget = bytes;
+    }
+
+    void WorldStreamer::setMaxPendingLoads(uint32_t maxLoads)
+    {
+        mMaxPendingLoads = std::max(maxLoads, 1u);
+    }
+
+    void WorldStreamer::setFollowCamera(bool followCamera)
+    {
+        mFollowCamera = followCamera;
+    }
+
+    uint32_t WorldStreamer::addInterestPoint(std::array<float, 2> point)
+    {
+        mInterestPoints.push_back(point);
+        return mInterestPoints.size() - 1;
+    }
+
+    void WorldStreamer::setInterestPoint(uint32_t index, std::array<float, 2> point)
+    {
+        if (index < mInterestPoints.size())
+            mInterestPoints[index] = point;
+    }
+
+    void WorldStreamer::clearInterestPoints()
+    {
+        mInterestPoints.clear();
+    }
+
+    WorldChunk* WorldStreamer::getChunk(int32_t chunkX, int32_t chunkY) const
+    {
+        std::map<uint64_t, WorldChunk*>::const_iterator it = mChunks.find(getChunkKey(chunkX, chunkY));
+        if (it != mChunks.end())
+            return (*it).second;
+
+        return nullptr;
+    }
+
+    std::array<int32_t, 2> WorldStreamer::getChunkCoordinates(float x, float y) const
+    {
+        return { (int32_t)std::floor(x / mChunkSize), (int32_t)std::floor(y / mChunkSize) };
+    }
+
+    const uint32_t WorldStreamer::getChunkCount() const
+    {
+        return mChunks.size();
+    }
+
+    const uint32_t WorldStreamer::getActiveChunkCount() const
+    {
+        return mActiveChunks;
+    }
+
+    const uint64_t WorldStreamer::getMemoryUsage() const
+    {
+        return mMemoryUsage;
+    }
+
+    void WorldStreamer::collectFinished()
+    {
+        std::vector<std::pair<WorldChunk*, bool>> loads;
+        std::vector<WorldChunk*> saves;
+
+        {
+            std::lock_guard<std::mutex> lock(mFinishedMutex);
+            loads.swap(mFinishedLoads);
+            saves.swap(mFinishedSaves);
+        }
+
+        for (std::pair<WorldChunk*, bool>& load : loads)
+        {
+            WorldChunk* chunk = load.first;
+            mPendingLoads--;
+
+            if (load.second == false)
+            {
+                // Whatever the provider managed to create is dropped, the retry starts afresh
+                deleteEntities(chunk);
+                chunk->mEntities.clear();
+                chunk->mMemoryUsage = 0;
+                chunk->mState = WorldChunk::CHUNKSTATE_FAILED;
+                chunk->mRetryFrame = mFrame + std::min(RETRY_FRAMES << std::min(chunk->mFailures, 6u), MAX_RETRY_FRAMES);
+                chunk->mFailures++;
+                continue;
+            }
+
+            chunk->mFailures = 0;
+
+            if (chunk->mMemoryUsage == 0)
+                chunk->mMemoryUsage = chunk->getEntityCount() * (sizeof(Entity) + 4 * sizeof(utilities::Vertex2));
+
+            chunk->mState = WorldChunk::CHUNKSTATE_LOADED;
+            mMemoryUsage += chunk->mMemoryUsage;
+            mReady.push_back(chunk);
+        }
+
+        // Entities are freed here rather than on the workers as their LuaRefs belong to the main thread
+        for (WorldChunk* chunk : saves)
+        {
+            deleteEntities(chunk);
+            mMemoryUsage -= chunk->mMemoryUsage;
+            mChunks.erase(getChunkKey(chunk->mChunkX, chunk->mChunkY));
+            delete chunk;
+        }
+    }
+
+    void WorldStreamer::requestChunks(const std::vector<std::array<float, 2>>& points)
+    {
+        if (mMemoryBudget > 0 && mMemoryUsage >= mMemoryBudget)
+            return;
+
+        // Walk outwards ring by ring so the closest chunks are requested first
+        for (int32_t ring = 0; ring <= mLoadRadius; ring++)
+        {
+            for (const std::array<float, 2>& point : points)
+            {
+                int32_t centreX = (int32_t)std::floor(point[0]);
+                int32_t centreY = (int32_t)std::floor(point[1]);
+
+                for (int32_t y = -ring; y <= ring; y++)
+                {
+                    for (int32_t x = -ring; x <= ring; x++)
+                    {
+                        if (std::max(std::abs(x), std::abs(y)) != ring)
+                            continue;
+
+                        if (mPendingLoads >= mMaxPendingLoads)
+                            return;
+
+                        uint64_t key = getChunkKey(centreX + x, centreY + y);
+                        std::map<uint64_t, WorldChunk*>::iterator resident = mChunks.find(key);
+                        if (resident != mChunks.end())
+                        {
+                            WorldChunk* failed = (*resident).second;
+                            if (failed->mState == WorldChunk::CHUNKSTATE_FAILED && mFrame >= failed->mRetryFrame)
+                            {
+                                failed->mState = WorldChunk::CHUNKSTATE_LOADING;
+                                submitLoad(failed);
+                            }
+
+                            continue;
+                        }
+
+                        WorldChunk* chunk = new WorldChunk(centreX + x, centreY + y);
+                        mChunks[key] = chunk;
+                        submitLoad(chunk);
+                    }
+                }
+            }
+        }
+    }
+
+    void WorldStreamer::submitLoad(WorldChunk* chunk)
+    {
+        mPendingLoads++;
+        mThreadPool->submit([this, chunk]()
+        {
+            bool loaded = mProvider->loadChunk(chunk);
+
+            std::lock_guard<std::mutex> lock(mFinishedMutex);
+            mFinishedLoads.push_back(std::make_pair(chunk, loaded));
+        });
+    }
+
+    void WorldStreamer::deleteEntities(WorldChunk* chunk)
+    {
+        for (auto& layer : chunk->mEntities)
+        {
+            if (std::find(chunk->mInsertedLayers.begin(), chunk->mInsertedLayers.end(), layer.first) != chunk->mInsertedLayers.end())
+                continue;
+
+            for (Entity* entity : layer.second)
+                delete entity;
+        }
+    }
+
+    void WorldStreamer::activateChunks(GameScene* gameScene)
+    {
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        while (mReady.empty() == false)
+        {
+            WorldChunk* chunk = mReady.front();
+            mReady.pop_front();
+
+            for (auto& layer : chunk->mEntities)
+            {
+                // Without a Layer to take them the Entities stay with the chunk
+                Layer* target = gameScene->getLayer(layer.first);
+                if (target != nullptr)
+                {
+                    target->insertEntity(layer.second);
+                    chunk->mInsertedLayers.push_back(layer.first);
+                }
+            }
+
+            chunk->mState = WorldChunk::CHUNKSTATE_ACTIVE;
+            mActiveChunks++;
+            mProvider->activateChunk(chunk);
+
+            float elapsed = std::chrono::duration_cast<
+                            std::chrono::duration<float, std::milli>>
+                            (std::chrono::high_resolution_clock::now() - start).count();
+
+            if (elapsed >= mActivationBudget)
+                break;
+        }
+    }
+
+    void WorldStreamer::evictChunks(GameScene* gameScene, const std::vector<std::array<float, 2>>& points)
+    {
+        std::vector<std::pair<float, WorldChunk*>> candidates;
+        std::vector<uint64_t> discarded;
+
+        for (auto& entry : mChunks)
+        {
+            WorldChunk* chunk = entry.second;
+            float distance = getChunkDistance(chunk, points);
+
+            if (distance > mUnloadRadius)
+            {
+                if (chunk->mState == WorldChunk::CHUNKSTATE_ACTIVE)
+                {
+                    unloadChunk(gameScene, chunk);
+                }
+                else if (chunk->mState == WorldChunk::CHUNKSTATE_LOADED)
+                {
+                    // Never made it into the scene, so there is nothing new to save
+                    mReady.erase(std::find(mReady.begin(), mReady.end(), chunk));
+                    deleteEntities(chunk);
+
+                    mMemoryUsage -= chunk->mMemoryUsage;
+                    discarded.push_back(entry.first);
+                }
+                else if (chunk->mState == WorldChunk::CHUNKSTATE_FAILED)
+                {
+                    discarded.push_back(entry.first);
+                }
+            }
+            else if (distance > mLoadRadius && chunk->mState == WorldChunk::CHUNKSTATE_ACTIVE)
+            {
+                candidates.push_back(std::make_pair(distance, chunk));
+            }
+        }
+
+        for (uint64_t key : discarded)
+        {
+            delete mChunks[key];
+            mChunks.erase(key);
+        }
+
+        if (mMemoryBudget == 0 || mMemoryUsage <= mMemoryBudget)
+            return;
+
+        // Over budget: give up the furthest chunks that are only kept by the unload margin
+        std::sort(candidates.begin(), candidates.end(),
+            [](const std::pair<float, WorldChunk*>& a, const std::pair<float, WorldChunk*>& b) {
+            return a.first > b.first;
+        });
+
+        uint64_t projected = mMemoryUsage;
+        for (std::pair<float, WorldChunk*>& candidate : candidates)
+        {
+            if (projected <= mMemoryBudget)
+                break;
+
+            projected -= candidate.second->mMemoryUsage;
+            unloadChunk(gameScene, candidate.second);
+        }
+    }
+
+    void WorldStreamer::unloadChunk(GameScene* gameScene, WorldChunk* chunk)
+    {
+        // The Entities go back to the chunk, each Layer is walked once for all of them
+        for (const std::string& layerName : chunk->mInsertedLayers)
+        {
+            Layer* target = gameScene->getLayer(layerName);
+            if (target != nullptr)
+                target->removeEntities(chunk->mEntities[layerName]);
+        }
+
+        chunk->mInsertedLayers.clear();
+        chunk->mState = WorldChunk::CHUNKSTATE_UNLOADING;
+        mActiveChunks--;
+
+        mThreadPool->submit([this, chunk]()
+        {
+            mProvider->saveChunk(chunk);
+
+            std::lock_guard<std::mutex> lock(mFinishedMutex);
+            mFinishedSaves.push_back(chunk);
+        });
+    }
+
+    float WorldStreamer::getChunkDistance(const WorldChunk* chunk, const std::vector<std::array<float, 2>>& points) const
+    {
+        float closest = FLT_MAX;
+        for (const std::array<float, 2>& point : points)
+        {
+            float distanceX = std::fabs((float)chunk->mChunkX - std::floor(point[0]));
+            float distanceY = std::fabs((float)chunk->mChunkY - std::floor(point[1]));
+            closest = std::min(closest, std::max(distanceX, distanceY));
+        }
+
+        return closest;
+    }
+
+    uint64_t WorldStreamer::getChunkKey(int32_t chunkX, int32_t chunkY)
+    {
+        return ((uint64_t)(uint32_t)chunkX << 32) | (uint64_t)(uint32_t)chunkY;
+    }
+
+}}
@@ -0,0 +1,191 @@
+#include <map>
+#include <deque>
+#include <array>
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+#include "WorldChunk.h"
+#include "ChunkProvider.h"
+#include "../utilities/ThreadPool.h"
+
+namespace liquid { namespace common {
+#ifndef _WORLDSTREAMER_H
+#define _WORLDSTREAMER_H
+
+/**
+ * \class WorldStreamer
+ *
+ * \ingroup Common
+ * \brief Streams a GameScene in square chunks around the Camera and other interest points
+ *
+ * Every frame the chunks within the load radius of an interest point are requested
+ * from the ChunkProvider on background threads. Loaded chunks are inserted into the
+ * GameScene at the start of GameScene::update(), as many per frame as the activation
+ * budget allows. Chunks beyond the unload radius are taken out of the GameScene,
+ * saved by the ChunkProvider in the background and freed. When the resident memory
+ * budget is exceeded the furthest chunks outside the load radius are unloaded first
+ * and no new loads are started until the streamer is back under budget.
+ *
+ * A chunk the ChunkProvider fails to load stays resident in the failed state and is
+ * loaded again once it has waited RETRY_FRAMES updates, the wait doubling after every
+ * further failure up to MAX_RETRY_FRAMES, for as long as it is within the load radius.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class GameScene;
+class WorldStreamer
+{
+public:
+    /// Updates a failed chunk waits before its first retry
+    static const uint32_t RETRY_FRAMES = 30;
+
+    /// Longest wait in updates between retries of a chunk that keeps failing
+    static const uint32_t MAX_RETRY_FRAMES = 1920;
+
+public:
+    /** \brief WorldStreamer Constructor
+      * \param provider ChunkProvider used to load and save chunks, not owned
+      * \param chunkSize Width and height of one chunk in world units
+      * \param threadCount Number of background threads used for loading and saving
+      */
+    WorldStreamer(ChunkProvider* provider, float chunkSize, uint32_t threadCount = 1);
+
+    /// WorldStreamer Destructor, waits for background work and frees every chunk
+    ~WorldStreamer();
+
+    /** \brief Streams chunks in and out, called at the start of GameScene::update()
+      * \param gameScene Scene the chunks are inserted into and removed from
+      */
+    virtual void update(GameScene* gameScene);
+
+    /** \brief Sets how many chunks around an interest point are kept loaded
+      * \param loadRadius Chunks within this distance (in chunks) are loaded
+      * \param unloadRadius Chunks beyond this distance (in chunks) are unloaded, at least loadRadius
+      */
+    void setRadius(int32_t loadRadius, int32_t unloadRadius);
+
+    /** \brief Sets the time the main thread may spend activating chunks each frame
+      * \param milliseconds Budget in milliseconds, at least one chunk is always activated
+      */
+    void setActivationBudget(float milliseconds);
+
+    /** \brief Sets the resident memory budget of all loaded chunks
+      * \param bytes Budget in bytes, 0 for unlimited
+      */
+    void setMemoryBudget(uint64_t bytes);
+
+    /** \brief Sets the number of chunk loads that may be in flight at once
+      * \param maxLoads Maximum number of chunks loading at once
+      */
+    void setMaxPendingLoads(uint32_t maxLoads);
+
+    /** \brief Sets if the Camera of the GameScene is used as an interest point
+      * \param followCamera True to stream around the Camera centre
+      */
+    void setFollowCamera(bool followCamera);
+
+    /** \brief Adds an extra point in world space to stream chunks around
+      * \param point Position in 2D space
+      * \return Index of the interest point for setInterestPoint() and removeInterestPoint()
+      */
+    uint32_t addInterestPoint(std::array<float, 2> point);
+
+    /** \brief Moves an interest point
+      * \param index Index returned by addInterestPoint()
+      * \param point New position in 2D space
+      */
+    void setInterestPoint(uint32_t index, std::array<float, 2> point);
+
+    /// \brief Removes every interest point added with addInterestPoint()
+    void clearInterestPoints();
+
+    /** \brief Gets the chunk at the given chunk coordinates
+      * \return Pointer to the chunk, nullptr if it is not resident
+      */
+    WorldChunk* getChunk(int32_t chunkX, int32_t chunkY) const;
+
+    /// \return Chunk coordinates containing the given point in world space
+    std::array<int32_t, 2> getChunkCoordinates(float x, float y) const;
+
+    /// \return Number of chunks resident in any state
+    const uint32_t getChunkCount() const;
+
+    /// \return Number of chunks with their Entities in the GameScene
+    const uint32_t getActiveChunkCount() const;
+
+    /// \return Estimated bytes used by loaded and active chunks
+    const uint64_t getMemoryUsage() const;
+
+protected:
+    /// \brief Moves finished background work into the main thread's view of the chunks
+    void collectFinished();
+
+    /** \brief Starts loading the chunks around every interest point that are not resident
+      * \param points Interest points for this frame, in chunk coordinates
+      */
+    void requestChunks(const std::vector<std::array<float, 2>>& points);
+
+    /** \brief Queues a chunk in the loading state on the background threads
+      * \param chunk Chunk to load
+      */
+    void submitLoad(WorldChunk* chunk);
+
+    /** \brief Frees the Entities a chunk still owns
+      * \param chunk Chunk to empty, Entities handed to a Layer on activation are left to the Layer
+      */
+    void deleteEntities(WorldChunk* chunk);
+
+    /** \brief Inserts loaded chunks into the GameScene while the activation budget lasts
+      * \param gameScene Scene to insert into
+      */
+    void activateChunks(GameScene* gameScene);
+
+    /** \brief Unloads active chunks that are too far away or over the memory budget
+      * \param gameScene Scene to remove the Entities from
+      * \param points Interest points for this frame, in chunk coordinates
+      */
+    void evictChunks(GameScene* gameScene, const std::vector<std::array<float, 2>>& points);
+
+    /** \brief Takes a chunk out of the GameScene and queues it to be saved and freed
+      * \param gameScene Scene to remove the Entities from
+      * \param chunk Active chunk to unload
+      */
+    void unloadChunk(GameScene* gameScene, WorldChunk* chunk);
+
+    /** \brief Distance from a chunk to the closest interest point, in chunks
+      * \param chunk Chunk to measure
+      * \param points Interest points in chunk coordinates
+      */
+    float getChunkDistance(const WorldChunk* chunk, const std::vector<std::array<float, 2>>& points) const;
+
+    /// \return Key into mChunks for the given chunk coordinates
+    static uint64_t getChunkKey(int32_t chunkX, int32_t chunkY);
+
+protected:
+    ChunkProvider*                            mProvider;         ///< Loads and saves chunks, not owned
+    utilities::ThreadPool*                    mThreadPool;       ///< Background threads for loading and saving
+    std::map<uint64_t, WorldChunk*>           mChunks;           ///< Every resident chunk keyed by coordinates
+    std::deque<WorldChunk*>                   mReady;            ///< Loaded chunks waiting to be activated
+    std::vector<std::pair<WorldChunk*, bool>> mFinishedLoads;    ///< Loads finished by the background threads and if they succeeded
+    std::vector<WorldChunk*>                  mFinishedSaves;    ///< Saves finished by the background threads
+    std::mutex                                mFinishedMutex;    ///< Guards mFinishedLoads and mFinishedSaves
+    std::vector<std::array<float, 2>>         mInterestPoints;   ///< Extra points to stream around
+    float                                     mChunkSize;        ///< Width and height of a chunk in world units
+    int32_t                                   mLoadRadius;       ///< Radius in chunks that is kept loaded
+    int32_t                                   mUnloadRadius;     ///< Radius in chunks beyond which chunks unload
+    float                                     mActivationBudget; ///< Milliseconds per frame for activating chunks
+    uint64_t                                  mMemoryBudget;     ///< Resident bytes allowed, 0 for unlimited
+    uint64_t                                  mMemoryUsage;      ///< Bytes used by loaded and active chunks
+    uint32_t                                  mMaxPendingLoads;  ///< Loads allowed in flight at once
+    uint32_t                                  mPendingLoads;     ///< Loads currently in flight
+    uint32_t                                  mActiveChunks;     ///< Chunks with their Entities in the GameScene
+    uint32_t                                  mFrame;            ///< Number of update() calls, times the retries of failed chunks
+    bool                                      mFollowCamera;     ///< Stream around the GameScene Camera as well
+};
+
+#endif // _WORLDSTREAMER_H
+}}
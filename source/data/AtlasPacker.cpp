@@ -0,0 +1,368 @@
+#include "AtlasPacker.h"
+#include "TextureAtlas.h"
+#include "../common/Entity.h"
+#include "../common/ResourceManager.h"
+#include "../utilities/PNGWriter.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+
+namespace liquid {
+namespace data {
+
+    AtlasPacker::AtlasPacker(uint32_t pageSize, uint32_t padding)
+    {
+        mPageSize = pageSize;
+        mPadding = padding;
+        mPackingTime = 0.0f;
+    }
+
+    AtlasPacker::~AtlasPacker()
+    {}
+
+    bool AtlasPacker::addImage(std::string name, uint32_t width, uint32_t height, const uint8_t* pixels,
+                               int32_t sourceAtlasID)
+    {
+        if (width == 0 || height == 0 || pixels == nullptr)
+            return false;
+
+        for (const Image& image : mImages)
+        {
+            if (image.mName == name)
+                return false;
+        }
+
+        Image image;
+        image.mName = name;
+        image.mWidth = width;
+        image.mHeight = height;
+        image.mPixels.assign(pixels, pixels + (size_t)width * height * 4);
+        image.mSourceAtlasID = sourceAtlasID;
+        mImages.push_back(std::move(image));
+        return true;
+    }
+
+    bool AtlasPacker::pack()
+    {
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        mPages.clear();
+        mPlacements.clear();
+        mSources.clear();
+
+        // Largest first leaves the small images to fill the gaps between them
+        std::vector<uint32_t> order(mImages.size());
+        for (uint32_t i = 0; i < order.size(); i++)
+            order[i] = i;
+
+        std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+            uint32_t sideA = std::max(mImages[a].mWidth, mImages[a].mHeight);
+            uint32_t sideB = std::max(mImages[b].mWidth, mImages[b].mHeight);
+            if (sideA != sideB)
+                return sideA > sideB;
+
+            return mImages[a].mWidth * mImages[a].mHeight > mImages[b].mWidth * mImages[b].mHeight;
+        });
+
+        for (uint32_t index : order)
+        {
+            const Image& image = mImages[index];
+            uint32_t width = image.mWidth + mPadding;
+            uint32_t height = image.mHeight + mPadding;
+
+            if (image.mWidth > mPageSize || image.mHeight > mPageSize)
+            {
+                mPages.clear();
+                mPlacements.clear();
+                mSources.clear();
+                return false;
+            }
+
+            // Padding is only needed between images, not against the edge of the page
+            width = std::min(width, mPageSize);
+            height = std::min(height, mPageSize);
+
+            uint32_t bestScore = UINT32_MAX, bestPage = 0;
+            Rect bestRect = { 0, 0, width, height };
+            for (uint32_t p = 0; p < mPages.size(); p++)
+            {
+                Rect rect;
+                uint32_t score = findPosition(mPages[p], width, height, rect);
+                if (score < bestScore)
+                {
+                    bestScore = score;
+                    bestPage = p;
+                    bestRect = rect;
+                }
+            }
+
+            if (bestScore == UINT32_MAX)
+            {
+                mPages.push_back(createPage());
+                bestPage = mPages.size() - 1;
+                findPosition(mPages[bestPage], width, height, bestRect);
+            }
+
+            Page& page = mPages[bestPage];
+            splitFreeRects(page, bestRect);
+            pruneFreeRects(page);
+            page.mUsedArea += (uint64_t)image.mWidth * image.mHeight;
+
+            for (uint32_t y = 0; y < image.mHeight; y++)
+            {
+                std::memcpy(&page.mPixels[((size_t)(bestRect.mY + y) * page.mWidth + bestRect.mX) * 4],
+                            &image.mPixels[(size_t)y * image.mWidth * 4], (size_t)image.mWidth * 4);
+            }
+
+            Placement placement;
+            placement.mPage = bestPage;
+            placement.mX = bestRect.mX;
+            placement.mY = bestRect.mY;
+            placement.mWidth = image.mWidth;
+            placement.mHeight = image.mHeight;
+            placement.mSourceAtlasID = image.mSourceAtlasID;
+            mPlacements[image.mName] = placement;
+
+            if (image.mSourceAtlasID >= 0)
+                mSources[image.mSourceAtlasID] = image.mName;
+        }
+
+        mPackingTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        return true;
+    }
+
+    bool AtlasPacker::publish(std::string pathPrefix)
+    {
+        bool written = true;
+        for (uint32_t p = 0; p < mPages.size(); p++)
+        {
+            std::string name = pathPrefix + "_" + std::to_string(p);
+            written = utilities::PNGWriter::write(name + ".png", mPages[p].mWidth, mPages[p].mHeight,
+                                                  mPages[p].mPixels.data()) && written;
+
+            // A republished prefix keeps its resource, only the regions are replaced
+            common::ResourceManager<TextureAtlas>::ResourceID id =
+                common::ResourceManager<TextureAtlas>::getResourceID(name);
+
+            TextureAtlas* atlas = (id >= 0) ? common::ResourceManager<TextureAtlas>::getResource(id) : nullptr;
+            if (atlas == nullptr)
+            {
+                atlas = new TextureAtlas(name + ".png");
+                id = common::ResourceManager<TextureAtlas>::addResource(name, atlas);
+            }
+
+            atlas->flush();
+            std::ofstream fileStream(name + ".atlas");
+            fileStream << "<atlas name=\"atlas\">\n";
+            fileStream << "    <texture name=\"texture\">" << name << ".png</texture>\n";
+
+            for (const auto& placement : mPlacements)
+            {
+                if (placement.second.mPage != p)
+                    continue;
+
+                const Placement& region = placement.second;
+                atlas->addTextureRegion(placement.first, (float)region.mX, (float)region.mY,
+                                        (float)region.mWidth, (float)region.mHeight);
+
+                fileStream << "    <region name=\"region\">\n";
+                fileStream << "        <name name=\"name\">" << placement.first << "</name>\n";
+                fileStream << "        <coord1 name=\"coord1\">" << region.mX << "</coord1>\n";
+                fileStream << "        <coord2 name=\"coord2\">" << region.mY << "</coord2>\n";
+                fileStream << "        <coord3 name=\"coord3\">" << region.mWidth << "</coord3>\n";
+                fileStream << "        <coord4 name=\"coord4\">" << region.mHeight << "</coord4>\n";
+                fileStream << "    </region>\n";
+            }
+
+            fileStream << "</atlas>\n";
+            fileStream.close();
+            written = written && fileStream.fail() == false;
+            mPages[p].mAtlasID = id;
+        }
+
+        return written;
+    }
+
+    bool AtlasPacker::remapEntity(common::Entity* entity)
+    {
+        if (entity == nullptr)
+            return false;
+
+        bool remapped = false;
+        for (common::Entity* child : entity->getChildren())
+            remapped = remapEntity(child) || remapped;
+
+        std::map<int32_t, std::string>::const_iterator source = mSources.find(entity->mAtlasID);
+        if (source == mSources.end())
+            return remapped;
+
+        const Placement& placement = mPlacements[source->second];
+        const Page& page = mPages[placement.mPage];
+        if (page.mAtlasID < 0)
+            return remapped;
+
+        // Texture coordinates are in pixels, so moving onto the page is a plain offset
+        for (utilities::Vertex2* vertex : entity->getVertices())
+        {
+            std::array<float, 2> texCoord = vertex->getTexCoord();
+            vertex->setTexCoord(texCoord[0] + placement.mX, texCoord[1] + placement.mY);
+        }
+
+        entity->mAtlasID = page.mAtlasID;
+        return true;
+    }
+
+    uint32_t AtlasPacker::remapEntities(utilities::Span<common::Entity* const> entities)
+    {
+        uint32_t remapped = 0;
+        for (common::Entity* entity : entities)
+        {
+            if (remapEntity(entity))
+                remapped++;
+        }
+
+        return remapped;
+    }
+
+    void AtlasPacker::clear()
+    {
+        mImages.clear();
+        mPages.clear();
+        mPlacements.clear();
+        mSources.clear();
+        mPackingTime = 0.0f;
+    }
+
+    const AtlasPacker::Placement* AtlasPacker::getPlacement(std::string name) const
+    {
+        std::map<std::string, Placement>::const_iterator it = mPlacements.find(name);
+        if (it == mPlacements.end())
+            return nullptr;
+
+        return &it->second;
+    }
+
+    const std::vector<AtlasPacker::Page>& AtlasPacker::getPages() const
+    {
+        return mPages;
+    }
+
+    const uint32_t AtlasPacker::getPageCount() const
+    {
+        return mPages.size();
+    }
+
+    const float AtlasPacker::getOccupancy(uint32_t page) const
+    {
+        if (page >= mPages.size())
+            return 0.0f;
+
+        return (float)mPages[page].mUsedArea / ((float)mPages[page].mWidth * mPages[page].mHeight);
+    }
+
+    const float AtlasPacker::getPackingTime() const
+    {
+        return mPackingTime;
+    }
+
+    uint32_t AtlasPacker::findPosition(const Page& page, uint32_t width, uint32_t height, Rect& result)
+    {
+        uint32_t bestShortSide = UINT32_MAX, bestLongSide = UINT32_MAX;
+        for (const Rect& free : page.mFreeRects)
+        {
+            if (free.mWidth < width || free.mHeight < height)
+                continue;
+
+            uint32_t leftoverX = free.mWidth - width;
+            uint32_t leftoverY = free.mHeight - height;
+            uint32_t shortSide = std::min(leftoverX, leftoverY);
+            uint32_t longSide = std::max(leftoverX, leftoverY);
+
+            if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide))
+            {
+                bestShortSide = shortSide;
+                bestLongSide = longSide;
+                result = { free.mX, free.mY, width, height };
+            }
+        }
+
+        return bestShortSide;
+    }
+
+    void AtlasPacker::splitFreeRects(Page& page, const Rect& used)
+    {
+        std::vector<Rect> split;
+        for (uint32_t i = 0; i < page.mFreeRects.size();)
+        {
+            Rect free = page.mFreeRects[i];
+            if (used.mX >= free.mX + free.mWidth || used.mX + used.mWidth <= free.mX ||
+                used.mY >= free.mY + free.mHeight || used.mY + used.mHeight <= free.mY)
+            {
+                i++;
+                continue;
+            }
+
+            // Every side of the free rectangle not covered by the used one stays free
+            if (used.mX > free.mX)
+                split.push_back({ free.mX, free.mY, used.mX - free.mX, free.mHeight });
+
+            if (used.mX + used.mWidth < free.mX + free.mWidth)
+                split.push_back({ used.mX + used.mWidth, free.mY,
+                                  free.mX + free.mWidth - used.mX - used.mWidth, free.mHeight });
+
+            if (used.mY > free.mY)
+                split.push_back({ free.mX, free.mY, free.mWidth, used.mY - free.mY });
+
+            if (used.mY + used.mHeight < free.mY + free.mHeight)
+                split.push_back({ free.mX, used.mY + used.mHeight,
+                                  free.mWidth, free.mY + free.mHeight - used.mY - used.mHeight });
+
+            page.mFreeRects[i] = page.mFreeRects.back();
+            page.mFreeRects.pop_back();
+        }
+
+        page.mFreeRects.insert(page.mFreeRects.end(), split.begin(), split.end());
+    }
+
+    void AtlasPacker::pruneFreeRects(Page& page)
+    {
+        std::vector<Rect>& rects = page.mFreeRects;
+        for (uint32_t i = 0; i < rects.size();)
+        {
+            bool contained = false;
+            for (uint32_t j = 0; j < rects.size(); j++)
+            {
+                const Rect& a = rects[i];
+                const Rect& b = rects[j];
+
+                // Of two identical rectangles only the later one is dropped
+                if (i != j && a.mX >= b.mX && a.mY >= b.mY && a.mX + a.mWidth <= b.mX + b.mWidth &&
+                    a.mY + a.mHeight <= b.mY + b.mHeight &&
+                    (i > j || a.mX != b.mX || a.mY != b.mY || a.mWidth != b.mWidth || a.mHeight != b.mHeight))
+                {
+                    contained = true;
+                    break;
+                }
+            }
+
+            if (contained)
+                rects.erase(rects.begin() + i);
+            else
+                i++;
+        }
+    }
+
+    AtlasPacker::Page AtlasPacker::createPage() const
+    {
+        Page page;
+        page.mWidth = mPageSize;
+        page.mHeight = mPageSize;
+        page.mPixels.assign((size_t)mPageSize * mPageSize * 4, 0);
+        page.mFreeRects.push_back({ 0, 0, mPageSize, mPageSize });
+        page.mUsedArea = 0;
+        page.mAtlasID = -1;
+        return page;
+    }
+
+}}
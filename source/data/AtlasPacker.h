@@ -0,0 +1,183 @@
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include "../utilities/Span.h"
+
+namespace liquid { namespace common { class Entity; } }
+
+namespace liquid { namespace data {
+#ifndef _ATLASPACKER_H
+#define _ATLASPACKER_H
+
+/**
+ * \class AtlasPacker
+ *
+ * \ingroup Data
+ * \brief Packs loose images into shared atlas pages with the MaxRects algorithm
+ *
+ * Every distinct atlas a Layer draws from breaks its batch, so loose images are queued
+ * with addImage() and pack() places them into as few pages as possible, largest first,
+ * using the best short side fit heuristic. Images are never rotated so that remapped
+ * texture coordinates keep their orientation.
+ *
+ * publish() writes each page as a PNG with a matching .atlas file, which Directories
+ * loads like any other atlas, and registers a TextureAtlas per page with the
+ * ResourceManager. remapEntities() then moves Entities drawn from a packed image onto
+ * its page, after which most sprites of a Layer share a single atlas and batch.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class AtlasPacker
+{
+public:
+    /// Where a packed image ended up
+    struct Placement
+    {
+        uint32_t mPage;          ///< Index of the page
+        uint32_t mX;             ///< Left edge on the page in pixels
+        uint32_t mY;             ///< Top edge on the page in pixels
+        uint32_t mWidth;         ///< Width in pixels
+        uint32_t mHeight;        ///< Height in pixels
+        int32_t  mSourceAtlasID; ///< Atlas the image was drawn from before packing, -1 if none
+    };
+
+    /// Free or used area of a page
+    struct Rect
+    {
+        uint32_t mX;      ///< Left edge in pixels
+        uint32_t mY;      ///< Top edge in pixels
+        uint32_t mWidth;  ///< Width in pixels
+        uint32_t mHeight; ///< Height in pixels
+    };
+
+    /// One packed texture
+    struct Page
+    {
+        uint32_t             mWidth;     ///< Width in pixels
+        uint32_t             mHeight;    ///< Height in pixels
+        std::vector<uint8_t> mPixels;    ///< RGBA8 pixels, top row first
+        std::vector<Rect>    mFreeRects; ///< Maximal free rectangles left to place into
+        uint64_t             mUsedArea;  ///< Pixels covered by images, without padding
+        int32_t              mAtlasID;   ///< TextureAtlas registered by publish(), -1 before
+    };
+
+public:
+    /** \brief AtlasPacker Constructor
+      * \param pageSize Width and height of every page in pixels
+      * \param padding Empty pixels kept around every image to stop filtering bleeding
+      */
+    AtlasPacker(uint32_t pageSize = 2048, uint32_t padding = 1);
+
+    /// AtlasPacker Destructor
+    ~AtlasPacker();
+
+    /** \brief Queues an image to be packed, the pixels are copied
+      * \param name Name of the image, becomes the region name on its page
+      * \param width Width of the image in pixels
+      * \param height Height of the image in pixels
+      * \param pixels Rows of RGBA8 pixels, top row first
+      * \param sourceAtlasID Atlas Entities currently draw this image from, -1 if none
+      * \return False if the name is already queued or the image is empty
+      */
+    bool addImage(std::string name, uint32_t width, uint32_t height, const uint8_t* pixels,
+                  int32_t sourceAtlasID = -1);
+
+    /** \brief Places every queued image onto pages, replacing any previous result
+      * \return False if an image is larger than a page, the pages are then empty
+      */
+    bool pack();
+
+    /** \brief Writes the pages to disk and registers them as TextureAtlas resources
+      * \param pathPrefix Prefix of the files and resource names, page N is pathPrefix_N
+      * \return True if every page was written
+      */
+    bool publish(std::string pathPrefix);
+
+    /** \brief Moves an Entity from the atlas of a packed image onto its page
+      * \param entity Entity to remap, including its children
+      * \return True if the Entity or one of its children was remapped
+      */
+    bool remapEntity(common::Entity* entity);
+
+    /** \brief Remaps every given Entity, see remapEntity()
+      * \param entities Entities to remap
+      * \return Number of Entities remapped
+      */
+    uint32_t remapEntities(utilities::Span<common::Entity* const> entities);
+
+    /// \brief Drops the queued images and the pages
+    void clear();
+
+    /** \brief Find where an image was placed
+      * \param name Name given to addImage()
+      * \return Placement of the image, nullptr if it was not packed
+      */
+    const Placement* getPlacement(std::string name) const;
+
+    /// \return Packed pages
+    const std::vector<Page>& getPages() const;
+
+    /// \return Number of packed pages
+    const uint32_t getPageCount() const;
+
+    /** \brief Gets how much of a page is covered by images
+      * \param page Index of the page
+      * \return Fraction between 0 and 1
+      */
+    const float getOccupancy(uint32_t page) const;
+
+    /// \return Milliseconds the last pack() took
+    const float getPackingTime() const;
+
+protected:
+    /// Image waiting to be packed
+    struct Image
+    {
+        std::string          mName;          ///< Name of the image
+        uint32_t             mWidth;         ///< Width in pixels
+        uint32_t             mHeight;        ///< Height in pixels
+        std::vector<uint8_t> mPixels;        ///< RGBA8 pixels
+        int32_t              mSourceAtlasID; ///< Atlas Entities draw the image from
+    };
+
+    /** \brief Finds the free rectangle of a page that fits a size best
+      * \param page Page to search
+      * \param width Width to fit, with padding
+      * \param height Height to fit, with padding
+      * \param result Set to the chosen position
+      * \return Short side fit score, UINT32_MAX if nothing fits
+      */
+    static uint32_t findPosition(const Page& page, uint32_t width, uint32_t height, Rect& result);
+
+    /** \brief Removes a used rectangle from the free rectangles of a page
+      * \param page Page to update
+      * \param used Area now covered
+      */
+    static void splitFreeRects(Page& page, const Rect& used);
+
+    /** \brief Drops free rectangles contained in another
+      * \param page Page to update
+      */
+    static void pruneFreeRects(Page& page);
+
+    /// \return New empty page
+    Page createPage() const;
+
+protected:
+    uint32_t                         mPageSize;    ///< Width and height of every page
+    uint32_t                         mPadding;     ///< Empty pixels around every image
+    std::vector<Image>               mImages;      ///< Images queued by addImage()
+    std::vector<Page>                mPages;       ///< Pages filled by pack()
+    std::map<std::string, Placement> mPlacements;  ///< Placement of every packed image by name
+    std::map<int32_t, std::string>   mSources;     ///< Packed image of every source atlas
+    float                            mPackingTime; ///< Milliseconds the last pack() took
+};
+
+#endif // _ATLASPACKER_H
+}}
@@ -0,0 +1,612 @@
+#include "SceneSnapshot.h"
+#include "../common/GameScene.h"
+#include "../common/Layer.h"
+#include "../common/Entity.h"
+#include "../animation/Animator.h"
+#include "../ai/Agent.h"
+#include <unordered_map>
+#include <cstring>
+#include <cstdio>
+
+namespace liquid {
+namespace data {
+
+    namespace
+    {
+        /// Which header count a block is sized by
+        enum eBlockCount
+        {
+            COUNT_STRING_BYTES,
+            COUNT_LAYERS,
+            COUNT_ENTITIES,
+            COUNT_VERTICES,
+            COUNT_ANIMATORS,
+        };
+
+        /// Element size and count of every block, in eBlock order
+        const struct { uint32_t mStride; eBlockCount mCount; } BLOCK_LAYOUT[SceneSnapshot::BLOCK_COUNT] =
+        {
+            { sizeof(char),         COUNT_STRING_BYTES }, // BLOCK_STRINGS
+            { sizeof(uint32_t),     COUNT_LAYERS },       // BLOCK_LAYER_NAME
+            { sizeof(uint32_t),     COUNT_LAYERS },       // BLOCK_LAYER_FIRST
+            { sizeof(uint32_t),     COUNT_LAYERS },       // BLOCK_LAYER_COUNT
+            { sizeof(int32_t),      COUNT_ENTITIES },     // BLOCK_ENTITY_TYPE
+            { sizeof(int32_t),      COUNT_ENTITIES },     // BLOCK_ENTITY_STATE
+            { sizeof(float),        COUNT_ENTITIES },     // BLOCK_ENTITY_POSITION_X
+            { sizeof(float),        COUNT_ENTITIES },     // BLOCK_ENTITY_POSITION_Y
+            { sizeof(float),        COUNT_ENTITIES },     // BLOCK_ENTITY_ORIGIN_X
+            { sizeof(float),        COUNT_ENTITIES },     // BLOCK_ENTITY_ORIGIN_Y
+            { sizeof(float),        COUNT_ENTITIES },     // BLOCK_ENTITY_WIDTH
+            { sizeof(float),        COUNT_ENTITIES },     // BLOCK_ENTITY_HEIGHT
+            { sizeof(int32_t),      COUNT_ENTITIES },     // BLOCK_ENTITY_ATLAS
+            { sizeof(int32_t),      COUNT_ENTITIES },     // BLOCK_ENTITY_SHADER
+            { sizeof(int32_t),      COUNT_ENTITIES },     // BLOCK_ENTITY_BLEND
+            { sizeof(int32_t),      COUNT_ENTITIES },     // BLOCK_ENTITY_PRIMITIVE
+            { sizeof(uint32_t),     COUNT_ENTITIES },     // BLOCK_ENTITY_UID
+            { sizeof(uint32_t),     COUNT_ENTITIES },     // BLOCK_ENTITY_TEXTURE
+            { sizeof(uint32_t),     COUNT_ENTITIES },     // BLOCK_ENTITY_SCRIPT
+            { sizeof(int32_t),      COUNT_ENTITIES },     // BLOCK_ENTITY_PARENT
+            { sizeof(uint32_t),     COUNT_ENTITIES },     // BLOCK_ENTITY_FIRST_VERTEX
+            { sizeof(uint32_t),     COUNT_ENTITIES },     // BLOCK_ENTITY_VERTEX_COUNT
+            { sizeof(uint8_t),      COUNT_ENTITIES },     // BLOCK_ENTITY_HAS_AGENT
+            { sizeof(float),        COUNT_ENTITIES },     // BLOCK_AGENT_VELOCITY_X
+            { sizeof(float),        COUNT_ENTITIES },     // BLOCK_AGENT_VELOCITY_Y
+            { sizeof(float),        COUNT_ENTITIES },     // BLOCK_AGENT_MASS
+            { sizeof(float),        COUNT_ENTITIES },     // BLOCK_AGENT_MAX_VELOCITY
+            { sizeof(float) * 2,    COUNT_VERTICES },     // BLOCK_VERTEX_POSITION
+            { sizeof(float) * 4,    COUNT_VERTICES },     // BLOCK_VERTEX_COLOUR
+            { sizeof(float) * 2,    COUNT_VERTICES },     // BLOCK_VERTEX_TEXCOORD
+            { sizeof(int32_t),      COUNT_ANIMATORS },    // BLOCK_ANIMATOR_ENTITY
+            { sizeof(uint32_t),     COUNT_ANIMATORS },    // BLOCK_ANIMATOR_NAME
+            { sizeof(int32_t),      COUNT_ANIMATORS },    // BLOCK_ANIMATOR_MODE
+            { sizeof(int32_t),      COUNT_ANIMATORS },    // BLOCK_ANIMATOR_DIRECTION
+            { sizeof(int32_t),      COUNT_ANIMATORS },    // BLOCK_ANIMATOR_BEGIN
+            { sizeof(int32_t),      COUNT_ANIMATORS },    // BLOCK_ANIMATOR_END
+            { sizeof(int32_t),      COUNT_ANIMATORS },    // BLOCK_ANIMATOR_FRAME
+            { sizeof(float),        COUNT_ANIMATORS },    // BLOCK_ANIMATOR_ACCUMULATOR
+            { sizeof(uint8_t),      COUNT_ANIMATORS },    // BLOCK_ANIMATOR_FLIPPED
+            { sizeof(uint32_t),     COUNT_ANIMATORS },    // BLOCK_ANIMATOR_DEFAULT_NAME
+            { sizeof(int32_t),      COUNT_ANIMATORS },    // BLOCK_ANIMATOR_DEFAULT_BEGIN
+            { sizeof(int32_t),      COUNT_ANIMATORS },    // BLOCK_ANIMATOR_DEFAULT_END
+        };
+
+        const uint64_t BLOCK_ALIGNMENT = 16;
+
+        uint64_t alignBlock(uint64_t offset)
+        {
+            return (offset + BLOCK_ALIGNMENT - 1) & ~(BLOCK_ALIGNMENT - 1);
+        }
+
+        /// Deduplicating string pool used while capturing
+        class StringPool
+        {
+        public:
+            uint32_t insert(const std::string& string)
+            {
+                auto it = mOffsets.find(string);
+                if (it != mOffsets.end())
+                    return it->second;
+
+                uint32_t offset = static_cast<uint32_t>(mBytes.size());
+                mBytes.insert(mBytes.end(), string.begin(), string.end());
+                mBytes.push_back('\0');
+                mOffsets.emplace(string, offset);
+                return offset;
+            }
+
+            /// Appends a string without pooling, for strings that are expected to be unique
+            uint32_t append(const std::string& string)
+            {
+                uint32_t offset = static_cast<uint32_t>(mBytes.size());
+                mBytes.insert(mBytes.end(), string.begin(), string.end());
+                mBytes.push_back('\0');
+                return offset;
+            }
+
+            std::vector<char>                         mBytes;
+            std::unordered_map<std::string, uint32_t> mOffsets;
+        };
+    }
+
+    SceneSnapshot::SceneSnapshot()
+    {
+        clear();
+    }
+
+    SceneSnapshot::~SceneSnapshot()
+    {
+        clear();
+    }
+
+    bool SceneSnapshot::capture(common::GameScene* gameScene)
+    {
+        if (gameScene == nullptr)
+            return false;
+
+        clear();
+
+        // Gather every Entity, active and pending, in Layer order so each Layer is one run
+        utilities::Span<common::Layer* const> layers = gameScene->getLayers();
+        std::vector<common::Entity*> entities;
+        std::vector<uint32_t> layerFirst(layers.size()), layerCount(layers.size());
+        uint32_t vertexCount = 0;
+
+        for (uint32_t i = 0; i < layers.size(); ++i)
+        {
+            layerFirst[i] = static_cast<uint32_t>(entities.size());
+
+            for (common::Entity* entity : layers[i]->getEntities())
+                entities.push_back(entity);
+            for (common::Entity* entity : layers[i]->getPendingEntities())
+                entities.push_back(entity);
+
+            layerCount[i] = static_cast<uint32_t>(entities.size()) - layerFirst[i];
+        }
+
+        std::unordered_map<const common::Entity*, int32_t> entityIndices;
+        entityIndices.reserve(entities.size());
+        for (uint32_t i = 0; i < entities.size(); ++i)
+        {
+            entityIndices.emplace(entities[i], static_cast<int32_t>(i));
+            vertexCount += static_cast<uint32_t>(entities[i]->getVertices().size());
+        }
+
+        const std::list<animation::Animator*>& animators = gameScene->getAnimators();
+
+        // Strings are pooled first, the pool size decides where the remaining blocks go
+        StringPool strings;
+        std::vector<uint32_t> layerNames(layers.size());
+        std::vector<uint32_t> entityStrings(entities.size() * 3);
+        std::vector<uint32_t> animatorStrings(animators.size() * 2);
+
+        for (uint32_t i = 0; i < layers.size(); ++i)
+            layerNames[i] = strings.insert(gameScene->getLayerName(i));
+
+        for (uint32_t i = 0; i < entities.size(); ++i)
+        {
+            entityStrings[i * 3 + 0] = strings.append(entities[i]->getEntityUID());
+            entityStrings[i * 3 + 1] = strings.insert(entities[i]->mTextureName);
+            entityStrings[i * 3 + 2] = strings.insert(entities[i]->getLuaScript());
+        }
+
+        uint32_t animatorIndex = 0;
+        for (animation::Animator* animator : animators)
+        {
+            animatorStrings[animatorIndex * 2 + 0] = strings.insert(animator->getCurrentAnimation());
+            animatorStrings[animatorIndex * 2 + 1] = strings.insert(animator->getDefaultAnimation());
+            ++animatorIndex;
+        }
+
+        std::memcpy(mHeader.mMagic, "LQSS", 4);
+        mHeader.mVersion = VERSION;
+        mHeader.mLayerCount = static_cast<uint32_t>(layers.size());
+        mHeader.mEntityCount = static_cast<uint32_t>(entities.size());
+        mHeader.mVertexCount = vertexCount;
+        mHeader.mAnimatorCount = static_cast<uint32_t>(animators.size());
+        mHeader.mStringBytes = static_cast<uint32_t>(strings.mBytes.size());
+        mHeader.mReserved = 0;
+
+        // Lay the blocks out exactly as they will be on disk
+        uint64_t offset = alignBlock(sizeof(Header));
+        for (uint32_t block = 0; block < BLOCK_COUNT; ++block)
+        {
+            mHeader.mBlocks[block] = offset;
+            offset = alignBlock(offset + getBlockSize(static_cast<eBlock>(block)));
+        }
+
+        mStorage.assign(offset, 0);
+        std::memcpy(mStorage.data(), &mHeader, sizeof(Header));
+        mData = mStorage.data();
+        for (uint32_t block = 0; block < BLOCK_COUNT; ++block)
+            mBlockPointers[block] = mData + mHeader.mBlocks[block];
+
+        if (!strings.mBytes.empty())
+            std::memcpy(getBlock<char>(BLOCK_STRINGS), strings.mBytes.data(), strings.mBytes.size());
+
+        for (uint32_t i = 0; i < layers.size(); ++i)
+        {
+            getBlock<uint32_t>(BLOCK_LAYER_NAME)[i] = layerNames[i];
+            getBlock<uint32_t>(BLOCK_LAYER_FIRST)[i] = layerFirst[i];
+            getBlock<uint32_t>(BLOCK_LAYER_COUNT)[i] = layerCount[i];
+        }
+
+        int32_t* types = getBlock<int32_t>(BLOCK_ENTITY_TYPE);
+        int32_t* states = getBlock<int32_t>(BLOCK_ENTITY_STATE);
+        float* positionsX = getBlock<float>(BLOCK_ENTITY_POSITION_X);
+        float* positionsY = getBlock<float>(BLOCK_ENTITY_POSITION_Y);
+        float* originsX = getBlock<float>(BLOCK_ENTITY_ORIGIN_X);
+        float* originsY = getBlock<float>(BLOCK_ENTITY_ORIGIN_Y);
+        float* widths = getBlock<float>(BLOCK_ENTITY_WIDTH);
+        float* heights = getBlock<float>(BLOCK_ENTITY_HEIGHT);
+        int32_t* atlases = getBlock<int32_t>(BLOCK_ENTITY_ATLAS);
+        int32_t* shaders = getBlock<int32_t>(BLOCK_ENTITY_SHADER);
+        int32_t* blends = getBlock<int32_t>(BLOCK_ENTITY_BLEND);
+        int32_t* primitives = getBlock<int32_t>(BLOCK_ENTITY_PRIMITIVE);
+        uint32_t* uids = getBlock<uint32_t>(BLOCK_ENTITY_UID);
+        uint32_t* textures = getBlock<uint32_t>(BLOCK_ENTITY_TEXTURE);
+        uint32_t* scripts = getBlock<uint32_t>(BLOCK_ENTITY_SCRIPT);
+        int32_t* parents = getBlock<int32_t>(BLOCK_ENTITY_PARENT);
+        uint32_t* firstVertices = getBlock<uint32_t>(BLOCK_ENTITY_FIRST_VERTEX);
+        uint32_t* vertexCounts = getBlock<uint32_t>(BLOCK_ENTITY_VERTEX_COUNT);
+        uint8_t* hasAgents = getBlock<uint8_t>(BLOCK_ENTITY_HAS_AGENT);
+        float* velocitiesX = getBlock<float>(BLOCK_AGENT_VELOCITY_X);
+        float* velocitiesY = getBlock<float>(BLOCK_AGENT_VELOCITY_Y);
+        float* masses = getBlock<float>(BLOCK_AGENT_MASS);
+        float* maxVelocities = getBlock<float>(BLOCK_AGENT_MAX_VELOCITY);
+        float* vertexPositions = getBlock<float>(BLOCK_VERTEX_POSITION);
+        float* vertexColours = getBlock<float>(BLOCK_VERTEX_COLOUR);
+        float* vertexTexCoords = getBlock<float>(BLOCK_VERTEX_TEXCOORD);
+
+        uint32_t vertexIndex = 0;
+        for (uint32_t i = 0; i < entities.size(); ++i)
+        {
+            common::Entity* entity = entities[i];
+
+            types[i] = entity->getEntityType();
+            states[i] = static_cast<int32_t>(entity->getEntityState());
+            positionsX[i] = entity->getPositionX();
+            positionsY[i] = entity->getPositionY();
+            originsX[i] = entity->getOriginX();
+            originsY[i] = entity->getOriginY();
+            widths[i] = entity->getWidth();
+            heights[i] = entity->getHeight();
+            atlases[i] = entity->mAtlasID;
+            shaders[i] = entity->mShaderID;
+            blends[i] = entity->mBlendMode;
+            primitives[i] = entity->mPrimitiveType;
+            uids[i] = entityStrings[i * 3 + 0];
+            textures[i] = entityStrings[i * 3 + 1];
+            scripts[i] = entityStrings[i * 3 + 2];
+
+            auto parent = entityIndices.find(entity->getParentEntity());
+            parents[i] = parent != entityIndices.end() ? parent->second : -1;
+
+            ai::Agent* agent = entity->getAIAgent();
+            hasAgents[i] = agent != nullptr ? 1 : 0;
+            if (agent != nullptr)
+            {
+                velocitiesX[i] = agent->getVelocityX();
+                velocitiesY[i] = agent->getVelocityY();
+                masses[i] = agent->getMass();
+                maxVelocities[i] = agent->getMaxVelocity();
+            }
+
+            utilities::Span<utilities::Vertex2* const> vertices = entity->getVertices();
+            firstVertices[i] = vertexIndex;
+            vertexCounts[i] = static_cast<uint32_t>(vertices.size());
+
+            for (utilities::Vertex2* vertex : vertices)
+            {
+                std::array<float, 2> position = vertex->getPosition();
+                std::array<float, 4> colour = vertex->getColour();
+                std::array<float, 2> texCoord = vertex->getTexCoord();
+
+                std::memcpy(vertexPositions + vertexIndex * 2, position.data(), sizeof(float) * 2);
+                std::memcpy(vertexColours + vertexIndex * 4, colour.data(), sizeof(float) * 4);
+                std::memcpy(vertexTexCoords + vertexIndex * 2, texCoord.data(), sizeof(float) * 2);
+                ++vertexIndex;
+            }
+        }
+
+        animatorIndex = 0;
+        for (animation::Animator* animator : animators)
+        {
+            auto entity = entityIndices.find(animator->getEntityPtr());
+            uint8_t flipped = (animator->isFlippedX() ? 1 : 0) | (animator->isFlippedY() ? 2 : 0);
+
+            getBlock<int32_t>(BLOCK_ANIMATOR_ENTITY)[animatorIndex] = entity != entityIndices.end() ? entity->second : -1;
+            getBlock<uint32_t>(BLOCK_ANIMATOR_NAME)[animatorIndex] = animatorStrings[animatorIndex * 2 + 0];
+            getBlock<int32_t>(BLOCK_ANIMATOR_MODE)[animatorIndex] = static_cast<int32_t>(animator->getAnimationMode());
+            getBlock<int32_t>(BLOCK_ANIMATOR_DIRECTION)[animatorIndex] = static_cast<int32_t>(animator->getAnimationDirection());
+            getBlock<int32_t>(BLOCK_ANIMATOR_BEGIN)[animatorIndex] = animator->getBeginFrame();
+            getBlock<int32_t>(BLOCK_ANIMATOR_END)[animatorIndex] = animator->getEndFrame();
+            getBlock<int32_t>(BLOCK_ANIMATOR_FRAME)[animatorIndex] = animator->getCurrentFrame();
+            getBlock<float>(BLOCK_ANIMATOR_ACCUMULATOR)[animatorIndex] = animator->getAccumulator();
+            getBlock<uint8_t>(BLOCK_ANIMATOR_FLIPPED)[animatorIndex] = flipped;
+            getBlock<uint32_t>(BLOCK_ANIMATOR_DEFAULT_NAME)[animatorIndex] = animatorStrings[animatorIndex * 2 + 1];
+            getBlock<int32_t>(BLOCK_ANIMATOR_DEFAULT_BEGIN)[animatorIndex] = animator->getDefaultBeginFrame();
+            getBlock<int32_t>(BLOCK_ANIMATOR_DEFAULT_END)[animatorIndex] = animator->getDefaultEndFrame();
+            ++animatorIndex;
+        }
+
+        return true;
+    }
+
+    bool SceneSnapshot::save(std::string file) const
+    {
+        if (isEmpty())
+            return false;
+
+        FILE* output = std::fopen(file.c_str(), "wb");
+        if (output == nullptr)
+            return false;
+
+        uint64_t size = getSize();
+        bool written = std::fwrite(mData, 1, static_cast<size_t>(size), output) == size;
+        return std::fclose(output) == 0 && written;
+    }
+
+    bool SceneSnapshot::load(std::string file)
+    {
+        clear();
+
+        if (!mMappedFile.open(file))
+            return false;
+
+        const uint8_t* data = mMappedFile.getData();
+        uint64_t size = mMappedFile.getSize();
+
+        if (size < sizeof(Header))
+        {
+            mMappedFile.close();
+            return false;
+        }
+
+        std::memcpy(&mHeader, data, sizeof(Header));
+        if (std::memcmp(mHeader.mMagic, "LQSS", 4) != 0 || mHeader.mVersion != VERSION)
+        {
+            clear();
+            return false;
+        }
+
+        // Fix up the block offsets into pointers, rejecting anything outside the file
+        for (uint32_t block = 0; block < BLOCK_COUNT; ++block)
+        {
+            uint64_t offset = mHeader.mBlocks[block];
+            uint64_t blockSize = getBlockSize(static_cast<eBlock>(block));
+
+            if (offset % BLOCK_ALIGNMENT != 0 || offset > size || blockSize > size - offset)
+            {
+                clear();
+                return false;
+            }
+
+            mBlockPointers[block] = data + offset;
+        }
+
+        // Every string offset is trusted after this, so the pool must be terminated
+        if (mHeader.mStringBytes > 0 && getBlock<char>(BLOCK_STRINGS)[mHeader.mStringBytes - 1] != '\0')
+        {
+            clear();
+            return false;
+        }
+
+        // restore() copies every entity's vertices straight out of the vertex blocks
+        const uint32_t* firstVertices = getBlock<uint32_t>(BLOCK_ENTITY_FIRST_VERTEX);
+        const uint32_t* vertexCounts = getBlock<uint32_t>(BLOCK_ENTITY_VERTEX_COUNT);
+        for (uint32_t i = 0; i < mHeader.mEntityCount; ++i)
+        {
+            if (firstVertices[i] > mHeader.mVertexCount || vertexCounts[i] > mHeader.mVertexCount - firstVertices[i])
+            {
+                clear();
+                return false;
+            }
+        }
+
+        mData = data;
+        return true;
+    }
+
+    bool SceneSnapshot::restore(common::GameScene* gameScene) const
+    {
+        if (gameScene == nullptr || isEmpty())
+            return false;
+
+        gameScene->removeAllLayers();
+
+        const int32_t* types = getBlock<int32_t>(BLOCK_ENTITY_TYPE);
+        const int32_t* states = getBlock<int32_t>(BLOCK_ENTITY_STATE);
+        const float* positionsX = getBlock<float>(BLOCK_ENTITY_POSITION_X);
+        const float* positionsY = getBlock<float>(BLOCK_ENTITY_POSITION_Y);
+        const float* originsX = getBlock<float>(BLOCK_ENTITY_ORIGIN_X);
+        const float* originsY = getBlock<float>(BLOCK_ENTITY_ORIGIN_Y);
+        const float* widths = getBlock<float>(BLOCK_ENTITY_WIDTH);
+        const float* heights = getBlock<float>(BLOCK_ENTITY_HEIGHT);
+        const int32_t* atlases = getBlock<int32_t>(BLOCK_ENTITY_ATLAS);
+        const int32_t* shaders = getBlock<int32_t>(BLOCK_ENTITY_SHADER);
+        const int32_t* blends = getBlock<int32_t>(BLOCK_ENTITY_BLEND);
+        const int32_t* primitives = getBlock<int32_t>(BLOCK_ENTITY_PRIMITIVE);
+        const uint32_t* uids = getBlock<uint32_t>(BLOCK_ENTITY_UID);
+        const uint32_t* textures = getBlock<uint32_t>(BLOCK_ENTITY_TEXTURE);
+        const uint32_t* scripts = getBlock<uint32_t>(BLOCK_ENTITY_SCRIPT);
+        const int32_t* parents = getBlock<int32_t>(BLOCK_ENTITY_PARENT);
+        const uint32_t* firstVertices = getBlock<uint32_t>(BLOCK_ENTITY_FIRST_VERTEX);
+        const uint32_t* vertexCounts = getBlock<uint32_t>(BLOCK_ENTITY_VERTEX_COUNT);
+        const uint8_t* hasAgents = getBlock<uint8_t>(BLOCK_ENTITY_HAS_AGENT);
+        const float* velocitiesX = getBlock<float>(BLOCK_AGENT_VELOCITY_X);
+        const float* velocitiesY = getBlock<float>(BLOCK_AGENT_VELOCITY_Y);
+        const float* masses = getBlock<float>(BLOCK_AGENT_MASS);
+        const float* maxVelocities = getBlock<float>(BLOCK_AGENT_MAX_VELOCITY);
+        const float* vertexPositions = getBlock<float>(BLOCK_VERTEX_POSITION);
+        const float* vertexColours = getBlock<float>(BLOCK_VERTEX_COLOUR);
+        const float* vertexTexCoords = getBlock<float>(BLOCK_VERTEX_TEXCOORD);
+
+        std::vector<common::Entity*> entities(mHeader.mEntityCount);
+        for (uint32_t i = 0; i < mHeader.mEntityCount; ++i)
+        {
+            common::Entity* entity = new common::Entity();
+            entities[i] = entity;
+
+            entity->setEntityType(types[i]);
+            entity->setEntityState(static_cast<common::Entity::eEntityState>(states[i]));
+            entity->restoreTransform(positionsX[i], positionsY[i], originsX[i], originsY[i], widths[i], heights[i]);
+            entity->mAtlasID = atlases[i];
+            entity->mShaderID = shaders[i];
+            entity->mBlendMode = blends[i];
+            entity->mPrimitiveType = primitives[i];
+            entity->mTextureName = getString(textures[i]);
+            entity->setEntityUID(getString(uids[i]));
+
+            const char* script = getString(scripts[i]);
+            if (script[0] != '\0')
+                entity->setLuaScript(script);
+
+            if (hasAgents[i] != 0)
+            {
+                entity->createAIAgent();
+                ai::Agent* agent = entity->getAIAgent();
+                agent->setVelocityX(velocitiesX[i]);
+                agent->setVelocityY(velocitiesY[i]);
+                agent->setMass(masses[i]);
+                agent->setMaxVelocity(maxVelocities[i]);
+            }
+
+            uint32_t count = vertexCounts[i];
+            if (entity->getVerticesCount() != count)
+            {
+                entity->clearVertices();
+                for (uint32_t v = 0; v < count; ++v)
+                    entity->addVertex2(new utilities::Vertex2());
+            }
+        }
+
+        // Positions were saved after parenting, so links must not offset them again
+        for (uint32_t i = 0; i < mHeader.mEntityCount; ++i)
+        {
+            if (parents[i] >= 0 && static_cast<uint32_t>(parents[i]) < mHeader.mEntityCount)
+                entities[i]->setParentEntity(entities[parents[i]], false);
+        }
+
+        uint32_t animatorIndex = 0;
+        for (animation::Animator* animator : gameScene->getAnimators())
+        {
+            if (animatorIndex >= mHeader.mAnimatorCount)
+                break;
+
+            int32_t entity = getBlock<int32_t>(BLOCK_ANIMATOR_ENTITY)[animatorIndex];
+            uint8_t flipped = getBlock<uint8_t>(BLOCK_ANIMATOR_FLIPPED)[animatorIndex];
+
+            common::Entity* entityPtr = nullptr;
+            if (entity >= 0 && static_cast<uint32_t>(entity) < mHeader.mEntityCount)
+                entityPtr = entities[entity];
+
+            animator->transformAnimationDefault(getString(getBlock<uint32_t>(BLOCK_ANIMATOR_DEFAULT_NAME)[animatorIndex]),
+                                                getBlock<int32_t>(BLOCK_ANIMATOR_DEFAULT_BEGIN)[animatorIndex],
+                                                getBlock<int32_t>(BLOCK_ANIMATOR_DEFAULT_END)[animatorIndex]);
+            animator->setFlippedX((flipped & 1) != 0);
+            animator->setFlippedY((flipped & 2) != 0);
+            animator->restoreState(entityPtr, getString(getBlock<uint32_t>(BLOCK_ANIMATOR_NAME)[animatorIndex]),
+                                   static_cast<animation::Animator::eAnimationMode>(getBlock<int32_t>(BLOCK_ANIMATOR_MODE)[animatorIndex]),
+                                   static_cast<animation::Animator::eAnimationDirection>(getBlock<int32_t>(BLOCK_ANIMATOR_DIRECTION)[animatorIndex]),
+                                   getBlock<int32_t>(BLOCK_ANIMATOR_BEGIN)[animatorIndex],
+                                   getBlock<int32_t>(BLOCK_ANIMATOR_END)[animatorIndex],
+                                   getBlock<int32_t>(BLOCK_ANIMATOR_FRAME)[animatorIndex],
+                                   getBlock<float>(BLOCK_ANIMATOR_ACCUMULATOR)[animatorIndex]);
+            ++animatorIndex;
+        }
+
+        // Vertices are written last and exactly as saved, so nothing above can rebuild them
+        for (uint32_t i = 0; i < mHeader.mEntityCount; ++i)
+        {
+            uint32_t vertexIndex = firstVertices[i];
+            for (utilities::Vertex2* vertex : entities[i]->getVertices())
+            {
+                vertex->setPosition(vertexPositions[vertexIndex * 2], vertexPositions[vertexIndex * 2 + 1]);
+                vertex->setColour(vertexColours[vertexIndex * 4], vertexColours[vertexIndex * 4 + 1],
+                                  vertexColours[vertexIndex * 4 + 2], vertexColours[vertexIndex * 4 + 3]);
+                vertex->setTexCoord(vertexTexCoords[vertexIndex * 2], vertexTexCoords[vertexIndex * 2 + 1]);
+                ++vertexIndex;
+            }
+        }
+
+        for (uint32_t i = 0; i < mHeader.mLayerCount; ++i)
+        {
+            uint32_t first = getBlock<uint32_t>(BLOCK_LAYER_FIRST)[i];
+            uint32_t count = getBlock<uint32_t>(BLOCK_LAYER_COUNT)[i];
+
+            common::Layer* layer = new common::Layer(gameScene);
+            gameScene->insertLayer(getString(getBlock<uint32_t>(BLOCK_LAYER_NAME)[i]), layer);
+
+            if (first <= mHeader.mEntityCount && count <= mHeader.mEntityCount - first)
+                layer->insertEntity(std::vector<common::Entity*>(entities.begin() + first, entities.begin() + first + count));
+        }
+
+        return true;
+    }
+
+    void SceneSnapshot::clear()
+    {
+        std::memset(&mHeader, 0, sizeof(Header));
+        std::memset(mBlockPointers, 0, sizeof(mBlockPointers));
+        mData = nullptr;
+        mStorage.clear();
+        mStorage.shrink_to_fit();
+        mMappedFile.close();
+    }
+
+    bool SceneSnapshot::equals(const SceneSnapshot& other) const
+    {
+        if (mHeader.mLayerCount != other.mHeader.mLayerCount ||
+            mHeader.mEntityCount != other.mHeader.mEntityCount ||
+            mHeader.mVertexCount != other.mHeader.mVertexCount ||
+            mHeader.mAnimatorCount != other.mHeader.mAnimatorCount ||
+            mHeader.mStringBytes != other.mHeader.mStringBytes)
+            return false;
+
+        for (uint32_t block = 0; block < BLOCK_COUNT; ++block)
+        {
+            uint64_t size = getBlockSize(static_cast<eBlock>(block));
+            if (size > 0 && std::memcmp(mBlockPointers[block], other.mBlockPointers[block], static_cast<size_t>(size)) != 0)
+                return false;
+        }
+
+        return true;
+    }
+
+    const bool SceneSnapshot::isEmpty() const
+    {
+        return mData == nullptr;
+    }
+
+    const uint32_t SceneSnapshot::getLayerCount() const
+    {
+        return mHeader.mLayerCount;
+    }
+
+    const uint32_t SceneSnapshot::getEntityCount() const
+    {
+        return mHeader.mEntityCount;
+    }
+
+    const uint32_t SceneSnapshot::getVertexCount() const
+    {
+        return mHeader.mVertexCount;
+    }
+
+    const uint32_t SceneSnapshot::getAnimatorCount() const
+    {
+        return mHeader.mAnimatorCount;
+    }
+
+    const uint64_t SceneSnapshot::getSize() const
+    {
+        if (isEmpty())
+            return 0;
+
+        return alignBlock(mHeader.mBlocks[BLOCK_COUNT - 1] + getBlockSize(static_cast<eBlock>(BLOCK_COUNT - 1)));
+    }
+
+    uint64_t SceneSnapshot::getBlockSize(eBlock block) const
+    {
+        uint64_t count = 0;
+        switch (BLOCK_LAYOUT[block].mCount)
+        {
+        case COUNT_STRING_BYTES: count = mHeader.mStringBytes;   break;
+        case COUNT_LAYERS:       count = mHeader.mLayerCount;    break;
+        case COUNT_ENTITIES:     count = mHeader.mEntityCount;   break;
+        case COUNT_VERTICES:     count = mHeader.mVertexCount;   break;
+        case COUNT_ANIMATORS:    count = mHeader.mAnimatorCount; break;
+        }
+
+        return count * BLOCK_LAYOUT[block].mStride;
+    }
+
+    const char* SceneSnapshot::getString(uint32_t offset) const
+    {
+        if (offset >= mHeader.mStringBytes)
+            return "";
+
+        return getBlock<char>(BLOCK_STRINGS) + offset;
+    }
+
+}}
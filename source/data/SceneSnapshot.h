@@ -0,0 +1,203 @@
+#include "../utilities/MappedFile.h"
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace liquid {
+namespace common { class GameScene; }
+namespace data {
+#ifndef _SCENESNAPSHOT_H
+#define _SCENESNAPSHOT_H
+
+/**
+ * \class SceneSnapshot
+ *
+ * \ingroup Data
+ * \brief Versioned binary save and restore of a GameScene
+ *
+ * The scene is flattened into structure-of-arrays blocks, one block per field
+ * (all X positions, then all Y positions and so on), every block starting on a
+ * 16 byte boundary. Strings are held in one pool and referenced by offset, shared
+ * ones such as texture names stored once while unique IDs are appended without a
+ * lookup; parents and animators reference entities by index. A snapshot file is the header followed by
+ * the blocks exactly as they are held in memory, so saving is a single write and
+ * loading maps the file and resolves the block offsets of the header into pointers,
+ * nothing is parsed or copied until restore() builds the scene.
+ *
+ * Entities are restored as common::Entity with their transform, state, render
+ * properties, vertices, script and ai::Agent values. Animation tables are content
+ * and are not stored, only the playback state of each Animator is, which is applied
+ * in order to the Animators the scene already owns.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class SceneSnapshot
+{
+public:
+    /// Identifies each structure-of-arrays block in a snapshot
+    enum eBlock
+    {
+        BLOCK_STRINGS = 0,
+        BLOCK_LAYER_NAME,
+        BLOCK_LAYER_FIRST,
+        BLOCK_LAYER_COUNT,
+        BLOCK_ENTITY_TYPE,
+        BLOCK_ENTITY_STATE,
+        BLOCK_ENTITY_POSITION_X,
+        BLOCK_ENTITY_POSITION_Y,
+        BLOCK_ENTITY_ORIGIN_X,
+        BLOCK_ENTITY_ORIGIN_Y,
+        BLOCK_ENTITY_WIDTH,
+        BLOCK_ENTITY_HEIGHT,
+        BLOCK_ENTITY_ATLAS,
+        BLOCK_ENTITY_SHADER,
+        BLOCK_ENTITY_BLEND,
+        BLOCK_ENTITY_PRIMITIVE,
+        BLOCK_ENTITY_UID,
+        BLOCK_ENTITY_TEXTURE,
+        BLOCK_ENTITY_SCRIPT,
+        BLOCK_ENTITY_PARENT,
+        BLOCK_ENTITY_FIRST_VERTEX,
+        BLOCK_ENTITY_VERTEX_COUNT,
+        BLOCK_ENTITY_HAS_AGENT,
+        BLOCK_AGENT_VELOCITY_X,
+        BLOCK_AGENT_VELOCITY_Y,
+        BLOCK_AGENT_MASS,
+        BLOCK_AGENT_MAX_VELOCITY,
+        BLOCK_VERTEX_POSITION,
+        BLOCK_VERTEX_COLOUR,
+        BLOCK_VERTEX_TEXCOORD,
+        BLOCK_ANIMATOR_ENTITY,
+        BLOCK_ANIMATOR_NAME,
+        BLOCK_ANIMATOR_MODE,
+        BLOCK_ANIMATOR_DIRECTION,
+        BLOCK_ANIMATOR_BEGIN,
+        BLOCK_ANIMATOR_END,
+        BLOCK_ANIMATOR_FRAME,
+        BLOCK_ANIMATOR_ACCUMULATOR,
+        BLOCK_ANIMATOR_FLIPPED,
+        BLOCK_ANIMATOR_DEFAULT_NAME,
+        BLOCK_ANIMATOR_DEFAULT_BEGIN,
+        BLOCK_ANIMATOR_DEFAULT_END,
+        BLOCK_COUNT,
+    };
+
+    /// Fixed size header at the start of every snapshot file
+    struct Header
+    {
+        char     mMagic[4];             ///< Always "LQSS"
+        uint32_t mVersion;              ///< Format version the file was written with
+        uint32_t mLayerCount;           ///< Number of Layers
+        uint32_t mEntityCount;          ///< Number of Entities across all Layers
+        uint32_t mVertexCount;          ///< Number of vertices across all Entities
+        uint32_t mAnimatorCount;        ///< Number of Animators
+        uint32_t mStringBytes;          ///< Size of the string pool in bytes
+        uint32_t mReserved;             ///< Unused, keeps the block table 8 byte aligned
+        uint64_t mBlocks[BLOCK_COUNT];  ///< Byte offset of each block from the start of the file
+    };
+
+    /// Current version of the snapshot format
+    static const uint32_t VERSION = 1;
+
+public:
+    /// SceneSnapshot Constructor
+    SceneSnapshot();
+
+    /// SceneSnapshot Destructor
+    ~SceneSnapshot();
+
+    /** \brief Flattens the current state of a GameScene into this snapshot
+      * \param gameScene Scene to capture
+      * \return True if captured, False if gameScene is null
+      */
+    bool capture(common::GameScene* gameScene);
+
+    /** \brief Writes the snapshot to disk
+      * \param file Path of the file to write
+      * \return True if the file was written
+      */
+    bool save(std::string file) const;
+
+    /** \brief Maps a snapshot file from disk
+      * \param file Path of the file to load
+      * \return True if the file was mapped and is a valid snapshot of this version
+      */
+    bool load(std::string file);
+
+    /** \brief Rebuilds a GameScene from this snapshot
+      * \param gameScene Scene to restore into, its current Layers and Entities are deleted
+      * \return True if restored, False if empty or gameScene is null
+      *
+      * Restored Entities are inserted as pending, so they become active on the next
+      * update of the scene like any other inserted Entity.
+      */
+    bool restore(common::GameScene* gameScene) const;
+
+    /// \brief Releases the captured or mapped data
+    void clear();
+
+    /** \brief Compares the contents of two snapshots
+      * \param other Snapshot to compare against
+      * \return True if both hold identical scene data
+      */
+    bool equals(const SceneSnapshot& other) const;
+
+    /// \return True if nothing has been captured or loaded
+    const bool isEmpty() const;
+
+    /// \return Number of Layers in the snapshot
+    const uint32_t getLayerCount() const;
+
+    /// \return Number of Entities in the snapshot
+    const uint32_t getEntityCount() const;
+
+    /// \return Number of vertices in the snapshot
+    const uint32_t getVertexCount() const;
+
+    /// \return Number of Animators in the snapshot
+    const uint32_t getAnimatorCount() const;
+
+    /// \return Size in bytes of the snapshot, including the header
+    const uint64_t getSize() const;
+
+protected:
+    /** \brief Size in bytes of a block given the current header counts
+      * \param block Block to size
+      * \return Unpadded size of the block
+      */
+    uint64_t getBlockSize(eBlock block) const;
+
+    /** \brief Typed access to a block
+      * \param block Block to access
+      * \return Pointer to the first element of the block
+      */
+    template <typename T>
+    T* getBlock(eBlock block) const
+    {
+        return reinterpret_cast<T*>(const_cast<uint8_t*>(mBlockPointers[block]));
+    }
+
+    /** \brief Resolves a string pool offset
+      * \param offset Offset into the string pool
+      * \return The pooled string
+      */
+    const char* getString(uint32_t offset) const;
+
+private:
+    SceneSnapshot(const SceneSnapshot&);
+    SceneSnapshot& operator=(const SceneSnapshot&);
+
+protected:
+    Header                mHeader;                     ///< Counts and block offsets of the snapshot
+    const uint8_t*        mData;                       ///< Start of the snapshot, captured storage or the mapping
+    const uint8_t*        mBlockPointers[BLOCK_COUNT]; ///< Block offsets resolved into pointers
+    std::vector<uint8_t>  mStorage;                    ///< Backing memory of a captured snapshot
+    utilities::MappedFile mMappedFile;                 ///< Backing memory of a loaded snapshot
+};
+
+#endif // _SCENESNAPSHOT_H
+}}
@@ -8,6 +8,8 @@ namespace data {
         mDefaultSettings =
             "-- GAME SETTINGS\n"
             "frame_limit 60\n"
+            "tick_rate 60\n"
+            "max_ticks_per_frame 5\n"
             "screen_width 1920\n"
             "screen_height 1080\n"
             "fullscreen false\n"
@@ -49,6 +51,16 @@ namespace data {
         return mFrameLimit;
     }
 
+    int32_t Settings::getTickRate() const
+    {
+        return mTickRate;
+    }
+
+    int32_t Settings::getMaxTicksPerFrame() const
+    {
+        return mMaxTicksPerFrame;
+    }
+
     int32_t Settings::getScreenWidth() const
     {
         return mScreenWidth;
@@ -102,6 +114,8 @@ namespace data {
     void Settings::assignSettings()
     {
         mFrameLimit = mRootParserNode->getValueAsInteger32("frame_limit");
+        mTickRate = mRootParserNode->getValueAsInteger32("tick_rate");
+        mMaxTicksPerFrame = mRootParserNode->getValueAsInteger32("max_ticks_per_frame");
         mScreenWidth = mRootParserNode->getValueAsInteger32("screen_width");
         mScreenHeight = mRootParserNode->getValueAsInteger32("screen_height");
         mFullscreen = mRootParserNode->getValueAsBoolean("fullscreen");
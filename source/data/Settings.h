@@ -56,6 +56,12 @@ public:
     /// \return Frame Limit capped to represented Integer
     int32_t getFrameLimit() const;
 
+    /// \return Fixed simulation ticks per second, 0 for variable stepping
+    int32_t getTickRate() const;
+
+    /// \return Maximum simulation ticks run in a single frame when catching up
+    int32_t getMaxTicksPerFrame() const;
+
     /// \return The width of the screen in pixels (integer)
     int32_t getScreenWidth() const;
 
@@ -91,6 +97,8 @@ private:
 
 protected:
     int32_t mFrameLimit;       ///< Framerate limit
+    int32_t mTickRate;         ///< Fixed simulation ticks per second
+    int32_t mMaxTicksPerFrame; ///< Cap on catch-up ticks per frame
     int32_t mScreenWidth;      ///< Width of screen in pixels
     int32_t mScreenHeight;     ///< Height of screen in pixels
     bool    mFullscreen;       ///< Flag denoting if fullscreen or not
@@ -9,6 +9,11 @@ namespace data {
         compile();
     }
 
+    TextureAtlas::TextureAtlas(std::string texturePath)
+    {
+        mTexPath = texturePath;
+    }
+
     TextureAtlas::~TextureAtlas()
     {}
 
@@ -27,12 +32,7 @@ namespace data {
             float coord3 = node->getChildNode("coord3")->getValueAsFloat("coord3");
             float coord4 = node->getChildNode("coord4")->getValueAsFloat("coord4");
 
-            TextureCoord texCoord1 = { coord1, coord2 };
-            TextureCoord texCoord2 = { coord1 + coord3, coord2 };
-            TextureCoord texCoord3 = { coord1 + coord3, coord2 + coord4 };
-            TextureCoord texCoord4 = { coord1, coord2 + coord4 };
-
-            mTextureAtlas[name] = { texCoord1, texCoord2, texCoord3, texCoord4 };
+            addTextureRegion(name, coord1, coord2, coord3, coord4);
         }
     }
 
@@ -46,6 +46,16 @@ namespace data {
         mParser = parser;
     }
 
+    void TextureAtlas::addTextureRegion(std::string name, float x, float y, float w, float h)
+    {
+        TextureCoord texCoord1 = { x, y };
+        TextureCoord texCoord2 = { x + w, y };
+        TextureCoord texCoord3 = { x + w, y + h };
+        TextureCoord texCoord4 = { x, y + h };
+
+        mTextureAtlas[name] = { texCoord1, texCoord2, texCoord3, texCoord4 };
+    }
+
     TextureAtlas::TextureRegion TextureAtlas::getTextureRegion(std::string name)
     {
         if (mTextureAtlas.find(name) != mTextureAtlas.end())
@@ -34,6 +34,11 @@ public:
       */
     TextureAtlas(parser::Parser& parser);
 
+    /** \brief TextureAtlas Constructor for atlases built at runtime, see AtlasPacker
+      * \param texturePath Path of the texture, regions are added with addTextureRegion()
+      */
+    TextureAtlas(std::string texturePath);
+
     /// TextureAtlas Destructor
     ~TextureAtlas();
     
@@ -48,6 +53,15 @@ public:
       */
     void setParser(parser::Parser& parser);
 
+    /** \brief Adds or replaces a rectangular region
+      * \param name Name of the region
+      * \param x Left edge in pixels
+      * \param y Top edge in pixels
+      * \param w Width in pixels
+      * \param h Height in pixels
+      */
+    void addTextureRegion(std::string name, float x, float y, float w, float h);
+
     /** \brief Find the TextureRegion for the given name
       * \param name Name of the region to find
       * \return Found region, if none found will return {}
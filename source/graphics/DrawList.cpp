@@ -0,0 +1,192 @@
+#include "DrawList.h"
+
+namespace liquid {
+namespace graphics {
+
+    namespace
+    {
+        /// Render state of a key in the layout of makeKey(), whichever function built it
+        uint64_t getStateBits(uint64_t key)
+        {
+            if (DrawList::isDepthKey(key))
+                return (key & 0xFFFFFFFFull) << DrawList::DEPTH_BITS;
+
+            return key;
+        }
+    }
+
+    DrawList::DrawList()
+    {
+        mVertexCount = 0;
+    }
+
+    DrawList::~DrawList()
+    {}
+
+    uint64_t DrawList::makeKey(uint32_t layer, int32_t shaderID, int32_t atlasID, 
+                               int32_t blendMode, int32_t primitiveType, uint32_t depth)
+    {
+        // IDs of -1 (none) become 0 so they sort before any real resource
+        return (static_cast<uint64_t>(layer & 0x7F) << 57) |
+               (static_cast<uint64_t>((shaderID + 1) & 0xFF) << 48) |
+               (static_cast<uint64_t>((atlasID + 1) & 0xFFFF) << 32) |
+               (static_cast<uint64_t>(blendMode & 0xF) << 28) |
+               (static_cast<uint64_t>(primitiveType & 0xF) << 24) |
+               (static_cast<uint64_t>(depth) & ((1ull << DEPTH_BITS) - 1));
+    }
+
+    uint64_t DrawList::makeDepthKey(uint32_t layer, uint32_t depth, int32_t shaderID, int32_t atlasID,
+                                    int32_t blendMode, int32_t primitiveType)
+    {
+        // The state keeps its place relative to the low bits, so the decoders only shift it down
+        uint64_t state = makeKey(0, shaderID, atlasID, blendMode, primitiveType) >> DEPTH_BITS;
+        return (static_cast<uint64_t>(layer & 0x7F) << 57) | (1ull << 56) |
+               ((static_cast<uint64_t>(depth) & ((1ull << DEPTH_BITS) - 1)) << 32) | state;
+    }
+
+    bool DrawList::isDepthKey(uint64_t key)
+    {
+        return ((key >> 56) & 1) != 0;
+    }
+
+    uint64_t DrawList::getStateKey(uint64_t key)
+    {
+        if (isDepthKey(key))
+            return key & ~(((1ull << DEPTH_BITS) - 1) << 32);
+
+        return key & ~((1ull << DEPTH_BITS) - 1);
+    }
+
+    uint32_t DrawList::getLayer(uint64_t key)
+    {
+        return static_cast<uint32_t>(key >> 57);
+    }
+
+    int32_t DrawList::getShaderID(uint64_t key)
+    {
+        return static_cast<int32_t>((getStateBits(key) >> 48) & 0xFF) - 1;
+    }
+
+    int32_t DrawList::getAtlasID(uint64_t key)
+    {
+        return static_cast<int32_t>((getStateBits(key) >> 32) & 0xFFFF) - 1;
+    }
+
+    int32_t DrawList::getBlendMode(uint64_t key)
+    {
+        return static_cast<int32_t>((getStateBits(key) >> 28) & 0xF);
+    }
+
+    int32_t DrawList::getPrimitiveType(uint64_t key)
+    {
+        return static_cast<int32_t>((getStateBits(key) >> 24) & 0xF);
+    }
+
+    void DrawList::clear()
+    {
+        mItems.clear();
+        mDrawCalls.clear();
+        mChunkVertices.clear();
+        mVertexCount = 0;
+    }
+
+    void DrawList::insert(uint64_t key, uint32_t firstVertex, uint32_t vertexCount)
+    {
+        Item item;
+        item.mKey = key;
+        item.mFirstVertex = firstVertex;
+        item.mVertexCount = vertexCount;
+
+        mItems.push_back(item);
+        mVertexCount += vertexCount;
+    }
+
+    void DrawList::sort()
+    {
+        mDrawCalls.clear();
+        mChunkVertices.clear();
+        if (mItems.empty())
+            return;
+
+        // Scenes that did not change their order since the last frame skip the sort
+        bool ordered = true;
+        for (uint32_t i = 1; i < mItems.size() && ordered; i++)
+            ordered = mItems[i - 1].mKey <= mItems[i].mKey;
+
+        // Least significant byte first, each pass is a stable counting sort
+        mScratch.resize(mItems.size());
+        uint32_t counts[256];
+
+        for (uint32_t pass = 0; pass < 8 && ordered == false; pass++)
+        {
+            uint32_t shift = pass * 8;
+            std::fill(counts, counts + 256, 0);
+
+            for (const Item& item : mItems)
+                counts[(item.mKey >> shift) & 0xFF]++;
+
+            // Every key shares this byte, the pass would not move anything
+            if (counts[(mItems[0].mKey >> shift) & 0xFF] == mItems.size())
+                continue;
+
+            uint32_t offset = 0;
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                uint32_t count = counts[i];
+                counts[i] = offset;
+                offset += count;
+            }
+
+            for (const Item& item : mItems)
+                mScratch[counts[(item.mKey >> shift) & 0xFF]++] = item;
+
+            mItems.swap(mScratch);
+        }
+
+        // Coalesce runs that only differ in depth, for depth keys these are neighbours in depth order
+        uint32_t vertex = 0;
+        for (uint32_t i = 0; i < mItems.size(); i++)
+        {
+            const Item& item = mItems[i];
+
+            if (i % GATHER_CHUNK_SIZE == 0)
+                mChunkVertices.push_back(vertex);
+
+            if (mDrawCalls.empty() || getStateKey(mDrawCalls.back().mKey) != getStateKey(item.mKey))
+            {
+                DrawCall drawCall;
+                drawCall.mKey = item.mKey;
+                drawCall.mFirstItem = i;
+                drawCall.mItemCount = 0;
+                drawCall.mFirstVertex = vertex;
+                drawCall.mVertexCount = 0;
+                mDrawCalls.push_back(drawCall);
+            }
+
+            mDrawCalls.back().mItemCount++;
+            mDrawCalls.back().mVertexCount += item.mVertexCount;
+            vertex += item.mVertexCount;
+        }
+    }
+
+    const uint32_t DrawList::getGatherChunkCount() const
+    {
+        return static_cast<uint32_t>(mChunkVertices.size());
+    }
+
+    const std::vector<DrawList::Item>& DrawList::getItems() const
+    {
+        return mItems;
+    }
+
+    const std::vector<DrawList::DrawCall>& DrawList::getDrawCalls() const
+    {
+        return mDrawCalls;
+    }
+
+    const uint32_t DrawList::getVertexCount() const
+    {
+        return mVertexCount;
+    }
+
+}}
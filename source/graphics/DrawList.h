@@ -0,0 +1,182 @@
+#include <vector>
+#include <algorithm>
+#include <stdint.h>
+
+namespace liquid { namespace graphics {
+#ifndef _DRAWLIST_H
+#define _DRAWLIST_H
+
+/**
+ * \class DrawList
+ *
+ * \ingroup Graphics
+ * \brief Flat list of sort-keyed vertex ranges that are radix sorted into draw calls
+ *
+ * Every visible sprite emits one 64-bit key packing the render state it needs,
+ * most significant first: layer (7 bits), a layout flag (1), shader (8), atlas (16),
+ * blend mode (4), primitive type (4) and an optional depth (24). Sorting the keys
+ * puts everything that can share a draw call next to each other, in layer order, so
+ * coalescing is a single pass instead of searching the existing batches for every
+ * sprite.
+ *
+ * Depth sorted layers use makeDepthKey() instead, which sets the layout flag and
+ * moves the depth in front of the render state. Their sprites are drawn strictly
+ * by depth, while sprites of equal depth are still grouped by state and neighbours
+ * sharing a state still coalesce into one draw call.
+ *
+ * The sort is a stable least significant digit radix sort, so sprites with equal
+ * keys keep the order they were inserted in.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class DrawList
+{
+public:
+    /// A range of source vertices drawn with one render state
+    struct Item
+    {
+        uint64_t mKey;         ///< Sort key built by makeKey()
+        uint32_t mFirstVertex; ///< Index of the first vertex in the caller's vertex array
+        uint32_t mVertexCount; ///< Number of vertices in the range
+    };
+
+    /// Consecutive sorted Items that share a render state
+    struct DrawCall
+    {
+        uint64_t mKey;         ///< Key of the first Item, depth bits included
+        uint32_t mFirstItem;   ///< Index of the first sorted Item
+        uint32_t mItemCount;   ///< Number of Items drawn together
+        uint32_t mFirstVertex; ///< Index of the first vertex once gathered in sorted order
+        uint32_t mVertexCount; ///< Number of vertices drawn
+    };
+
+    /// Number of low key bits holding depth, ignored when coalescing
+    static const uint32_t DEPTH_BITS = 24;
+
+    /// Number of sorted Items gathered by each gather chunk
+    static const uint32_t GATHER_CHUNK_SIZE = 1024;
+
+public:
+    /// DrawList Constructor
+    DrawList();
+
+    /// DrawList Destructor
+    ~DrawList();
+
+    /** \brief Packs a render state into a sort key
+      * \param layer Index of the Layer, 0 - 127
+      * \param shaderID Shader, -1 for none, up to 254
+      * \param atlasID Texture atlas, -1 for none, up to 65534
+      * \param blendMode Blend mode, 0 - 15
+      * \param primitiveType Primitive type, 0 - 15
+      * \param depth Optional depth within the state, 0 - 16777215
+      * \return The sort key
+      */
+    static uint64_t makeKey(uint32_t layer, int32_t shaderID, int32_t atlasID, 
+                            int32_t blendMode, int32_t primitiveType, uint32_t depth = 0);
+
+    /** \brief Packs a render state into a sort key that orders by depth first
+      * \param layer Index of the Layer, 0 - 127
+      * \param depth Depth within the Layer, 0 - 16777215, lower is drawn first
+      * \param shaderID Shader, -1 for none, up to 254
+      * \param atlasID Texture atlas, -1 for none, up to 65534
+      * \param blendMode Blend mode, 0 - 15
+      * \param primitiveType Primitive type, 0 - 15
+      * \return The sort key
+      */
+    static uint64_t makeDepthKey(uint32_t layer, uint32_t depth, int32_t shaderID, int32_t atlasID,
+                                 int32_t blendMode, int32_t primitiveType);
+
+    /// \return True if a key was built by makeDepthKey()
+    static bool isDepthKey(uint64_t key);
+
+    /// \return A key without its depth, equal for keys that can share a draw call
+    static uint64_t getStateKey(uint64_t key);
+
+    /// \return Layer index packed in a key
+    static uint32_t getLayer(uint64_t key);
+
+    /// \return Shader ID packed in a key
+    static int32_t getShaderID(uint64_t key);
+
+    /// \return Atlas ID packed in a key
+    static int32_t getAtlasID(uint64_t key);
+
+    /// \return Blend mode packed in a key
+    static int32_t getBlendMode(uint64_t key);
+
+    /// \return Primitive type packed in a key
+    static int32_t getPrimitiveType(uint64_t key);
+
+    /// \brief Empties the list, keeping its memory for the next frame
+    void clear();
+
+    /** \brief Adds a range of vertices to be drawn
+      * \param key Sort key built by makeKey()
+      * \param firstVertex Index of the first vertex in the caller's vertex array
+      * \param vertexCount Number of vertices in the range
+      */
+    void insert(uint64_t key, uint32_t firstVertex, uint32_t vertexCount);
+
+    /// \brief Radix sorts the Items by key and coalesces them into DrawCalls
+    void sort();
+
+    /** \brief Copies the source vertices into one contiguous array in draw order
+      * \param source Vertex array the Items index into
+      * \param destination Array of at least getVertexCount() vertices
+      */
+    template <typename T>
+    void gather(const T* source, T* destination) const
+    {
+        for (const Item& item : mItems)
+        {
+            for (uint32_t v = 0; v < item.mVertexCount; v++)
+                *destination++ = source[item.mFirstVertex + v];
+        }
+    }
+
+    /** \brief Gathers one chunk of sorted Items, chunks can be gathered in parallel
+      * \param source Vertex array the Items index into
+      * \param destination Array of at least getVertexCount() vertices
+      * \param chunk Index of the chunk, below getGatherChunkCount()
+      */
+    template <typename T>
+    void gather(const T* source, T* destination, uint32_t chunk) const
+    {
+        uint32_t first = chunk * GATHER_CHUNK_SIZE;
+        uint32_t last = std::min(first + GATHER_CHUNK_SIZE, static_cast<uint32_t>(mItems.size()));
+        destination += mChunkVertices[chunk];
+
+        for (uint32_t i = first; i < last; i++)
+        {
+            for (uint32_t v = 0; v < mItems[i].mVertexCount; v++)
+                *destination++ = source[mItems[i].mFirstVertex + v];
+        }
+    }
+
+    /// \return Number of chunks gather() can be split into
+    const uint32_t getGatherChunkCount() const;
+
+    /// \return Items, sorted once sort() has been called
+    const std::vector<Item>& getItems() const;
+
+    /// \return DrawCalls built by the last sort()
+    const std::vector<DrawCall>& getDrawCalls() const;
+
+    /// \return Total number of vertices across all Items
+    const uint32_t getVertexCount() const;
+
+protected:
+    std::vector<Item>     mItems;         ///< Items in insertion order, then sorted
+    std::vector<Item>     mScratch;       ///< Second buffer the radix sort ping-pongs with
+    std::vector<DrawCall> mDrawCalls;     ///< Draw calls built by sort()
+    std::vector<uint32_t> mChunkVertices; ///< First gathered vertex of every gather chunk
+    uint32_t              mVertexCount;   ///< Total number of vertices
+};
+
+#endif // _DRAWLIST_H
+}}
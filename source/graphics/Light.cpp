@@ -5,7 +5,11 @@ namespace graphics {
 
     Light::Light()
     {
-
+        mLightPosition = { 0.0f, 0.0f };
+        mLightColour = { 255.0f, 255.0f, 255.0f, 255.0f };
+        mLightIntensity = 1.0f;
+        mLightRadius = 0.0f;
+        mPointCount = 0;
     }
 
     Light::Light(std::array<float, 2> position, std::array<float, 4> colour, float intensity, float radius)
@@ -29,50 +33,53 @@ namespace graphics {
     void Light::generate(uint32_t pointCount)
     {
         mPointCount = pointCount + 2;
-        mLightGeometry.clear();
-        mLightGeometry.resize(mPointCount);
-
-        mLightGeometry[0].setPosition(0.0f, 0.0f);
-        mLightGeometry[0].setColour(mLightColour[0], mLightColour[1], 
-                                    mLightColour[2], mLightIntensity * 255.0f);
-
-        for (uint32_t i = 1; i < (mPointCount - 1); i++)
-        {
-            float angle = (float)(PI * 2.0) * ((float)i / (float)(mPointCount - 2));
-            float positionX = mLightRadius * std::cos(angle);
-            float positionY = mLightRadius * std::sin(angle);
-
-            mLightGeometry[i].setPosition(positionX, positionY);
-            mLightGeometry[i].setColour(0.f, 0.f, 0.f, 0.f);
-        }
-
-        mLightGeometry[mPointCount - 1] = mLightGeometry[1];
+        mLightMesh = LightMeshCache::instance().acquire(mLightRadius, pointCount, mLightColour, mLightIntensity);
     }
 
     void Light::setLightPosition(std::array<float, 2> position)
     {
+        // The fan is built around the origin, the position is only applied when drawn
         mLightPosition = position;
-        generate(mPointCount);
     }
 
     void Light::setLightColour(std::array<float, 4> colour)
     {
         mLightColour = colour;
+        if (mPointCount >= 2)
+            generate(mPointCount - 2);
     }
 
     void Light::setLightIntensity(float intensity)
     {
         mLightIntensity = intensity;
+        if (mPointCount >= 2)
+            generate(mPointCount - 2);
     }
 
     void Light::setLightRadius(float radius)
     {
         mLightRadius = radius;
+        if (mPointCount >= 2)
+            generate(mPointCount - 2);
+    }
+
+    void Light::setShadowGeometry(LightMeshCache::Mesh mesh)
+    {
+        mShadowMesh = mesh;
+    }
+
+    const std::vector<RenderVertex>& Light::getLightGeometry() const
+    {
+        static const std::vector<RenderVertex> empty;
+        if (mShadowMesh != nullptr)
+            return *mShadowMesh;
+
+        return (mLightMesh != nullptr) ? *mLightMesh : empty;
     }
 
-    const std::vector<utilities::Vertex2> Light::getLightGeometry() const
+    const LightMeshCache::Mesh& Light::getLightMesh() const
     {
-        return mLightGeometry;
+        return mLightMesh;
     }
 
     const std::array<float, 2> Light::getLightPosition() const
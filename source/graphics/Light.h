@@ -1,4 +1,4 @@
-#include "../utilities/Vertex2.h"
+#include "LightMeshCache.h"
 #include <vector>
 #include <array>
 
@@ -23,7 +23,16 @@ public:
     void setLightIntensity(float intensity);
     void setLightRadius(float radius);
 
-    const std::vector<utilities::Vertex2> getLightGeometry() const;
+    /** \brief Replaces the fan that is drawn with one cut by shadows, see ShadowCaster
+      * \param mesh Fan around the origin, nullptr to draw the unoccluded fan again
+      */
+    void setShadowGeometry(LightMeshCache::Mesh mesh);
+
+    /// \return Triangle fan around the origin that is drawn, shadowed if set
+    const std::vector<RenderVertex>& getLightGeometry() const;
+
+    /// \return Unoccluded triangle fan, shared with lights that look the same
+    const LightMeshCache::Mesh& getLightMesh() const;
     const std::array<float, 2> getLightPosition() const;
     const std::array<float, 4> getLightColour() const;
     const float getLightIntensity() const;
@@ -31,7 +40,8 @@ public:
     const uint32_t getPointCount() const;
 
 protected:
-    std::vector<utilities::Vertex2> mLightGeometry;
+    LightMeshCache::Mesh mLightMesh;
+    LightMeshCache::Mesh mShadowMesh;
     std::array<float, 2> mLightPosition;
     std::array<float, 4> mLightColour;
     float mLightIntensity;
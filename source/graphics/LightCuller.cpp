@@ -0,0 +1,332 @@
+#include "LightCuller.h"
+#include <algorithm>
+#include <cmath>
+
+namespace liquid {
+namespace graphics {
+
+    LightCuller::LightCuller()
+    {
+        mCellSize = DEFAULT_CELL_SIZE;
+        mGridCell = DEFAULT_CELL_SIZE;
+        mGridOrigin = { 0.0f, 0.0f };
+        mGridX = 0;
+        mGridY = 0;
+        mGridDirty = true;
+        mStamp = 0;
+        mTileSize = 0;
+        mTilesX = 0;
+        mTilesY = 0;
+        mConsidered = 0;
+        mCulled = 0;
+        mCellStart.assign(1, 0);
+        mTileStart.assign(1, 0);
+    }
+
+    LightCuller::~LightCuller()
+    {}
+
+    void LightCuller::setCellSize(float cellSize)
+    {
+        if (cellSize <= 0.0f)
+            return;
+
+        mCellSize = cellSize;
+        mGridDirty = true;
+    }
+
+    void LightCuller::setTileBinning(uint32_t tileSize)
+    {
+        mTileSize = tileSize;
+    }
+
+    void LightCuller::cull(utilities::Span<Light* const> lights, std::array<float, 4> view,
+                           std::array<uint32_t, 2> screenSize)
+    {
+        beginCull(lights.size());
+        for (uint32_t i = 0; i < lights.size(); i++)
+            setBounds(i, *lights[i]);
+
+        finishCull(view, screenSize);
+    }
+
+    void LightCuller::cull(const Light* lights, uint32_t lightCount, std::array<float, 4> view,
+                           std::array<uint32_t, 2> screenSize)
+    {
+        beginCull(lightCount);
+        for (uint32_t i = 0; i < lightCount; i++)
+            setBounds(i, lights[i]);
+
+        finishCull(view, screenSize);
+    }
+
+    const std::vector<uint32_t>& LightCuller::getVisibleLights() const
+    {
+        return mVisible;
+    }
+
+    utilities::Span<const uint32_t> LightCuller::getTileLights(uint32_t tileX, uint32_t tileY) const
+    {
+        if (tileX >= mTilesX || tileY >= mTilesY)
+            return utilities::Span<const uint32_t>();
+
+        uint32_t tile = tileY * mTilesX + tileX;
+        return utilities::Span<const uint32_t>(mTileLights.data() + mTileStart[tile],
+                                               mTileStart[tile + 1] - mTileStart[tile]);
+    }
+
+    const uint32_t LightCuller::getTileSize() const
+    {
+        return mTileSize;
+    }
+
+    const uint32_t LightCuller::getTilesX() const
+    {
+        return mTilesX;
+    }
+
+    const uint32_t LightCuller::getTilesY() const
+    {
+        return mTilesY;
+    }
+
+    const uint32_t LightCuller::getConsideredCount() const
+    {
+        return mConsidered;
+    }
+
+    const uint32_t LightCuller::getCulledCount() const
+    {
+        return mCulled;
+    }
+
+    const uint32_t LightCuller::getDrawnCount() const
+    {
+        return mVisible.size();
+    }
+
+    void LightCuller::setBounds(uint32_t index, const Light& light)
+    {
+        std::array<float, 2> position = light.getLightPosition();
+        float radius = light.getLightRadius();
+        std::array<float, 4> bounds = { position[0] - radius, position[1] - radius,
+                                        position[0] + radius, position[1] + radius };
+
+        if (mBounds[index] != bounds)
+        {
+            mBounds[index] = bounds;
+            mGridDirty = true;
+        }
+    }
+
+    void LightCuller::beginCull(uint32_t lightCount)
+    {
+        if (mBounds.size() != lightCount)
+        {
+            mBounds.resize(lightCount);
+            mStamps.resize(lightCount, 0);
+            mGridDirty = true;
+        }
+    }
+
+    void LightCuller::finishCull(std::array<float, 4> view, std::array<uint32_t, 2> screenSize)
+    {
+        if (mGridDirty)
+        {
+            buildGrid();
+            mGridDirty = false;
+        }
+
+        mStamp++;
+        mVisible.clear();
+        mConsidered = 0;
+
+        auto test = [&](uint32_t light)
+        {
+            if (mStamps[light] == mStamp)
+                return;
+
+            mStamps[light] = mStamp;
+            mConsidered++;
+
+            const std::array<float, 4>& bounds = mBounds[light];
+            if (bounds[2] >= view[0] && bounds[0] <= view[2] && bounds[3] >= view[1] && bounds[1] <= view[3])
+                mVisible.push_back(light);
+        };
+
+        std::array<int32_t, 4> range = getCellRange(view);
+        for (int32_t y = range[1]; y <= range[3]; y++)
+        {
+            for (int32_t x = range[0]; x <= range[2]; x++)
+            {
+                uint32_t cell = y * mGridX + x;
+                for (uint32_t i = mCellStart[cell]; i < mCellStart[cell + 1]; i++)
+                    test(mCellLights[i]);
+            }
+        }
+
+        for (uint32_t light : mLargeLights)
+            test(light);
+
+        // Cells hand lights out of order, draw them in the order they were given
+        std::sort(mVisible.begin(), mVisible.end());
+        mCulled = mBounds.size() - mVisible.size();
+
+        binTiles(view, screenSize);
+    }
+
+    void LightCuller::buildGrid()
+    {
+        mCellLights.clear();
+        mLargeLights.clear();
+
+        if (mBounds.empty())
+        {
+            mGridX = mGridY = 0;
+            mCellStart.assign(1, 0);
+            return;
+        }
+
+        std::array<float, 4> extent = mBounds[0];
+        for (const std::array<float, 4>& bounds : mBounds)
+        {
+            extent[0] = std::min(extent[0], bounds[0]);
+            extent[1] = std::min(extent[1], bounds[1]);
+            extent[2] = std::max(extent[2], bounds[2]);
+            extent[3] = std::max(extent[3], bounds[3]);
+        }
+
+        // Widely spread lights get coarser cells rather than an unbounded grid
+        mGridCell = mCellSize;
+        mGridOrigin = { extent[0], extent[1] };
+        for (;;)
+        {
+            mGridX = (uint32_t)((extent[2] - extent[0]) / mGridCell) + 1;
+            mGridY = (uint32_t)((extent[3] - extent[1]) / mGridCell) + 1;
+            if ((uint64_t)mGridX * mGridY <= MAX_GRID_CELLS)
+                break;
+
+            mGridCell *= 2.0f;
+        }
+
+        mCellStart.assign(mGridX * mGridY + 1, 0);
+        for (uint32_t light = 0; light < mBounds.size(); light++)
+        {
+            std::array<int32_t, 4> range = getCellRange(mBounds[light]);
+            if ((uint32_t)((range[2] - range[0] + 1) * (range[3] - range[1] + 1)) > MAX_LIGHT_CELLS)
+            {
+                mLargeLights.push_back(light);
+                continue;
+            }
+
+            for (int32_t y = range[1]; y <= range[3]; y++)
+            {
+                for (int32_t x = range[0]; x <= range[2]; x++)
+                    mCellStart[y * mGridX + x + 1]++;
+            }
+        }
+
+        for (uint32_t cell = 1; cell < mCellStart.size(); cell++)
+            mCellStart[cell] += mCellStart[cell - 1];
+
+        // Fill using the starts as cursors, each ends on the start of the next cell
+        mCellLights.resize(mCellStart.back());
+        for (uint32_t light = 0; light < mBounds.size(); light++)
+        {
+            std::array<int32_t, 4> range = getCellRange(mBounds[light]);
+            if ((uint32_t)((range[2] - range[0] + 1) * (range[3] - range[1] + 1)) > MAX_LIGHT_CELLS)
+                continue;
+
+            for (int32_t y = range[1]; y <= range[3]; y++)
+            {
+                for (int32_t x = range[0]; x <= range[2]; x++)
+                    mCellLights[mCellStart[y * mGridX + x]++] = light;
+            }
+        }
+
+        for (uint32_t cell = mCellStart.size() - 1; cell > 0; cell--)
+            mCellStart[cell] = mCellStart[cell - 1];
+
+        mCellStart[0] = 0;
+    }
+
+    void LightCuller::binTiles(std::array<float, 4> view, std::array<uint32_t, 2> screenSize)
+    {
+        mTilesX = mTilesY = 0;
+        mTileStart.assign(1, 0);
+        mTileLights.clear();
+
+        float viewWidth = view[2] - view[0];
+        float viewHeight = view[3] - view[1];
+        if (mTileSize == 0 || screenSize[0] == 0 || screenSize[1] == 0 || viewWidth <= 0.0f || viewHeight <= 0.0f)
+            return;
+
+        mTilesX = (screenSize[0] + mTileSize - 1) / mTileSize;
+        mTilesY = (screenSize[1] + mTileSize - 1) / mTileSize;
+        float scaleX = screenSize[0] / viewWidth / mTileSize;
+        float scaleY = screenSize[1] / viewHeight / mTileSize;
+
+        // Visible lights overlap the view, so their tile ranges are never empty after clamping
+        auto getTileRange = [&](const std::array<float, 4>& bounds)
+        {
+            std::array<int32_t, 4> range;
+            range[0] = std::max((int32_t)std::floor((bounds[0] - view[0]) * scaleX), 0);
+            range[1] = std::max((int32_t)std::floor((bounds[1] - view[1]) * scaleY), 0);
+            range[2] = std::min((int32_t)std::floor((bounds[2] - view[0]) * scaleX), (int32_t)mTilesX - 1);
+            range[3] = std::min((int32_t)std::floor((bounds[3] - view[1]) * scaleY), (int32_t)mTilesY - 1);
+            return range;
+        };
+
+        mTileStart.assign(mTilesX * mTilesY + 1, 0);
+        for (uint32_t light : mVisible)
+        {
+            std::array<int32_t, 4> range = getTileRange(mBounds[light]);
+            for (int32_t y = range[1]; y <= range[3]; y++)
+            {
+                for (int32_t x = range[0]; x <= range[2]; x++)
+                    mTileStart[y * mTilesX + x + 1]++;
+            }
+        }
+
+        for (uint32_t tile = 1; tile < mTileStart.size(); tile++)
+            mTileStart[tile] += mTileStart[tile - 1];
+
+        mTileLights.resize(mTileStart.back());
+        for (uint32_t light : mVisible)
+        {
+            std::array<int32_t, 4> range = getTileRange(mBounds[light]);
+            for (int32_t y = range[1]; y <= range[3]; y++)
+            {
+                for (int32_t x = range[0]; x <= range[2]; x++)
+                    mTileLights[mTileStart[y * mTilesX + x]++] = light;
+            }
+        }
+
+        for (uint32_t tile = mTileStart.size() - 1; tile > 0; tile--)
+            mTileStart[tile] = mTileStart[tile - 1];
+
+        mTileStart[0] = 0;
+    }
+
+    std::array<int32_t, 4> LightCuller::getCellRange(const std::array<float, 4>& bounds) const
+    {
+        std::array<int32_t, 4> empty = { 0, 0, -1, -1 };
+        if (mGridX == 0 || mGridY == 0)
+            return empty;
+
+        float x1 = std::floor((bounds[0] - mGridOrigin[0]) / mGridCell);
+        float y1 = std::floor((bounds[1] - mGridOrigin[1]) / mGridCell);
+        float x2 = std::floor((bounds[2] - mGridOrigin[0]) / mGridCell);
+        float y2 = std::floor((bounds[3] - mGridOrigin[1]) / mGridCell);
+        if (x2 < 0.0f || y2 < 0.0f || x1 >= mGridX || y1 >= mGridY)
+            return empty;
+
+        std::array<int32_t, 4> range;
+        range[0] = (int32_t)std::max(x1, 0.0f);
+        range[1] = (int32_t)std::max(y1, 0.0f);
+        range[2] = (int32_t)std::min(x2, (float)mGridX - 1);
+        range[3] = (int32_t)std::min(y2, (float)mGridY - 1);
+        return range;
+    }
+
+}}
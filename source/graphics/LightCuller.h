@@ -0,0 +1,168 @@
+#include <array>
+#include <vector>
+#include <stdint.h>
+#include "Light.h"
+#include "../utilities/Span.h"
+
+namespace liquid { namespace graphics {
+#ifndef _LIGHTCULLER_H
+#define _LIGHTCULLER_H
+
+/**
+ * \class LightCuller
+ *
+ * \ingroup Graphics
+ * \brief Finds the lights that reach the camera and bins them by screen tile
+ *
+ * The bounds of every light are filed in a uniform grid, which is only rebuilt when a
+ * light moves, changes radius or the list of lights changes. Culling walks the cells
+ * under the camera rectangle, so the lights tested and drawn scale with what is on
+ * screen rather than with every light in the scene. Lights so large they would cover
+ * many cells are kept aside and tested on every cull.
+ *
+ * With tile binning enabled the visible lights are also sorted into square tiles of the
+ * screen, so a pass that works tile by tile, or band by band, only looks at the short
+ * list of lights that touch it. Binning is off by default and no lighting manager turns
+ * it on, as the tiles assume the view rectangle maps straight onto the screen, so a
+ * culled frame pays nothing for it unless setTileBinning() is called.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class LightCuller
+{
+public:
+    /// Width and height in 2D space of the grid cells, grown when the lights spread too far
+    static constexpr float DEFAULT_CELL_SIZE = 512.0f;
+
+    /// Largest number of cells the grid is allowed
+    static const uint32_t MAX_GRID_CELLS = 65536;
+
+    /// Lights covering more cells than this are tested on every cull instead of filed
+    static const uint32_t MAX_LIGHT_CELLS = 16;
+
+public:
+    /// LightCuller Constructor
+    LightCuller();
+
+    /// LightCuller Destructor
+    ~LightCuller();
+
+    /** \brief Sets the size of the grid cells, the grid is rebuilt on the next cull
+      * \param cellSize Width and height of a cell in 2D space
+      */
+    void setCellSize(float cellSize);
+
+    /** \brief Enables binning the visible lights by screen tile, binning is off by default
+      * \param tileSize Width and height of a tile in pixels, 0 to disable binning
+      */
+    void setTileBinning(uint32_t tileSize);
+
+    /** \brief Culls lights owned elsewhere against the camera
+      * \param lights Lights to cull, indices into this list are reported
+      * \param view Camera rectangle as (x1, y1, x2, y2)
+      * \param screenSize Size in pixels the camera rectangle is drawn at, used by tile binning
+      */
+    void cull(utilities::Span<Light* const> lights, std::array<float, 4> view, std::array<uint32_t, 2> screenSize);
+
+    /** \brief Culls a list of lights against the camera
+      * \param lights Lights to cull, indices into this list are reported
+      * \param lightCount Number of lights
+      * \param view Camera rectangle as (x1, y1, x2, y2)
+      * \param screenSize Size in pixels the camera rectangle is drawn at, used by tile binning
+      */
+    void cull(const Light* lights, uint32_t lightCount, std::array<float, 4> view,
+              std::array<uint32_t, 2> screenSize);
+
+    /// \return Indices of the lights that reach the camera, in list order
+    const std::vector<uint32_t>& getVisibleLights() const;
+
+    /** \brief Gets the lights that touch a screen tile
+      * \param tileX Column of the tile
+      * \param tileY Row of the tile
+      * \return Indices into the culled list, empty if binning is off or the tile is outside
+      */
+    utilities::Span<const uint32_t> getTileLights(uint32_t tileX, uint32_t tileY) const;
+
+    /// \return Width and height of a tile in pixels, 0 if binning is off
+    const uint32_t getTileSize() const;
+
+    /// \return Number of tiles across the screen by the last cull
+    const uint32_t getTilesX() const;
+
+    /// \return Number of tiles down the screen by the last cull
+    const uint32_t getTilesY() const;
+
+    /// \return Lights whose bounds the last cull tested against the camera
+    const uint32_t getConsideredCount() const;
+
+    /// \return Lights the last cull rejected, including those never tested
+    const uint32_t getCulledCount() const;
+
+    /// \return Lights that passed the last cull
+    const uint32_t getDrawnCount() const;
+
+protected:
+    /** \brief Records the bounds of a light, flagging the grid for rebuilding if they moved
+      * \param index Index of the light in the list
+      * \param light Light to record
+      */
+    void setBounds(uint32_t index, const Light& light);
+
+    /** \brief Resizes the recorded bounds to the number of lights
+      * \param lightCount Number of lights about to be recorded
+      */
+    void beginCull(uint32_t lightCount);
+
+    /** \brief Rebuilds the grid if needed, then culls and bins the recorded bounds
+      * \param view Camera rectangle as (x1, y1, x2, y2)
+      * \param screenSize Size in pixels the camera rectangle is drawn at
+      */
+    void finishCull(std::array<float, 4> view, std::array<uint32_t, 2> screenSize);
+
+    /// \brief Files the recorded bounds in the grid
+    void buildGrid();
+
+    /** \brief Sorts the visible lights into screen tiles
+      * \param view Camera rectangle as (x1, y1, x2, y2)
+      * \param screenSize Size in pixels the camera rectangle is drawn at
+      */
+    void binTiles(std::array<float, 4> view, std::array<uint32_t, 2> screenSize);
+
+    /** \brief Gets the range of grid cells a rectangle covers, clamped to the grid
+      * \param bounds Rectangle as (x1, y1, x2, y2)
+      * \return Range as (first column, first row, last column, last row)
+      */
+    std::array<int32_t, 4> getCellRange(const std::array<float, 4>& bounds) const;
+
+protected:
+    float                             mCellSize;    ///< Requested width and height of a cell
+    float                             mGridCell;    ///< Width and height of a cell in the current grid
+    std::array<float, 2>              mGridOrigin;  ///< Top left corner of the grid
+    uint32_t                          mGridX;       ///< Number of cells across the grid
+    uint32_t                          mGridY;       ///< Number of cells down the grid
+    bool                              mGridDirty;   ///< True if the grid no longer matches mBounds
+
+    std::vector<std::array<float, 4>> mBounds;      ///< Bounds of every light as (x1, y1, x2, y2)
+    std::vector<uint32_t>             mCellStart;   ///< Offset of every cell into mCellLights, one extra at the end
+    std::vector<uint32_t>             mCellLights;  ///< Indices of the lights filed in each cell
+    std::vector<uint32_t>             mLargeLights; ///< Lights too large to file, tested on every cull
+    std::vector<uint32_t>             mStamps;      ///< Last cull that tested each light, so spanning lights are tested once
+    uint32_t                          mStamp;       ///< Number of culls
+
+    std::vector<uint32_t>             mVisible;     ///< Lights that passed the last cull
+    uint32_t                          mTileSize;    ///< Width and height of a tile in pixels, 0 if binning is off
+    uint32_t                          mTilesX;      ///< Number of tiles across the screen
+    uint32_t                          mTilesY;      ///< Number of tiles down the screen
+    std::vector<uint32_t>             mTileStart;   ///< Offset of every tile into mTileLights, one extra at the end
+    std::vector<uint32_t>             mTileLights;  ///< Indices of the lights touching each tile
+
+    uint32_t                          mConsidered;  ///< Lights tested by the last cull
+    uint32_t                          mCulled;      ///< Lights rejected by the last cull
+};
+
+#endif // _LIGHTCULLER_H
+}}
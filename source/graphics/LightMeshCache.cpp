@@ -0,0 +1,105 @@
+#include "LightMeshCache.h"
+#include <algorithm>
+#include <cmath>
+
+namespace liquid {
+namespace graphics {
+
+    LightMeshCache::LightMeshCache()
+    {
+        mGenerated = 0;
+    }
+
+    LightMeshCache::~LightMeshCache()
+    {}
+
+    LightMeshCache::Mesh LightMeshCache::acquire(float radius, uint32_t pointCount, std::array<float, 4> colour,
+                                                 float intensity)
+    {
+        if (pointCount < 2)
+            return nullptr;
+
+        // Quantised the same way the vertices store it, so lights that draw alike share a mesh
+        std::array<uint8_t, 4> centre;
+        centre[0] = (uint8_t)std::min(std::max(colour[0], 0.0f), 255.0f);
+        centre[1] = (uint8_t)std::min(std::max(colour[1], 0.0f), 255.0f);
+        centre[2] = (uint8_t)std::min(std::max(colour[2], 0.0f), 255.0f);
+        centre[3] = (uint8_t)std::min(std::max(intensity * 255.0f, 0.0f), 255.0f);
+
+        Key key;
+        key.mRadius = radius;
+        key.mPointCount = pointCount;
+        key.mColour = ((uint32_t)centre[0] << 24) | ((uint32_t)centre[1] << 16) |
+                      ((uint32_t)centre[2] << 8) | (uint32_t)centre[3];
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        std::map<Key, std::weak_ptr<const std::vector<RenderVertex>>>::iterator it = mMeshes.find(key);
+        if (it != mMeshes.end())
+        {
+            Mesh mesh = it->second.lock();
+            if (mesh != nullptr)
+                return mesh;
+        }
+
+        // Misses are rare, so they also drop the meshes no light holds any more
+        for (it = mMeshes.begin(); it != mMeshes.end();)
+        {
+            if (it->second.expired())
+                it = mMeshes.erase(it);
+            else
+                ++it;
+        }
+
+        Mesh mesh = std::make_shared<const std::vector<RenderVertex>>(generate(key, centre));
+        mMeshes[key] = mesh;
+        mGenerated++;
+        return mesh;
+    }
+
+    const uint32_t LightMeshCache::getMeshCount() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+
+        uint32_t count = 0;
+        for (const auto& mesh : mMeshes)
+        {
+            if (mesh.second.expired() == false)
+                count++;
+        }
+
+        return count;
+    }
+
+    const uint64_t LightMeshCache::getGeneratedCount() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mGenerated;
+    }
+
+    LightMeshCache& LightMeshCache::instance()
+    {
+        static LightMeshCache singleton;
+        return singleton;
+    }
+
+    std::vector<RenderVertex> LightMeshCache::generate(const Key& key, const std::array<uint8_t, 4>& colour)
+    {
+        std::vector<RenderVertex> vertices(key.mPointCount + 2);
+
+        vertices[0].mPositionX = 0.0f;
+        vertices[0].mPositionY = 0.0f;
+        std::copy(colour.begin(), colour.end(), vertices[0].mColour);
+
+        for (uint32_t i = 1; i <= key.mPointCount; i++)
+        {
+            float angle = 6.28318530718f * ((float)i / (float)key.mPointCount);
+            vertices[i].mPositionX = key.mRadius * std::cos(angle);
+            vertices[i].mPositionY = key.mRadius * std::sin(angle);
+            vertices[i].mColour[0] = vertices[i].mColour[1] = vertices[i].mColour[2] = vertices[i].mColour[3] = 0;
+        }
+
+        vertices[key.mPointCount + 1] = vertices[1];
+        return vertices;
+    }
+
+}}
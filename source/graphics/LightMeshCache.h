@@ -0,0 +1,97 @@
+#include <array>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+#include "RenderVertex.h"
+
+namespace liquid { namespace graphics {
+#ifndef _LIGHTMESHCACHE_H
+#define _LIGHTMESHCACHE_H
+
+/**
+ * \class LightMeshCache
+ *
+ * \ingroup Graphics
+ * \brief Shares the triangle fans of lights that look the same
+ *
+ * A light's fan is built around the origin and only depends on its radius, point
+ * count, colour and intensity, its position is applied as a transform when drawn.
+ * Lights with the same look therefore hold the same immutable mesh, generated once
+ * by the first of them and freed with the last. Meshes are never modified after
+ * creation, so they can be read from any thread while the cache is in use.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class LightMeshCache
+{
+public:
+    /// Immutable triangle fan, centre first and the first rim vertex repeated at the end
+    typedef std::shared_ptr<const std::vector<RenderVertex>> Mesh;
+
+public:
+    /// LightMeshCache Constructor
+    LightMeshCache();
+
+    /// LightMeshCache Destructor, meshes still held by lights stay valid
+    ~LightMeshCache();
+
+    /** \brief Gets the mesh of a light, generating it if no light holds it yet
+      * \param radius Radius of the fan
+      * \param pointCount Number of vertices on the rim
+      * \param colour Colour of the centre (r,g,b) as 0 - 255
+      * \param intensity Alpha of the centre as 0 - 1
+      * \return Shared mesh, nullptr if pointCount is below 2
+      */
+    Mesh acquire(float radius, uint32_t pointCount, std::array<float, 4> colour, float intensity);
+
+    /// \return Number of distinct meshes held by lights
+    const uint32_t getMeshCount() const;
+
+    /// \return Number of meshes generated so far
+    const uint64_t getGeneratedCount() const;
+
+    /** \brief Gets the instance of this class (singleton)
+      * \return Cache shared by every Light
+      */
+    static LightMeshCache& instance();
+
+protected:
+    /// Everything a mesh is generated from, the colour as it is stored in the vertices
+    struct Key
+    {
+        float    mRadius;     ///< Radius of the fan
+        uint32_t mPointCount; ///< Number of vertices on the rim
+        uint32_t mColour;     ///< Packed RGBA8 colour of the centre
+
+        bool operator<(const Key& other) const
+        {
+            if (mRadius != other.mRadius)
+                return mRadius < other.mRadius;
+            if (mPointCount != other.mPointCount)
+                return mPointCount < other.mPointCount;
+
+            return mColour < other.mColour;
+        }
+    };
+
+    /** \brief Builds the triangle fan of a light
+      * \param key Look of the light
+      * \param colour Colour of the centre
+      * \return Centre, rim and the first rim vertex repeated
+      */
+    static std::vector<RenderVertex> generate(const Key& key, const std::array<uint8_t, 4>& colour);
+
+protected:
+    std::map<Key, std::weak_ptr<const std::vector<RenderVertex>>> mMeshes;    ///< Meshes by look, expired once no light holds them
+    mutable std::mutex                                            mMutex;     ///< Guards mMeshes and mGenerated
+    uint64_t                                                      mGenerated; ///< Meshes generated so far
+};
+
+#endif // _LIGHTMESHCACHE_H
+}}
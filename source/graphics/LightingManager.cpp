@@ -1,5 +1,7 @@
 #include "LightingManager.h"
+#include "ShadowCaster.h"
 #include "../graphics/Renderer.h"
+#include "../graphics/RenderSnapshot.h"
 
 namespace liquid {
 namespace graphics {
@@ -7,6 +9,7 @@ namespace graphics {
     LightingManager::LightingManager(std::array<float, 4> ambientColour)
     {
         mAmbientColour = ambientColour;
+        mShadowCaster = nullptr;
     }
 
     LightingManager::~LightingManager()
@@ -17,6 +20,18 @@ namespace graphics {
         mLights.clear();
     }
 
+    void LightingManager::drawSnapshot(graphics::Renderer* renderer, const RenderSnapshot& snapshot)
+    {
+        drawLights(renderer, snapshot.mAmbientColour, snapshot.mLights.data(), snapshot.mLights.size());
+    }
+
+    void LightingManager::drawLights(graphics::Renderer* /*renderer*/, const std::array<float, 4>& /*ambientColour*/,
+                                     const Light* /*lights*/, uint32_t /*lightCount*/)
+    {}
+
+    void LightingManager::setRenderThreadActive(bool /*active*/)
+    {}
+
     void LightingManager::insertLight(Light* lightPtr)
     {
         mLights.push_back(lightPtr);
@@ -33,6 +48,39 @@ namespace graphics {
         mAmbientColour = colour;
     }
 
+    void LightingManager::setShadowCaster(ShadowCaster* shadowCaster)
+    {
+        mShadowCaster = shadowCaster;
+
+        if (mShadowCaster == nullptr)
+        {
+            for (Light* light : mLights)
+                light->setShadowGeometry(nullptr);
+        }
+    }
+
+    void LightingManager::updateShadows()
+    {
+        if (mShadowCaster != nullptr)
+            mShadowCaster->update(mLights);
+    }
+
+    ShadowCaster* LightingManager::getShadowCaster() const
+    {
+        return mShadowCaster;
+    }
+
+    LightCuller& LightingManager::getLightCuller()
+    {
+        return mLightCuller;
+    }
+
+    void LightingManager::reportCulling(graphics::Renderer* renderer)
+    {
+        renderer->getStats().setLights(mLightCuller.getConsideredCount(), mLightCuller.getCulledCount(),
+                                       mLightCuller.getDrawnCount());
+    }
+
     const std::array<float, 4> LightingManager::getAmbientColour() const
     {
         return mAmbientColour;
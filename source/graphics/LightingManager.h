@@ -1,10 +1,13 @@
 #include "Light.h"
+#include "LightCuller.h"
 
 namespace liquid { namespace graphics {
 #ifndef _LIGHTINGMANAGER_H
 #define _LIGHTINGMANAGER_H
 
 class Renderer;
+class RenderSnapshot;
+class ShadowCaster;
 class LightingManager
 {
 public:
@@ -12,19 +15,53 @@ public:
     ~LightingManager();
 
     virtual void draw(graphics::Renderer* renderer) = 0;
+    virtual void drawSnapshot(graphics::Renderer* renderer, const RenderSnapshot& snapshot);
+    virtual void drawLights(graphics::Renderer* renderer, const std::array<float, 4>& ambientColour,
+                            const Light* lights, uint32_t lightCount);
+
+    /** \brief Binds or unbinds any render targets of the manager to the calling thread
+      * \param active True to bind to the calling thread, false to release it
+      *
+      * Called by the Renderer alongside its own targets when rendering moves to or
+      * from a render thread.
+      */
+    virtual void setRenderThreadActive(bool active);
 
     virtual void insertLight(Light* lightPtr);
     virtual void removeLight(Light* lightPtr);
 
     void setAmbientColour(std::array<float, 4> colour);
 
+    /** \brief Sets the stage that shadows the lights, it is not owned by the LightingManager
+      * \param shadowCaster Caster to use, nullptr to draw every light unoccluded again
+      */
+    void setShadowCaster(ShadowCaster* shadowCaster);
+
+    /// \brief Brings the shadows of every light up to date, called by the Renderer once per frame
+    void updateShadows();
+
+    ShadowCaster* getShadowCaster() const;
+
+    /** \brief Gets the culler backends pass their lights through before accumulating them
+      * \return Culler of this manager, enable tile binning on it with LightCuller::setTileBinning()
+      */
+    LightCuller& getLightCuller();
+
     const std::array<float, 4> getAmbientColour() const;
     const std::vector<Light*> getLights() const;
     const uint32_t getLightCount() const;
 
+protected:
+    /** \brief Reports the counts of the last cull to the frame the renderer is measuring
+      * \param renderer Renderer drawing the lights
+      */
+    void reportCulling(graphics::Renderer* renderer);
+
 protected:
     std::array<float, 4> mAmbientColour;
     std::vector<Light*>  mLights;
+    ShadowCaster*        mShadowCaster;
+    LightCuller          mLightCuller;
 };
 
 #endif // _LIGHTINGMANAGER_H
@@ -0,0 +1,377 @@
+#include "RenderCommandBuffer.h"
+#include "../utilities/MappedFile.h"
+#include "../utilities/ThreadPool.h"
+#include <cstdio>
+#include <cstring>
+
+namespace liquid {
+namespace graphics {
+
+    namespace
+    {
+        /// Identifies a file written by RenderCommandBuffer::save()
+        const char FILE_MAGIC[4] = { 'L', 'Q', 'R', 'C' };
+
+        /// Bumped whenever the layout of the file changes
+        const uint32_t FILE_VERSION = 1;
+
+        /// Bytes each light takes in the file: position, colour, intensity, radius and point count
+        const uint64_t LIGHT_RECORD_BYTES = sizeof(float) * 8 + sizeof(uint32_t);
+
+        /// Most points a loaded light may ask for, far above any mesh the engine generates
+        const uint32_t MAX_LIGHT_POINTS = 4096;
+
+        template <typename T>
+        void appendValue(std::vector<uint8_t>& output, const T& value)
+        {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+            output.insert(output.end(), bytes, bytes + sizeof(T));
+        }
+
+        template <typename T>
+        void appendArray(std::vector<uint8_t>& output, const std::vector<T>& values)
+        {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values.data());
+            output.insert(output.end(), bytes, bytes + values.size() * sizeof(T));
+        }
+
+        /// Bounds checked reads from a mapped file
+        class Reader
+        {
+        public:
+            Reader(const uint8_t* data, uint64_t size) : mData(data), mSize(size), mOffset(0) {}
+
+            template <typename T>
+            bool readValue(T& value)
+            {
+                if (mSize - mOffset < sizeof(T))
+                    return false;
+
+                std::memcpy(&value, mData + mOffset, sizeof(T));
+                mOffset += sizeof(T);
+                return true;
+            }
+
+            template <typename T>
+            bool readArray(std::vector<T>& values, uint32_t count)
+            {
+                if ((mSize - mOffset) / sizeof(T) < count)
+                    return false;
+
+                values.resize(count);
+                std::memcpy(values.data(), mData + mOffset, (size_t)count * sizeof(T));
+                mOffset += (uint64_t)count * sizeof(T);
+                return true;
+            }
+
+            /// \return Bytes left to read
+            uint64_t getRemaining() const
+            {
+                return mSize - mOffset;
+            }
+
+        private:
+            const uint8_t* mData;
+            uint64_t       mSize;
+            uint64_t       mOffset;
+        };
+    }
+
+    RenderCommandBuffer::RenderCommandBuffer()
+    {
+        mDrawCount = 0;
+    }
+
+    RenderCommandBuffer::~RenderCommandBuffer()
+    {}
+
+    void RenderCommandBuffer::clear()
+    {
+        mCommands.clear();
+        mStates.clear();
+        mViews.clear();
+        mLightingPasses.clear();
+        mLights.clear();
+        mVertices.clear();
+        mDrawCount = 0;
+    }
+
+    void RenderCommandBuffer::record(const RenderSnapshot& snapshot)
+    {
+        clear();
+        setTarget(RENDERTARGET_SCENE);
+        setView(snapshot.mCamera);
+
+        mDrawList.clear();
+        for (uint32_t l = 0; l < snapshot.mLayerCount; l++)
+        {
+            const RenderSnapshot::LayerSnapshot& layer = snapshot.mLayers[l];
+            for (const RenderSnapshot::Sprite& sprite : layer.mSprites)
+            {
+                uint64_t key = layer.mDepthSorted ?
+                    DrawList::makeDepthKey(l, sprite.mDepth, sprite.mShaderID, sprite.mAtlasID,
+                                           sprite.mBlendMode, sprite.mPrimitiveType) :
+                    DrawList::makeKey(l, sprite.mShaderID, sprite.mAtlasID,
+                                      sprite.mBlendMode, sprite.mPrimitiveType);
+
+                mDrawList.insert(key, sprite.mFirstVertex, sprite.mVertexCount);
+            }
+        }
+
+        mDrawList.sort();
+        mVertices.resize(mDrawList.getVertexCount());
+
+        const RenderVertex* source = snapshot.mVertices.data();
+        RenderVertex* destination = mVertices.data();
+        utilities::ThreadPool::instance().parallelFor(mDrawList.getGatherChunkCount(),
+            [this, source, destination](uint32_t chunk) {
+                mDrawList.gather(source, destination, chunk);
+            });
+
+        // Draw calls of different layers can share a state, which is only set once
+        for (const DrawList::DrawCall& drawCall : mDrawList.getDrawCalls())
+        {
+            State state;
+            state.mAtlasID = DrawList::getAtlasID(drawCall.mKey);
+            state.mShaderID = DrawList::getShaderID(drawCall.mKey);
+            state.mBlendMode = DrawList::getBlendMode(drawCall.mKey);
+            state.mPrimitiveType = DrawList::getPrimitiveType(drawCall.mKey);
+
+            if (mStates.empty() || std::memcmp(&mStates.back(), &state, sizeof(State)) != 0)
+                setState(state);
+
+            push(COMMAND_DRAW, 0, drawCall.mFirstVertex, drawCall.mVertexCount);
+            mDrawCount++;
+        }
+
+        setTarget(RENDERTARGET_SCREEN);
+        if (snapshot.mLights.empty() == false)
+            lightingPass(snapshot.mAmbientColour, snapshot.mLights);
+
+        postProcessPass();
+    }
+
+    void RenderCommandBuffer::setTarget(eRenderTarget target)
+    {
+        push(COMMAND_SETTARGET, target);
+    }
+
+    void RenderCommandBuffer::setView(const RenderSnapshot::CameraSnapshot& camera)
+    {
+        push(COMMAND_SETVIEW, mViews.size());
+        mViews.push_back(camera);
+    }
+
+    void RenderCommandBuffer::setState(const State& state)
+    {
+        push(COMMAND_SETSTATE, mStates.size());
+        mStates.push_back(state);
+    }
+
+    void RenderCommandBuffer::draw(const RenderVertex* vertices, uint32_t count)
+    {
+        push(COMMAND_DRAW, 0, mVertices.size(), count);
+        mVertices.insert(mVertices.end(), vertices, vertices + count);
+        mDrawCount++;
+    }
+
+    void RenderCommandBuffer::lightingPass(const std::array<float, 4>& ambientColour, const std::vector<Light>& lights)
+    {
+        LightingPass pass;
+        pass.mAmbientColour = ambientColour;
+        pass.mFirstLight = mLights.size();
+        pass.mLightCount = lights.size();
+
+        push(COMMAND_LIGHTING, mLightingPasses.size());
+        mLightingPasses.push_back(pass);
+        mLights.insert(mLights.end(), lights.begin(), lights.end());
+    }
+
+    void RenderCommandBuffer::postProcessPass()
+    {
+        push(COMMAND_POSTPROCESS, 0);
+    }
+
+    bool RenderCommandBuffer::save(std::string file) const
+    {
+        // Native byte order, the file is meant to be replayed on the machine that recorded it
+        std::vector<uint8_t> output;
+        output.insert(output.end(), FILE_MAGIC, FILE_MAGIC + 4);
+        appendValue(output, FILE_VERSION);
+        appendValue(output, (uint32_t)mCommands.size());
+        appendValue(output, (uint32_t)mStates.size());
+        appendValue(output, (uint32_t)mViews.size());
+        appendValue(output, (uint32_t)mLightingPasses.size());
+        appendValue(output, (uint32_t)mLights.size());
+        appendValue(output, (uint32_t)mVertices.size());
+
+        appendArray(output, mCommands);
+        appendArray(output, mStates);
+
+        for (const RenderSnapshot::CameraSnapshot& view : mViews)
+        {
+            appendValue(output, (uint32_t)view.mValid);
+            appendValue(output, view.mCentre);
+            appendValue(output, view.mDimensions);
+            appendValue(output, view.mRotation);
+        }
+
+        appendArray(output, mLightingPasses);
+
+        for (const Light& light : mLights)
+        {
+            appendValue(output, light.getLightPosition());
+            appendValue(output, light.getLightColour());
+            appendValue(output, light.getLightIntensity());
+            appendValue(output, light.getLightRadius());
+            appendValue(output, light.getPointCount());
+        }
+
+        appendArray(output, mVertices);
+
+        FILE* handle = std::fopen(file.c_str(), "wb");
+        if (handle == nullptr)
+            return false;
+
+        bool written = std::fwrite(output.data(), 1, output.size(), handle) == output.size();
+        return (std::fclose(handle) == 0) && written;
+    }
+
+    bool RenderCommandBuffer::load(std::string file)
+    {
+        clear();
+
+        utilities::MappedFile mapped;
+        if (mapped.open(file) == false)
+            return false;
+
+        Reader reader(mapped.getData(), mapped.getSize());
+        char magic[4];
+        uint32_t version = 0, commandCount = 0, stateCount = 0, viewCount = 0;
+        uint32_t passCount = 0, lightCount = 0, vertexCount = 0;
+
+        bool valid = reader.readValue(magic) && std::memcmp(magic, FILE_MAGIC, 4) == 0 &&
+                     reader.readValue(version) && version == FILE_VERSION &&
+                     reader.readValue(commandCount) && reader.readValue(stateCount) &&
+                     reader.readValue(viewCount) && reader.readValue(passCount) &&
+                     reader.readValue(lightCount) && reader.readValue(vertexCount) &&
+                     reader.readArray(mCommands, commandCount) && reader.readArray(mStates, stateCount);
+
+        for (uint32_t v = 0; valid && v < viewCount; v++)
+        {
+            RenderSnapshot::CameraSnapshot view;
+            uint32_t viewValid = 0;
+            valid = reader.readValue(viewValid) && reader.readValue(view.mCentre) &&
+                    reader.readValue(view.mDimensions) && reader.readValue(view.mRotation);
+            view.mValid = viewValid != 0;
+            mViews.push_back(view);
+        }
+
+        valid = valid && reader.readArray(mLightingPasses, passCount) &&
+                reader.getRemaining() / LIGHT_RECORD_BYTES >= lightCount;
+
+        for (uint32_t l = 0; valid && l < lightCount; l++)
+        {
+            std::array<float, 2> position;
+            std::array<float, 4> colour;
+            float intensity = 0.0f, radius = 0.0f;
+            uint32_t pointCount = 0;
+
+            // A fan needs its centre and at least two rim points to cover anything
+            valid = reader.readValue(position) && reader.readValue(colour) && reader.readValue(intensity) &&
+                    reader.readValue(radius) && reader.readValue(pointCount) &&
+                    pointCount >= 3 && pointCount <= MAX_LIGHT_POINTS;
+
+            if (valid == false)
+                break;
+
+            mLights.push_back(Light(position, colour, intensity, radius));
+            if (pointCount != mLights.back().getPointCount())
+                mLights.back().generate(pointCount - 2);
+        }
+
+        valid = valid && reader.readArray(mVertices, vertexCount);
+
+        // Every index has to land inside its table, so backends can trust a loaded buffer
+        for (uint32_t c = 0; valid && c < mCommands.size(); c++)
+        {
+            const Command& command = mCommands[c];
+            switch (command.mType)
+            {
+            case COMMAND_SETTARGET:
+                valid = command.mArgument <= RENDERTARGET_SCREEN;
+                break;
+            case COMMAND_SETVIEW:
+                valid = command.mArgument < mViews.size();
+                break;
+            case COMMAND_SETSTATE:
+                valid = command.mArgument < mStates.size();
+                break;
+            case COMMAND_DRAW:
+                valid = command.mFirst <= mVertices.size() && command.mCount <= mVertices.size() - command.mFirst;
+                mDrawCount++;
+                break;
+            case COMMAND_LIGHTING:
+                valid = command.mArgument < mLightingPasses.size() &&
+                        mLightingPasses[command.mArgument].mFirstLight <= mLights.size() &&
+                        mLightingPasses[command.mArgument].mLightCount <= mLights.size() - mLightingPasses[command.mArgument].mFirstLight;
+                break;
+            case COMMAND_POSTPROCESS:
+                break;
+            default:
+                valid = false;
+            }
+        }
+
+        if (valid == false)
+            clear();
+
+        return valid;
+    }
+
+    const std::vector<RenderCommandBuffer::Command>& RenderCommandBuffer::getCommands() const
+    {
+        return mCommands;
+    }
+
+    const std::vector<RenderCommandBuffer::State>& RenderCommandBuffer::getStates() const
+    {
+        return mStates;
+    }
+
+    const std::vector<RenderSnapshot::CameraSnapshot>& RenderCommandBuffer::getViews() const
+    {
+        return mViews;
+    }
+
+    const std::vector<RenderCommandBuffer::LightingPass>& RenderCommandBuffer::getLightingPasses() const
+    {
+        return mLightingPasses;
+    }
+
+    const std::vector<Light>& RenderCommandBuffer::getLights() const
+    {
+        return mLights;
+    }
+
+    const std::vector<RenderVertex>& RenderCommandBuffer::getVertices() const
+    {
+        return mVertices;
+    }
+
+    const uint32_t RenderCommandBuffer::getDrawCount() const
+    {
+        return mDrawCount;
+    }
+
+    void RenderCommandBuffer::push(eCommandType type, uint32_t argument, uint32_t first, uint32_t count)
+    {
+        Command command;
+        command.mType = type;
+        command.mArgument = argument;
+        command.mFirst = first;
+        command.mCount = count;
+        mCommands.push_back(command);
+    }
+
+}}
@@ -0,0 +1,189 @@
+#include <array>
+#include <vector>
+#include <string>
+#include <stdint.h>
+#include "DrawList.h"
+#include "Light.h"
+#include "RenderSnapshot.h"
+#include "RenderVertex.h"
+
+namespace liquid { namespace graphics {
+#ifndef _RENDERCOMMANDBUFFER_H
+#define _RENDERCOMMANDBUFFER_H
+
+/**
+ * \class RenderCommandBuffer
+ *
+ * \ingroup Graphics
+ * \brief Backend neutral list of the commands that draw one frame
+ *
+ * record() is the shared front end: it sorts a RenderSnapshot through a DrawList and
+ * turns the result into target, view and state changes, draws of vertex ranges and
+ * the lighting and post processing passes. Any Renderer consumes the buffer through
+ * Renderer::execute(), so the scene side of a frame can be reused and measured apart
+ * from the backend.
+ *
+ * Commands only hold indices into the buffer's own tables, which makes the buffer
+ * plain data: save() dumps it to a file and load() reads it back so a recorded frame
+ * can be replayed against any backend offline.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class RenderCommandBuffer
+{
+public:
+    /// Kind of a Command
+    enum eCommandType
+    {
+        COMMAND_SETTARGET = 0,
+        COMMAND_SETVIEW = 1,
+        COMMAND_SETSTATE = 2,
+        COMMAND_DRAW = 3,
+        COMMAND_LIGHTING = 4,
+        COMMAND_POSTPROCESS = 5,
+    };
+
+    /// Surfaces a Command can draw into
+    enum eRenderTarget
+    {
+        RENDERTARGET_SCENE = 0,
+        RENDERTARGET_SCREEN = 1,
+    };
+
+    /** One entry of the stream, the fields used depend on the type:
+      * SETTARGET: mArgument is an eRenderTarget
+      * SETVIEW: mArgument indexes getViews()
+      * SETSTATE: mArgument indexes getStates()
+      * DRAW: mFirst and mCount are a range of getVertices()
+      * LIGHTING: mArgument indexes getLightingPasses()
+      * POSTPROCESS: no fields
+      */
+    struct Command
+    {
+        uint32_t mType;     ///< eCommandType of the command
+        uint32_t mArgument; ///< Target or table index, see above
+        uint32_t mFirst;    ///< First vertex drawn
+        uint32_t mCount;    ///< Number of vertices drawn
+    };
+
+    /// Render state used by the draws that follow a SETSTATE
+    struct State
+    {
+        int32_t mAtlasID;       ///< Texture atlas, -1 for none
+        int32_t mShaderID;      ///< Shader, -1 for none
+        int32_t mBlendMode;     ///< Blend mode
+        int32_t mPrimitiveType; ///< Primitive type of the vertices
+    };
+
+    /// Lights accumulated and composited by one lighting pass
+    struct LightingPass
+    {
+        std::array<float, 4> mAmbientColour; ///< Colour the light buffer is cleared to
+        uint32_t             mFirstLight;    ///< Index of the first light in getLights()
+        uint32_t             mLightCount;    ///< Number of lights
+    };
+
+public:
+    /// RenderCommandBuffer Constructor
+    RenderCommandBuffer();
+
+    /// RenderCommandBuffer Destructor
+    ~RenderCommandBuffer();
+
+    /// \brief Empties the buffer while keeping its allocations for reuse
+    void clear();
+
+    /** \brief Replaces the contents with the commands that draw a RenderSnapshot
+      * \param snapshot Snapshot to record
+      */
+    void record(const RenderSnapshot& snapshot);
+
+    /** \brief Appends a change of render target
+      * \param target Surface the following commands draw into
+      */
+    void setTarget(eRenderTarget target);
+
+    /** \brief Appends a change of view
+      * \param camera Camera the following draws are seen through
+      */
+    void setView(const RenderSnapshot::CameraSnapshot& camera);
+
+    /** \brief Appends a change of render state
+      * \param state State of the following draws
+      */
+    void setState(const State& state);
+
+    /** \brief Appends a draw of vertices, which are copied into the buffer
+      * \param vertices Vertices to draw
+      * \param count Number of vertices
+      */
+    void draw(const RenderVertex* vertices, uint32_t count);
+
+    /** \brief Appends a lighting pass, the lights are copied into the buffer
+      * \param ambientColour Colour of unlit areas
+      * \param lights Lights to accumulate
+      */
+    void lightingPass(const std::array<float, 4>& ambientColour, const std::vector<Light>& lights);
+
+    /// \brief Appends a pass of the Renderer's post processors
+    void postProcessPass();
+
+    /** \brief Writes the buffer to a binary file
+      * \param file Path of the file
+      * \return True if the file was written
+      */
+    bool save(std::string file) const;
+
+    /** \brief Replaces the contents with a buffer written by save()
+      * \param file Path of the file
+      * \return True if loaded, False if the file is missing or malformed, the buffer is then empty
+      */
+    bool load(std::string file);
+
+    /// \return Commands in execution order
+    const std::vector<Command>& getCommands() const;
+
+    /// \return Render states referenced by SETSTATE commands
+    const std::vector<State>& getStates() const;
+
+    /// \return Views referenced by SETVIEW commands
+    const std::vector<RenderSnapshot::CameraSnapshot>& getViews() const;
+
+    /// \return Lighting passes referenced by LIGHTING commands
+    const std::vector<LightingPass>& getLightingPasses() const;
+
+    /// \return Lights of every lighting pass
+    const std::vector<Light>& getLights() const;
+
+    /// \return Vertices referenced by DRAW commands
+    const std::vector<RenderVertex>& getVertices() const;
+
+    /// \return Number of DRAW commands
+    const uint32_t getDrawCount() const;
+
+protected:
+    /** \brief Appends a command
+      * \param type eCommandType of the command
+      * \param argument Target or table index
+      * \param first First vertex drawn
+      * \param count Number of vertices drawn
+      */
+    void push(eCommandType type, uint32_t argument, uint32_t first = 0, uint32_t count = 0);
+
+protected:
+    std::vector<Command>                        mCommands;       ///< Commands in execution order
+    std::vector<State>                          mStates;         ///< Render states of SETSTATE commands
+    std::vector<RenderSnapshot::CameraSnapshot> mViews;          ///< Views of SETVIEW commands
+    std::vector<LightingPass>                   mLightingPasses; ///< Passes of LIGHTING commands
+    std::vector<Light>                          mLights;         ///< Lights of every lighting pass
+    std::vector<RenderVertex>                   mVertices;       ///< Vertices of every DRAW command
+    uint32_t                                    mDrawCount;      ///< Number of DRAW commands
+    DrawList                                    mDrawList;       ///< Sorts the snapshot in record()
+};
+
+#endif // _RENDERCOMMANDBUFFER_H
+}}
@@ -0,0 +1,186 @@
+#include "RenderSnapshot.h"
+#include "LightingManager.h"
+#include "SpriteExpander.h"
+#include "../common/GameScene.h"
+#include "../utilities/DeltaTime.h"
+
+namespace liquid {
+namespace graphics {
+
+    RenderSnapshot::RenderSnapshot()
+    {
+        mAmbientColour = { 0.0f, 0.0f, 0.0f, 0.0f };
+        mCamera.mValid = false;
+        mInterpolation = 1.0f;
+        mLayerCount = 0;
+        mCaptureTime = std::chrono::steady_clock::now();
+    }
+
+    RenderSnapshot::~RenderSnapshot()
+    {}
+
+    void RenderSnapshot::clear()
+    {
+        for (LayerSnapshot& layer : mLayers)
+        {
+            layer.mSprites.clear();
+            layer.mVisibleCount = 0;
+            layer.mCulledCount = 0;
+            layer.mDepthSorted = false;
+        }
+
+        mVertices.clear();
+        mInstances.clear();
+        mExpansions.clear();
+        mLights.clear();
+        mCamera.mValid = false;
+        mLayerCount = 0;
+    }
+
+    void RenderSnapshot::capture(common::GameScene* gameScene, LightingManager* lightingManager)
+    {
+        clear();
+        mCaptureTime = std::chrono::steady_clock::now();
+
+        float x1 = 0.f, y1 = 0.f;
+        float x2 = 0.f, y2 = 0.f;
+
+        common::Camera* camera = gameScene->getCamera();
+        if (camera != nullptr)
+        {
+            x1 = camera->getCentre()[0] - camera->getDimensions()[0];
+            y1 = camera->getCentre()[1] - camera->getDimensions()[1];
+            x2 = camera->getCentre()[0] + camera->getDimensions()[0];
+            y2 = camera->getCentre()[1] + camera->getDimensions()[1];
+
+            mCamera.mValid = true;
+            mCamera.mCentre = camera->getViewCentre();
+            mCamera.mDimensions = camera->getViewDimensions();
+            mCamera.mRotation = camera->getRotation();
+        }
+
+        utilities::Span<common::Layer* const> layers = gameScene->getLayers();
+        mLayerCount = layers.size();
+        if (mLayers.size() < mLayerCount)
+            mLayers.resize(mLayerCount);
+
+        for (uint32_t l = 0; l < mLayerCount; l++)
+        {
+            std::vector<Sprite>& sprites = mLayers[l].mSprites;
+            utilities::Span<common::Entity* const> entities = layers[l]->getEntities();
+            uint32_t entityCount = entities.size();
+
+            // Static layers cull their baked chunks instead of their Entities, only a spatial
+            // query narrows the Entities otherwise they are viewed in place
+            if (layers[l]->isStatic())
+            {
+                entities = utilities::Span<common::Entity* const>();
+                entityCount = 0;
+            }
+            else if (layers[l]->getSpatialHash() != nullptr)
+            {
+                mQuery = layers[l]->getEntities({ x1, y1, x2, y2 });
+                entities = mQuery;
+            }
+
+            mLayers[l].mVisibleCount = entities.size();
+            mLayers[l].mCulledCount = entityCount - entities.size();
+            mLayers[l].mDepthSorted = layers[l]->getSortMode() != common::Layer::SORTMODE_NONE;
+
+            // Cached geometry is copied as is, beneath the Entities of the layer
+            mGeometry.clear();
+            layers[l]->getGeometry({ x1, y1, x2, y2 }, mGeometry);
+            for (const common::Layer::GeometryBlock& block : mGeometry)
+            {
+                Sprite sprite;
+                sprite.mAtlasID = block.mAtlasID;
+                sprite.mShaderID = block.mShaderID;
+                sprite.mBlendMode = block.mBlendMode;
+                sprite.mPrimitiveType = block.mPrimitiveType;
+                sprite.mFirstVertex = mVertices.size();
+                sprite.mVertexCount = block.mVertexCount;
+                sprite.mDepth = 0;
+                sprites.push_back(sprite);
+                mVertices.insert(mVertices.end(), block.mVertices, block.mVertices + block.mVertexCount);
+            }
+
+            for (common::Entity* entity : entities)
+            {
+                if (entity->getEntityState() != common::Entity::ENTITYSTATE_ACTIVE)
+                    continue;
+
+                uint32_t firstInstance = mInstances.size();
+                bool instanced = entity->getSpriteInstances(mInstances);
+
+                utilities::Span<utilities::Vertex2* const> vertices;
+                if (instanced == false)
+                    vertices = entity->getVertices();
+
+                uint32_t vertexCount = instanced ? (mInstances.size() - firstInstance) * 4 : vertices.size();
+                if (vertexCount == 0)
+                    continue;
+
+                // Depths keep the top 24 bits of the order preserving key, the DrawList sorts by them
+                uint32_t depth = 0;
+                if (mLayers[l].mDepthSorted)
+                    depth = utilities::DepthSorter<common::Entity*>::toKey(layers[l]->getSortDepth(entity)) >> 8;
+
+                // Neighbouring entities with identical state extend the previous run, in sorted
+                // layers only at equal depth as the run is drawn at a single depth
+                if (sprites.empty() == false &&
+                    sprites.back().mDepth == depth &&
+                    sprites.back().mAtlasID == entity->mAtlasID &&
+                    sprites.back().mShaderID == entity->mShaderID &&
+                    sprites.back().mBlendMode == entity->mBlendMode &&
+                    sprites.back().mPrimitiveType == entity->mPrimitiveType)
+                {
+                    sprites.back().mVertexCount += vertexCount;
+                }
+                else
+                {
+                    Sprite sprite;
+                    sprite.mAtlasID = entity->mAtlasID;
+                    sprite.mShaderID = entity->mShaderID;
+                    sprite.mBlendMode = entity->mBlendMode;
+                    sprite.mPrimitiveType = entity->mPrimitiveType;
+                    sprite.mFirstVertex = mVertices.size();
+                    sprite.mVertexCount = vertexCount;
+                    sprite.mDepth = depth;
+                    sprites.push_back(sprite);
+                }
+
+                if (instanced)
+                {
+                    // Reserve the vertices now, every run is expanded together below
+                    Expansion expansion;
+                    expansion.mFirstInstance = firstInstance;
+                    expansion.mInstanceCount = mInstances.size() - firstInstance;
+                    expansion.mFirstVertex = mVertices.size();
+                    mExpansions.push_back(expansion);
+                    mVertices.resize(mVertices.size() + vertexCount);
+                }
+                else
+                {
+                    for (utilities::Vertex2* vertex : vertices)
+                        mVertices.push_back(RenderVertex(*vertex));
+                }
+            }
+        }
+
+        for (const Expansion& expansion : mExpansions)
+        {
+            SpriteExpander::expand(&mInstances[expansion.mFirstInstance], expansion.mInstanceCount,
+                                   &mVertices[expansion.mFirstVertex]);
+        }
+
+        if (lightingManager != nullptr)
+        {
+            mAmbientColour = lightingManager->getAmbientColour();
+            for (Light* light : lightingManager->getLights())
+                mLights.push_back(*light);
+        }
+
+        mInterpolation = utilities::DeltaTime::instance().getInterpolation();
+    }
+
+}}
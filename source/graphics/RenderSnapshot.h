@@ -0,0 +1,116 @@
+#include <array>
+#include <chrono>
+#include <vector>
+#include <stdint.h>
+#include "Light.h"
+#include "RenderVertex.h"
+#include "SpriteInstance.h"
+#include "../common/Layer.h"
+
+namespace liquid { namespace common { class GameScene; } }
+
+namespace liquid { namespace graphics {
+#ifndef _RENDERSNAPSHOT_H
+#define _RENDERSNAPSHOT_H
+
+/**
+ * \class RenderSnapshot
+ *
+ * \ingroup Graphics
+ * \brief Immutable copy of everything the Renderer needs to draw one frame
+ *
+ * Produced by the simulation once it has finished updating a frame and consumed
+ * by the Renderer, possibly on another thread, while the simulation moves on to
+ * the next frame. Nothing in a snapshot points back into the GameScene.
+ *
+ * Entities that publish common::Entity::getSpriteInstances() are stored as instances
+ * while capturing and expanded into mVertices by SpriteExpander once capture ends.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class LightingManager;
+class RenderSnapshot
+{
+public:
+    /// A run of vertices that share the same render state
+    class Sprite
+    {
+    public:
+        int32_t  mAtlasID;       ///< Texture atlas used, -1 for none
+        int32_t  mShaderID;      ///< Shader used, -1 for none
+        int32_t  mBlendMode;     ///< Blend mode used
+        int32_t  mPrimitiveType; ///< Primitive type of the vertices
+        uint32_t mFirstVertex;   ///< Index of the first vertex in mVertices
+        uint32_t mVertexCount;   ///< Number of vertices in this run
+        uint32_t mDepth;         ///< 24-bit depth within a depth sorted layer, 0 otherwise
+    };
+
+    /// The sprites of one common::Layer in draw order
+    class LayerSnapshot
+    {
+    public:
+        std::vector<Sprite> mSprites;      ///< Visible sprites of the layer
+        uint32_t            mVisibleCount; ///< Entities that passed culling
+        uint32_t            mCulledCount;  ///< Entities rejected by culling
+        bool                mDepthSorted;  ///< True if the sprites are drawn by mDepth, see common::Layer::setSortMode()
+    };
+
+    /// The state of the common::Camera when the snapshot was captured
+    class CameraSnapshot
+    {
+    public:
+        bool                 mValid;      ///< False if the scene had no Camera
+        std::array<float, 2> mCentre;     ///< Centre of the view, including any screenshake
+        std::array<float, 2> mDimensions; ///< Dimensions of the view, including any zoom
+        float                mRotation;   ///< Rotation of the view
+    };
+
+public:
+    /// RenderSnapshot Constructor
+    RenderSnapshot();
+
+    /// RenderSnapshot Destructor
+    ~RenderSnapshot();
+
+    /// \brief Empties the snapshot while keeping its allocations for reuse
+    void clear();
+
+    /** \brief Captures the visible contents of a GameScene
+      * \param gameScene Scene to capture, culled against its Camera
+      * \param lightingManager Lighting to capture, nullptr if none
+      */
+    void capture(common::GameScene* gameScene, LightingManager* lightingManager);
+
+public:
+    std::vector<LayerSnapshot> mLayers;        ///< Per-layer sprites in draw order
+    std::vector<RenderVertex>  mVertices;      ///< Vertex storage referenced by every Sprite
+    std::vector<Light>         mLights;        ///< Copies of the lights at capture time
+    std::array<float, 4>       mAmbientColour; ///< Ambient colour of the lighting
+    CameraSnapshot             mCamera;        ///< Camera at capture time
+    float                      mInterpolation; ///< Interpolation factor between simulation ticks
+    uint32_t                   mLayerCount;    ///< Number of entries of mLayers in use
+
+    std::chrono::steady_clock::time_point mCaptureTime; ///< When capture() started, the frame's latency is measured from here
+
+protected:
+    /// A run of instances of one Entity and the vertices reserved for them
+    class Expansion
+    {
+    public:
+        uint32_t mFirstInstance; ///< Index of the first instance in mInstances
+        uint32_t mInstanceCount; ///< Number of instances in this run
+        uint32_t mFirstVertex;   ///< Index of the first reserved vertex in mVertices
+    };
+
+    std::vector<SpriteInstance>               mInstances;  ///< Instances published during capture
+    std::vector<Expansion>                    mExpansions; ///< Instance runs still to be expanded
+    std::vector<common::Layer::GeometryBlock> mGeometry;   ///< Cached geometry of the layer being captured
+    std::vector<common::Entity*>              mQuery;      ///< Spatial query result of the layer being captured
+};
+
+#endif // _RENDERSNAPSHOT_H
+}}
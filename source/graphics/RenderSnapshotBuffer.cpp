@@ -0,0 +1,88 @@
+#include "RenderSnapshotBuffer.h"
+#include <algorithm>
+
+namespace liquid {
+namespace graphics {
+
+    RenderSnapshotBuffer::RenderSnapshotBuffer(uint32_t bufferCount)
+    {
+        bufferCount = std::max(std::min(bufferCount, 3u), 1u);
+        mShutdown = false;
+
+        for (uint32_t i = 0; i < bufferCount; i++)
+        {
+            mSnapshots.push_back(new RenderSnapshot());
+            mFree.push_back(mSnapshots.back());
+        }
+    }
+
+    RenderSnapshotBuffer::~RenderSnapshotBuffer()
+    {
+        for (RenderSnapshot* snapshot : mSnapshots)
+            delete snapshot;
+
+        mSnapshots.clear();
+    }
+
+    RenderSnapshot* RenderSnapshotBuffer::acquireWrite()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this]() { return mShutdown || mFree.empty() == false; });
+
+        if (mShutdown)
+            return nullptr;
+
+        RenderSnapshot* snapshot = mFree.back();
+        mFree.pop_back();
+        return snapshot;
+    }
+
+    void RenderSnapshotBuffer::publish(RenderSnapshot* snapshot)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mPublished.push_back(snapshot);
+        }
+
+        mCondition.notify_all();
+    }
+
+    RenderSnapshot* RenderSnapshotBuffer::acquireRead()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mCondition.wait(lock, [this]() { return mShutdown || mPublished.empty() == false; });
+
+        if (mPublished.empty())
+            return nullptr;
+
+        RenderSnapshot* snapshot = mPublished.front();
+        mPublished.pop_front();
+        return snapshot;
+    }
+
+    void RenderSnapshotBuffer::release(RenderSnapshot* snapshot)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mFree.push_back(snapshot);
+        }
+
+        mCondition.notify_all();
+    }
+
+    void RenderSnapshotBuffer::shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mShutdown = true;
+        }
+
+        mCondition.notify_all();
+    }
+
+    const uint32_t RenderSnapshotBuffer::getBufferCount() const
+    {
+        return mSnapshots.size();
+    }
+
+}}
@@ -0,0 +1,78 @@
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include "RenderSnapshot.h"
+
+namespace liquid { namespace graphics {
+#ifndef _RENDERSNAPSHOTBUFFER_H
+#define _RENDERSNAPSHOTBUFFER_H
+
+/**
+ * \class RenderSnapshotBuffer
+ *
+ * \ingroup Graphics
+ * \brief Hands RenderSnapshot objects from the simulation thread to the render thread
+ *
+ * Owns a small, fixed set of snapshots (one to three). The simulation writes into
+ * a free snapshot and publishes it, the render thread takes published snapshots in
+ * order and releases them once drawn. The writer blocks when every snapshot is in
+ * flight, which bounds how far the simulation can run ahead of the Renderer.
+ *
+ * With a single snapshot the simulation of the next frame still overlaps the draw of
+ * the previous one, but never gets further ahead, giving the lowest latency.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class RenderSnapshotBuffer
+{
+public:
+    /** \brief RenderSnapshotBuffer Constructor
+      * \param bufferCount Number of snapshots to cycle through, clamped to 1 - 3
+      */
+    RenderSnapshotBuffer(uint32_t bufferCount = 2);
+
+    /// RenderSnapshotBuffer Destructor
+    ~RenderSnapshotBuffer();
+
+    /** \brief Waits for a snapshot that is free to be written
+      * \return Snapshot to write into, nullptr once shut down
+      */
+    RenderSnapshot* acquireWrite();
+
+    /** \brief Queues a written snapshot for the render thread
+      * \param snapshot Snapshot previously returned by acquireWrite()
+      */
+    void publish(RenderSnapshot* snapshot);
+
+    /** \brief Waits for the oldest published snapshot
+      * \return Snapshot to draw, nullptr once shut down and drained
+      */
+    RenderSnapshot* acquireRead();
+
+    /** \brief Returns a drawn snapshot so it can be written again
+      * \param snapshot Snapshot previously returned by acquireRead()
+      */
+    void release(RenderSnapshot* snapshot);
+
+    /// \brief Wakes up both threads and stops handing out snapshots
+    void shutdown();
+
+    /// \return Number of snapshots cycled through
+    const uint32_t getBufferCount() const;
+
+protected:
+    std::vector<RenderSnapshot*> mSnapshots; ///< Every snapshot owned by this buffer
+    std::vector<RenderSnapshot*> mFree;      ///< Snapshots that can be written
+    std::deque<RenderSnapshot*>  mPublished; ///< Snapshots waiting to be drawn, oldest first
+    std::mutex                   mMutex;     ///< Guards mFree, mPublished and mShutdown
+    std::condition_variable      mCondition; ///< Signalled whenever a snapshot changes hands
+    bool                         mShutdown;  ///< Set once the buffer should stop blocking
+};
+
+#endif // _RENDERSNAPSHOTBUFFER_H
+}}
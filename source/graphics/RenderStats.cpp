@@ -0,0 +1,311 @@
+#include "RenderStats.h"
+
+namespace liquid {
+namespace graphics {
+
+    RenderStats::RenderStats()
+    {
+        mPhase = PHASE_NONE;
+        mFrameCount = 0;
+        mHistorySize = 300;
+        mExportFile = nullptr;
+        mExportFormat = EXPORT_CSV;
+
+        mCurrent.mFrame = 0;
+        mCurrent.mBatches = 0;
+        mCurrent.mDrawCalls = 0;
+        mCurrent.mVertices = 0;
+        mCurrent.mTextureSwitches = 0;
+        mCurrent.mPhaseTimes.fill(0.0f);
+        mCurrent.mFrameTime = 0.0f;
+        mCurrent.mLatency = 0.0f;
+        mCurrent.mLightsConsidered = 0;
+        mCurrent.mLightsCulled = 0;
+        mCurrent.mLightsDrawn = 0;
+        mLast = mCurrent;
+    }
+
+    RenderStats::~RenderStats()
+    {
+        setExportFile("", EXPORT_CSV);
+    }
+
+    void RenderStats::beginFrame(uint32_t layerCount)
+    {
+        LayerStats empty = { 0, 0 };
+        mCurrent.mFrame = mFrameCount++;
+        mCurrent.mLayers.assign(layerCount, empty);
+        mCurrent.mBatches = 0;
+        mCurrent.mDrawCalls = 0;
+        mCurrent.mVertices = 0;
+        mCurrent.mTextureSwitches = 0;
+        mCurrent.mPhaseTimes.fill(0.0f);
+        mCurrent.mLatency = 0.0f;
+        mCurrent.mLightsConsidered = 0;
+        mCurrent.mLightsCulled = 0;
+        mCurrent.mLightsDrawn = 0;
+
+        mPhase = PHASE_NONE;
+        mFrameStart = Clock::now();
+    }
+
+    void RenderStats::endFrame()
+    {
+        beginPhase(PHASE_NONE);
+        mCurrent.mFrameTime = std::chrono::duration<float, std::milli>(Clock::now() - mFrameStart).count();
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mLast = mCurrent;
+
+        if (mHistorySize > 0)
+        {
+            // Once full the oldest record is reused, so its vectors keep their memory
+            if (mHistory.size() >= mHistorySize)
+            {
+                FrameStats recycled = std::move(mHistory.front());
+                mHistory.pop_front();
+                recycled = mCurrent;
+                mHistory.push_back(std::move(recycled));
+            }
+            else
+                mHistory.push_back(mCurrent);
+        }
+
+        if (mExportFile != nullptr)
+        {
+            writeFrame(mExportFile, mCurrent, mExportFormat);
+            std::fflush(mExportFile);
+        }
+    }
+
+    void RenderStats::beginPhase(ePhase phase)
+    {
+        if (phase == mPhase)
+            return;
+
+        Clock::time_point now = Clock::now();
+        if (mPhase != PHASE_NONE)
+            mCurrent.mPhaseTimes[mPhase] += std::chrono::duration<float, std::milli>(now - mPhaseStart).count();
+
+        mPhase = phase;
+        mPhaseStart = now;
+    }
+
+    void RenderStats::setLayer(uint32_t layer, uint32_t visible, uint32_t culled)
+    {
+        if (layer >= mCurrent.mLayers.size())
+            return;
+
+        mCurrent.mLayers[layer].mVisible = visible;
+        mCurrent.mLayers[layer].mCulled = culled;
+    }
+
+    void RenderStats::countBatch()
+    {
+        mCurrent.mBatches++;
+    }
+
+    void RenderStats::countDrawCall(uint32_t vertexCount)
+    {
+        mCurrent.mDrawCalls++;
+        mCurrent.mVertices += vertexCount;
+    }
+
+    void RenderStats::countTextureSwitch()
+    {
+        mCurrent.mTextureSwitches++;
+    }
+
+    void RenderStats::setLatency(float latency)
+    {
+        mCurrent.mLatency = latency;
+    }
+
+    void RenderStats::setLights(uint32_t considered, uint32_t culled, uint32_t drawn)
+    {
+        mCurrent.mLightsConsidered = considered;
+        mCurrent.mLightsCulled = culled;
+        mCurrent.mLightsDrawn = drawn;
+    }
+
+    void RenderStats::setHistorySize(uint32_t frames)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mHistorySize = frames;
+
+        while (mHistory.size() > mHistorySize)
+            mHistory.pop_front();
+    }
+
+    bool RenderStats::setExportFile(std::string file, eExportFormat format)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mExportFile != nullptr)
+        {
+            std::fclose(mExportFile);
+            mExportFile = nullptr;
+        }
+
+        if (file.empty())
+            return true;
+
+        mExportFile = std::fopen(file.c_str(), "w");
+        mExportFormat = format;
+        if (mExportFile == nullptr)
+            return false;
+
+        if (format == EXPORT_CSV)
+            writeHeader(mExportFile);
+
+        return true;
+    }
+
+    bool RenderStats::exportHistory(std::string file, eExportFormat format) const
+    {
+        FILE* handle = std::fopen(file.c_str(), "w");
+        if (handle == nullptr)
+            return false;
+
+        if (format == EXPORT_CSV)
+            writeHeader(handle);
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (const FrameStats& frame : mHistory)
+                writeFrame(handle, frame, format);
+        }
+
+        return std::fclose(handle) == 0;
+    }
+
+    RenderStats::FrameStats RenderStats::getLastFrame() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mLast;
+    }
+
+    std::vector<RenderStats::FrameStats> RenderStats::getHistory() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return std::vector<FrameStats>(mHistory.begin(), mHistory.end());
+    }
+
+    const uint32_t RenderStats::getLastBatches() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mLast.mBatches;
+    }
+
+    const uint32_t RenderStats::getLastDrawCalls() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mLast.mDrawCalls;
+    }
+
+    const uint32_t RenderStats::getLastVertices() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mLast.mVertices;
+    }
+
+    const uint32_t RenderStats::getLastTextureSwitches() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mLast.mTextureSwitches;
+    }
+
+    const float RenderStats::getLastFrameTime() const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mLast.mFrameTime;
+    }
+
+    const float RenderStats::getLastPhaseTime(ePhase phase) const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mLast.mPhaseTimes[phase];
+    }
+
+    const RenderStats::LayerStats RenderStats::getLastLayer(uint32_t layer) const
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (layer < mLast.mLayers.size())
+            return mLast.mLayers[layer];
+
+        LayerStats empty;
+        empty.mVisible = empty.mCulled = 0;
+        return empty;
+    }
+
+    const char* RenderStats::getPhaseName(ePhase phase)
+    {
+        switch (phase)
+        {
+        case PHASE_PREPROCESS:
+            return "preprocess";
+        case PHASE_BATCH:
+            return "batch";
+        case PHASE_LIGHTING:
+            return "lighting";
+        case PHASE_POSTPROCESS:
+            return "postprocess";
+        case PHASE_PRESENT:
+            return "present";
+        default:
+            return "none";
+        }
+    }
+
+    void RenderStats::writeFrame(FILE* handle, const FrameStats& frame, eExportFormat format)
+    {
+        uint32_t visible = 0, culled = 0;
+        for (const LayerStats& layer : frame.mLayers)
+        {
+            visible += layer.mVisible;
+            culled += layer.mCulled;
+        }
+
+        if (format == EXPORT_CSV)
+        {
+            // Layers vary between scenes, so only their totals get a column
+            std::fprintf(handle, "%llu,%u,%u,%u,%u,%u,%u", (unsigned long long)frame.mFrame, frame.mBatches,
+                         frame.mDrawCalls, frame.mVertices, frame.mTextureSwitches, visible, culled);
+
+            for (uint32_t p = 0; p < PHASE_COUNT; p++)
+                std::fprintf(handle, ",%.4f", frame.mPhaseTimes[p]);
+
+            std::fprintf(handle, ",%.4f,%.4f,%u,%u,%u\n", frame.mFrameTime, frame.mLatency,
+                         frame.mLightsConsidered, frame.mLightsCulled, frame.mLightsDrawn);
+            return;
+        }
+
+        std::fprintf(handle, "{\"frame\":%llu,\"batches\":%u,\"draw_calls\":%u,\"vertices\":%u,\"texture_switches\":%u,"
+                     "\"visible\":%u,\"culled\":%u,\"frame_ms\":%.4f,\"latency_ms\":%.4f,"
+                     "\"lights\":{\"considered\":%u,\"culled\":%u,\"drawn\":%u},\"phases_ms\":{",
+                     (unsigned long long)frame.mFrame, frame.mBatches, frame.mDrawCalls, frame.mVertices,
+                     frame.mTextureSwitches, visible, culled, frame.mFrameTime, frame.mLatency,
+                     frame.mLightsConsidered, frame.mLightsCulled, frame.mLightsDrawn);
+
+        for (uint32_t p = 0; p < PHASE_COUNT; p++)
+            std::fprintf(handle, "%s\"%s\":%.4f", (p == 0) ? "" : ",", getPhaseName((ePhase)p), frame.mPhaseTimes[p]);
+
+        std::fprintf(handle, "},\"layers\":[");
+        for (uint32_t l = 0; l < frame.mLayers.size(); l++)
+        {
+            std::fprintf(handle, "%s{\"visible\":%u,\"culled\":%u}", (l == 0) ? "" : ",",
+                         frame.mLayers[l].mVisible, frame.mLayers[l].mCulled);
+        }
+
+        std::fprintf(handle, "]}\n");
+    }
+
+    void RenderStats::writeHeader(FILE* handle)
+    {
+        std::fprintf(handle, "frame,batches,draw_calls,vertices,texture_switches,visible,culled");
+        for (uint32_t p = 0; p < PHASE_COUNT; p++)
+            std::fprintf(handle, ",%s_ms", getPhaseName((ePhase)p));
+
+        std::fprintf(handle, ",frame_ms,latency_ms,lights_considered,lights_culled,lights_drawn\n");
+    }
+
+}}
@@ -0,0 +1,220 @@
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace liquid { namespace graphics {
+#ifndef _RENDERSTATS_H
+#define _RENDERSTATS_H
+
+/**
+ * \class RenderStats
+ *
+ * \ingroup Graphics
+ * \brief Per-frame draw statistics and CPU phase timings of a Renderer
+ *
+ * The Renderer fills one FrameStats between beginFrame() and endFrame() on the thread
+ * that draws. Phases are timed by switching between them with beginPhase(), which only
+ * reads the clock when the phase actually changes, so it is cheap to call per command.
+ *
+ * Finished frames are kept in a rolling history and can be streamed to a file as CSV or
+ * as one JSON object per line, for dashboards that tail the file. getLastFrame() and
+ * getHistory() return copies and are safe to call from any thread, as are the getters of
+ * single values of the last frame, which copy nothing else.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class RenderStats
+{
+public:
+    /// CPU phases of a frame
+    enum ePhase
+    {
+        PHASE_PREPROCESS = 0,
+        PHASE_BATCH = 1,
+        PHASE_LIGHTING = 2,
+        PHASE_POSTPROCESS = 3,
+        PHASE_PRESENT = 4,
+        PHASE_COUNT = 5,
+        PHASE_NONE = 6,
+    };
+
+    /// Format written by setExportFile() and exportHistory()
+    enum eExportFormat
+    {
+        EXPORT_CSV = 0,
+        EXPORT_JSON = 1,
+    };
+
+    /// Culling result of one Layer
+    struct LayerStats
+    {
+        uint32_t mVisible; ///< Entities that passed culling
+        uint32_t mCulled;  ///< Entities rejected by culling
+    };
+
+    /// Everything measured during one frame
+    struct FrameStats
+    {
+        uint64_t                       mFrame;            ///< Index of the frame
+        std::vector<LayerStats>        mLayers;           ///< Culling result of every Layer
+        uint32_t                       mBatches;          ///< Distinct render states drawn
+        uint32_t                       mDrawCalls;        ///< Draw calls submitted
+        uint32_t                       mVertices;         ///< Vertices submitted
+        uint32_t                       mTextureSwitches;  ///< Times the bound texture changed
+        std::array<float, PHASE_COUNT> mPhaseTimes;       ///< Milliseconds spent in every ePhase
+        float                          mFrameTime;        ///< Milliseconds from beginFrame() to endFrame()
+        float                          mLatency;          ///< Milliseconds from capturing the frame to presenting it, 0 if unknown
+        uint32_t                       mLightsConsidered; ///< Lights tested against the camera
+        uint32_t                       mLightsCulled;     ///< Lights rejected by culling
+        uint32_t                       mLightsDrawn;      ///< Lights accumulated
+    };
+
+public:
+    /// RenderStats Constructor
+    RenderStats();
+
+    /// RenderStats Destructor, closes the export file
+    ~RenderStats();
+
+    /** \brief Starts measuring a frame
+      * \param layerCount Number of Layers drawn, their stats start at zero
+      */
+    void beginFrame(uint32_t layerCount);
+
+    /// \brief Finishes the frame, adds it to the history and the export file
+    void endFrame();
+
+    /** \brief Ends the running phase and starts another
+      * \param phase Phase to start, PHASE_NONE to stop timing
+      */
+    void beginPhase(ePhase phase);
+
+    /** \brief Sets the culling result of a Layer
+      * \param layer Index of the Layer
+      * \param visible Entities that passed culling
+      * \param culled Entities rejected by culling
+      */
+    void setLayer(uint32_t layer, uint32_t visible, uint32_t culled);
+
+    /// \brief Counts a render state change
+    void countBatch();
+
+    /** \brief Counts a draw call
+      * \param vertexCount Vertices it submitted
+      */
+    void countDrawCall(uint32_t vertexCount);
+
+    /// \brief Counts a change of the bound texture
+    void countTextureSwitch();
+
+    /** \brief Sets the latency of the frame
+      * \param latency Milliseconds from capturing the frame to presenting it
+      */
+    void setLatency(float latency);
+
+    /** \brief Sets the light culling result of the frame
+      * \param considered Lights tested against the camera
+      * \param culled Lights rejected by culling
+      * \param drawn Lights accumulated
+      */
+    void setLights(uint32_t considered, uint32_t culled, uint32_t drawn);
+
+    /** \brief Sets how many finished frames are kept
+      * \param frames Frames kept, the oldest are dropped first
+      */
+    void setHistorySize(uint32_t frames);
+
+    /** \brief Streams every finished frame to a file, replacing any previous one
+      * \param file Path of the file, truncated, an empty string stops exporting
+      * \param format Format of the rows
+      * \return True if the file was opened
+      */
+    bool setExportFile(std::string file, eExportFormat format);
+
+    /** \brief Writes the current history to a file
+      * \param file Path of the file
+      * \param format Format of the rows
+      * \return True if the file was written
+      */
+    bool exportHistory(std::string file, eExportFormat format) const;
+
+    /// \return Copy of the last finished frame
+    FrameStats getLastFrame() const;
+
+    /// \return Copy of the finished frames, oldest first
+    std::vector<FrameStats> getHistory() const;
+
+    /// \return Distinct render states drawn in the last finished frame
+    const uint32_t getLastBatches() const;
+
+    /// \return Draw calls submitted in the last finished frame
+    const uint32_t getLastDrawCalls() const;
+
+    /// \return Vertices submitted in the last finished frame
+    const uint32_t getLastVertices() const;
+
+    /// \return Times the bound texture changed in the last finished frame
+    const uint32_t getLastTextureSwitches() const;
+
+    /// \return Milliseconds the last finished frame took
+    const float getLastFrameTime() const;
+
+    /** \brief Gets the time the last finished frame spent in a phase
+      * \param phase Phase to look up, below PHASE_COUNT
+      * \return Milliseconds spent in the phase
+      */
+    const float getLastPhaseTime(ePhase phase) const;
+
+    /** \brief Gets the culling result of a Layer in the last finished frame
+      * \param layer Index of the Layer
+      * \return Culling result, zero for a Layer that was not drawn
+      */
+    const LayerStats getLastLayer(uint32_t layer) const;
+
+    /** \brief Gets the name of a phase as used by the exports
+      * \param phase Phase to name
+      * \return Lower case name, "none" for PHASE_NONE
+      */
+    static const char* getPhaseName(ePhase phase);
+
+protected:
+    /** \brief Writes one frame to a file
+      * \param handle File to write to
+      * \param frame Frame to write
+      * \param format Format of the row
+      */
+    static void writeFrame(FILE* handle, const FrameStats& frame, eExportFormat format);
+
+    /** \brief Writes the CSV column names
+      * \param handle File to write to
+      */
+    static void writeHeader(FILE* handle);
+
+protected:
+    typedef std::chrono::high_resolution_clock Clock;
+
+    FrameStats             mCurrent;      ///< Frame being measured
+    FrameStats             mLast;         ///< Last finished frame, guarded by mMutex
+    ePhase                 mPhase;        ///< Phase being timed, PHASE_NONE if none
+    Clock::time_point      mPhaseStart;   ///< When mPhase started
+    Clock::time_point      mFrameStart;   ///< When the frame started
+    uint64_t               mFrameCount;   ///< Frames started so far
+
+    mutable std::mutex     mMutex;        ///< Guards mLast, mHistory, mHistorySize and the export file
+    std::deque<FrameStats> mHistory;      ///< Finished frames, oldest first
+    uint32_t               mHistorySize;  ///< Frames kept in mHistory
+    FILE*                  mExportFile;   ///< File finished frames are streamed to, nullptr if none
+    eExportFormat          mExportFormat; ///< Format of mExportFile
+};
+
+#endif // _RENDERSTATS_H
+}}
@@ -0,0 +1,65 @@
+#include "../utilities/Vertex2.h"
+#include <stdint.h>
+
+namespace liquid { namespace graphics {
+#ifndef _RENDERVERTEX_H
+#define _RENDERVERTEX_H
+
+/**
+ * \class RenderVertex
+ *
+ * \ingroup Graphics
+ * \brief Plain, backend-neutral vertex that is cheap to copy between threads
+ *
+ * The layout (position, RGBA8 colour, texture coordinate) deliberately matches
+ * the vertex layouts of the common 2D backends so implementations can submit
+ * arrays of RenderVertex without converting them first.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class RenderVertex
+{
+public:
+    /// RenderVertex Constructor
+    RenderVertex()
+    {
+        mPositionX = 0.0f;
+        mPositionY = 0.0f;
+        mColour[0] = mColour[1] = mColour[2] = mColour[3] = 255;
+        mTexCoordX = 0.0f;
+        mTexCoordY = 0.0f;
+    }
+
+    /** \brief RenderVertex Constructor
+      * \param vertex utilities::Vertex2 to flatten into this RenderVertex
+      */
+    RenderVertex(const utilities::Vertex2& vertex)
+    {
+        std::array<float, 2> position = vertex.getPosition();
+        std::array<float, 4> colour = vertex.getColour();
+        std::array<float, 2> texCoord = vertex.getTexCoord();
+
+        mPositionX = position[0];
+        mPositionY = position[1];
+        mColour[0] = (uint8_t)colour[0];
+        mColour[1] = (uint8_t)colour[1];
+        mColour[2] = (uint8_t)colour[2];
+        mColour[3] = (uint8_t)colour[3];
+        mTexCoordX = texCoord[0];
+        mTexCoordY = texCoord[1];
+    }
+
+public:
+    float   mPositionX; ///< Position of the vertex on the X-Axis
+    float   mPositionY; ///< Position of the vertex on the Y-Axis
+    uint8_t mColour[4]; ///< Colour of the vertex (r,g,b,a) as 0 - 255
+    float   mTexCoordX; ///< Texture coordinate on the X-Axis in pixels
+    float   mTexCoordY; ///< Texture coordinate on the Y-Axis in pixels
+};
+
+#endif // _RENDERVERTEX_H
+}}
@@ -7,6 +7,9 @@ namespace graphics {
     Renderer::Renderer(data::Settings* settings)
     {
         mSettings = settings;
+        mLightingManager = nullptr;
+        mBatchCount = 0;
+        mVertexCount = 0;
     }
 
     Renderer::~Renderer()
@@ -27,15 +30,54 @@ namespace graphics {
     void Renderer::draw(common::GameScene* gameScene)
     {
         if (mLightingManager != nullptr)
+        {
+            mStats.beginPhase(RenderStats::PHASE_LIGHTING);
+            mLightingManager->updateShadows();
             mLightingManager->draw(this);
+        }
 
-        for (auto proc : mPostProcessors)
+        executePostProcess();
+    }
+
+    void Renderer::captureSnapshot(common::GameScene* gameScene, RenderSnapshot& snapshot)
+    {
+        // Shadows are cut on the simulation thread, the snapshot copies them with the lights
+        if (mLightingManager != nullptr)
+            mLightingManager->updateShadows();
+
+        snapshot.capture(gameScene, mLightingManager);
+    }
+
+    void Renderer::drawSnapshot(const RenderSnapshot& snapshot)
+    {
+        mStats.beginFrame(snapshot.mLayerCount);
+        for (uint32_t l = 0; l < snapshot.mLayerCount; l++)
+            mStats.setLayer(l, snapshot.mLayers[l].mVisibleCount, snapshot.mLayers[l].mCulledCount);
+
+        mStats.beginPhase(RenderStats::PHASE_PREPROCESS);
+        mCommandBuffer.record(snapshot);
+        execute(mCommandBuffer);
+
+        // Includes the time the snapshot spent queued for the render thread
+        mStats.setLatency(std::chrono::duration<float, std::milli>(
+            std::chrono::steady_clock::now() - snapshot.mCaptureTime).count());
+        mStats.endFrame();
+    }
+
+    void Renderer::execute(const RenderCommandBuffer& commands)
+    {
+        for (const RenderCommandBuffer::Command& command : commands.getCommands())
         {
-            proc->update();
-            proc->process();
+            if (command.mType == RenderCommandBuffer::COMMAND_LIGHTING)
+                executeLighting(commands, command);
+            else if (command.mType == RenderCommandBuffer::COMMAND_POSTPROCESS)
+                executePostProcess();
         }
     }
 
+    void Renderer::setRenderThreadActive(bool /*active*/)
+    {}
+
     void Renderer::addPostProcessor(PostProcessor* postProcessor)
     {
         postProcessor->setRendererPtr(this);
@@ -110,4 +152,44 @@ namespace graphics {
         return mLightingManager;
     }
 
+    RenderStats& Renderer::getStats()
+    {
+        return mStats;
+    }
+
+    const RenderCommandBuffer& Renderer::getCommandBuffer() const
+    {
+        return mCommandBuffer;
+    }
+
+    const uint32_t Renderer::getBatchCount() const
+    {
+        return mBatchCount;
+    }
+
+    const uint32_t Renderer::getVertexCount() const
+    {
+        return mVertexCount;
+    }
+
+    void Renderer::executeLighting(const RenderCommandBuffer& commands, const RenderCommandBuffer::Command& command)
+    {
+        if (mLightingManager == nullptr)
+            return;
+
+        mStats.beginPhase(RenderStats::PHASE_LIGHTING);
+        const RenderCommandBuffer::LightingPass& pass = commands.getLightingPasses()[command.mArgument];
+        mLightingManager->drawLights(this, pass.mAmbientColour, commands.getLights().data() + pass.mFirstLight, pass.mLightCount);
+    }
+
+    void Renderer::executePostProcess()
+    {
+        mStats.beginPhase(RenderStats::PHASE_POSTPROCESS);
+        for (auto proc : mPostProcessors)
+        {
+            proc->update();
+            proc->process();
+        }
+    }
+
 }}
@@ -4,6 +4,9 @@
 #include "../common/GameScene.h"
 #include "../data/Settings.h"
 #include "../graphics/LightingManager.h"
+#include "../graphics/RenderCommandBuffer.h"
+#include "../graphics/RenderStats.h"
+#include "../graphics/RenderSnapshot.h"
 #include "IRenderable.h"
 
 namespace liquid { namespace graphics {
@@ -47,6 +50,34 @@ public:
     /// \brief Called every frame to draw everything to the Screen
     virtual void draw(common::GameScene* gameScene);
 
+    /** \brief Copies what draw() would use out of the GameScene, called from the simulation thread
+      * \param gameScene Scene to capture
+      * \param snapshot Snapshot to fill, previous contents are discarded
+      */
+    virtual void captureSnapshot(common::GameScene* gameScene, RenderSnapshot& snapshot);
+
+    /** \brief Draws a previously captured RenderSnapshot, safe to call from the render thread
+      * \param snapshot Snapshot to draw
+      *
+      * Records the snapshot into the RenderCommandBuffer returned by getCommandBuffer()
+      * and hands it to execute(), measuring the frame in getStats().
+      */
+    virtual void drawSnapshot(const RenderSnapshot& snapshot);
+
+    /** \brief Draws a frame from its commands, safe to call from the render thread
+      * \param commands Commands recorded by RenderCommandBuffer::record() or loaded from a file
+      *
+      * The default runs the lighting and post processing passes and ignores the rest,
+      * backends override it to draw. Counts go to the frame getStats() is measuring,
+      * a replay that calls this directly brackets it with beginFrame() and endFrame().
+      */
+    virtual void execute(const RenderCommandBuffer& commands);
+
+    /** \brief Binds or unbinds the Renderer's context to the calling thread
+      * \param active True to bind to the calling thread, false to release it
+      */
+    virtual void setRenderThreadActive(bool active);
+
     /** \brief Adds a PostProcessor effect to the Renderer
       * \param postProcessor Pointer to post processor to add
       */
@@ -88,11 +119,37 @@ public:
 
     graphics::LightingManager* getLightingManager();
 
+    /// \return Statistics and phase timings of the frames drawn
+    RenderStats& getStats();
+
+    /// \return Commands recorded by the last drawSnapshot()
+    const RenderCommandBuffer& getCommandBuffer() const;
+
+    /// \return Number of batches (draw calls) submitted by the last frame
+    const uint32_t getBatchCount() const;
+
+    /// \return Number of vertices submitted by the last frame
+    const uint32_t getVertexCount() const;
+
+protected:
+    /** \brief Runs a LIGHTING command through the LightingManager
+      * \param commands Buffer the command belongs to
+      * \param command Command to run
+      */
+    void executeLighting(const RenderCommandBuffer& commands, const RenderCommandBuffer::Command& command);
+
+    /// \brief Runs a POSTPROCESS command through every PostProcessor
+    void executePostProcess();
+
 protected:
     std::list<IRenderable*>    mRenderables;     ///< Collection of Renderable objects to be drawn every frame
     std::list<PostProcessor*>  mPostProcessors;  ///< Collection of PostProcessor objects to apply
     graphics::LightingManager* mLightingManager; ///< Pointer to the lighting::LightingManager
     data::Settings*            mSettings;        ///< Settings of the game
+    uint32_t                   mBatchCount;      ///< Draw calls submitted by the last frame
+    uint32_t                   mVertexCount;     ///< Vertices submitted by the last frame
+    RenderCommandBuffer        mCommandBuffer;   ///< Commands of the last snapshot drawn
+    RenderStats                mStats;           ///< Statistics of the frames drawn
 };
 
 #endif // _RENDERER_H
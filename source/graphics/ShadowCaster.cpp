@@ -0,0 +1,419 @@
+#include "ShadowCaster.h"
+#include "../common/Layer.h"
+#include "../utilities/ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace liquid {
+namespace graphics {
+
+    ShadowCaster::ShadowCaster()
+    {
+        mLayer = nullptr;
+        mEntityType = -1;
+        mFrame = 0;
+        mGatherStamp = 0;
+        mRecomputed = 0;
+        mUpdateTime = 0.0f;
+    }
+
+    ShadowCaster::~ShadowCaster()
+    {}
+
+    void ShadowCaster::setOccluderLayer(common::Layer* layer, int32_t entityType)
+    {
+        mLayer = layer;
+        mEntityType = entityType;
+    }
+
+    void ShadowCaster::addOccluder(std::array<float, 4> segment)
+    {
+        int32_t x1 = (int32_t)std::floor(std::min(segment[0], segment[2]) / OCCLUDER_CELL_SIZE);
+        int32_t y1 = (int32_t)std::floor(std::min(segment[1], segment[3]) / OCCLUDER_CELL_SIZE);
+        int32_t x2 = (int32_t)std::floor(std::max(segment[0], segment[2]) / OCCLUDER_CELL_SIZE);
+        int32_t y2 = (int32_t)std::floor(std::max(segment[1], segment[3]) / OCCLUDER_CELL_SIZE);
+
+        for (int32_t y = y1; y <= y2; y++)
+        {
+            for (int32_t x = x1; x <= x2; x++)
+                mOccluderCells[((uint64_t)(uint32_t)y << 32) | (uint32_t)x].push_back(mOccluders.size());
+        }
+
+        mOccluders.push_back(segment);
+        mOccluderStamps.push_back(0);
+    }
+
+    void ShadowCaster::clearOccluders()
+    {
+        mOccluders.clear();
+        mOccluderCells.clear();
+        mOccluderStamps.clear();
+    }
+
+    void ShadowCaster::update(utilities::Span<Light* const> lights)
+    {
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        mFrame++;
+        mDirty.clear();
+
+        // Gathering reads the Layer so it stays on this thread, only the sweeps run in parallel
+        for (Light* light : lights)
+        {
+            std::pair<std::unordered_map<const Light*, CachedShadow>::iterator, bool> inserted =
+                mShadows.emplace(light, CachedShadow());
+
+            CachedShadow& shadow = inserted.first->second;
+            if (inserted.second)
+                shadow.mDirty = true;
+
+            shadow.mFrame = mFrame;
+            gatherOccluders(*light, mGathered);
+
+            // FNV-1a over the raw coordinates, any occluder moving in reach changes it
+            uint64_t signature = 14695981039346656037ull ^ mGathered.size();
+            for (const std::array<float, 4>& segment : mGathered)
+            {
+                uint32_t bits[4];
+                std::memcpy(bits, segment.data(), sizeof(bits));
+                for (uint32_t b : bits)
+                    signature = (signature ^ b) * 1099511628211ull;
+            }
+
+            const std::vector<RenderVertex>* look = light->getLightMesh().get();
+            if (shadow.mDirty || shadow.mSignature != signature || shadow.mLook != look ||
+                shadow.mPosition != light->getLightPosition())
+            {
+                shadow.mPosition = light->getLightPosition();
+                shadow.mLook = look;
+                shadow.mSignature = signature;
+                shadow.mSegments.swap(mGathered);
+                shadow.mDirty = true;
+                mDirty.push_back(std::make_pair(light, &shadow));
+            }
+        }
+
+        utilities::ThreadPool::instance().parallelFor(mDirty.size(), [this](uint32_t i) {
+            buildShadow(*mDirty[i].first, *mDirty[i].second);
+        });
+
+        for (std::pair<Light*, CachedShadow*>& dirty : mDirty)
+        {
+            dirty.first->setShadowGeometry(dirty.second->mMesh);
+            dirty.second->mDirty = false;
+        }
+
+        // Lights that were removed are forgotten, a new light at the same address starts dirty
+        for (std::unordered_map<const Light*, CachedShadow>::iterator it = mShadows.begin(); it != mShadows.end();)
+        {
+            if (it->second.mFrame != mFrame)
+                it = mShadows.erase(it);
+            else
+                ++it;
+        }
+
+        mRecomputed = mDirty.size();
+        mUpdateTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    void ShadowCaster::invalidate()
+    {
+        for (auto& shadow : mShadows)
+            shadow.second.mDirty = true;
+    }
+
+    const uint32_t ShadowCaster::getRecomputedCount() const
+    {
+        return mRecomputed;
+    }
+
+    const float ShadowCaster::getUpdateTime() const
+    {
+        return mUpdateTime;
+    }
+
+    void ShadowCaster::computeVisibility(std::array<float, 2> position, float radius, uint32_t rimPoints,
+                                         const std::vector<std::array<float, 4>>& segments,
+                                         std::vector<std::array<float, 2>>& polygon)
+    {
+        /// Start or end of a segment as seen from the light
+        struct Event
+        {
+            float    mAngle;   ///< Angle of the endpoint around the light
+            float    mX;       ///< Endpoint relative to the light on the X-Axis
+            float    mY;       ///< Endpoint relative to the light on the Y-Axis
+            uint32_t mSegment; ///< Index of the segment, CROSSING where two segments cross
+            bool     mInsert;  ///< True if the sweep enters the segment here
+        };
+
+        const uint32_t CROSSING = UINT32_MAX;
+
+        polygon.clear();
+        rimPoints = std::max(rimPoints, 3u);
+
+        // Everything is relative to the light, the rim closes the sweep in every direction
+        std::vector<std::array<float, 4>> local;
+        local.reserve(rimPoints + segments.size());
+        for (uint32_t i = 0; i < rimPoints; i++)
+        {
+            float angle1 = 6.28318530718f * ((float)i / (float)rimPoints);
+            float angle2 = 6.28318530718f * ((float)(i + 1) / (float)rimPoints);
+            local.push_back({ radius * std::cos(angle1), radius * std::sin(angle1),
+                              radius * std::cos(angle2), radius * std::sin(angle2) });
+        }
+
+        for (const std::array<float, 4>& segment : segments)
+        {
+            local.push_back({ segment[0] - position[0], segment[1] - position[1],
+                              segment[2] - position[0], segment[3] - position[1] });
+        }
+
+        std::vector<Event> events;
+        std::vector<uint32_t> active;
+        events.reserve(local.size() * 2);
+
+        for (uint32_t s = 0; s < local.size(); s++)
+        {
+            std::array<float, 4>& segment = local[s];
+            float cross = segment[0] * segment[3] - segment[1] * segment[2];
+            if (cross == 0.0f)
+                continue;
+
+            // Ordered counter-clockwise, so the sweep enters at the first point
+            if (cross < 0.0f)
+                segment = { segment[2], segment[3], segment[0], segment[1] };
+
+            float angle1 = std::atan2(segment[1], segment[0]);
+            float angle2 = std::atan2(segment[3], segment[2]);
+            events.push_back({ angle1, segment[0], segment[1], s, true });
+            events.push_back({ angle2, segment[2], segment[3], s, false });
+
+            // Crosses the start of the sweep, so it is already entered
+            if (angle2 < angle1)
+                active.push_back(s);
+        }
+
+        // The nearest segment can also change where two segments cross, those angles are swept too
+        for (uint32_t a = rimPoints; a < local.size(); a++)
+        {
+            const std::array<float, 4>& segmentA = local[a];
+            for (uint32_t b = 0; b < a; b++)
+            {
+                const std::array<float, 4>& segmentB = local[b];
+                float ax = segmentA[2] - segmentA[0], ay = segmentA[3] - segmentA[1];
+                float bx = segmentB[2] - segmentB[0], by = segmentB[3] - segmentB[1];
+                float denominator = ax * by - ay * bx;
+                if (denominator == 0.0f)
+                    continue;
+
+                float ox = segmentB[0] - segmentA[0], oy = segmentB[1] - segmentA[1];
+                float u = (ox * by - oy * bx) / denominator;
+                float v = (ox * ay - oy * ax) / denominator;
+                if (u <= 0.0f || u >= 1.0f || v <= 0.0f || v >= 1.0f)
+                    continue;
+
+                float x = segmentA[0] + ax * u;
+                float y = segmentA[1] + ay * u;
+                events.push_back({ std::atan2(y, x), x, y, CROSSING, false });
+            }
+        }
+
+        std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+            return a.mAngle < b.mAngle;
+        });
+
+        // Every active segment spans the ray, so its line is hit within the segment
+        auto nearest = [&local, &active](float dx, float dy) {
+            float best = std::numeric_limits<float>::max();
+            for (uint32_t s : active)
+            {
+                const std::array<float, 4>& segment = local[s];
+                float ex = segment[2] - segment[0];
+                float ey = segment[3] - segment[1];
+                float denominator = dx * ey - dy * ex;
+                if (denominator == 0.0f)
+                    continue;
+
+                float t = (segment[0] * ey - segment[1] * ex) / denominator;
+                if (t > 0.0f && t < best)
+                    best = t;
+            }
+
+            return best;
+        };
+
+        for (uint32_t first = 0; first < events.size();)
+        {
+            uint32_t last = first;
+            while (last < events.size() && events[last].mAngle == events[first].mAngle)
+                last++;
+
+            float dx = events[first].mX;
+            float dy = events[first].mY;
+            float before = nearest(dx, dy);
+
+            for (uint32_t e = first; e < last; e++)
+            {
+                if (events[e].mSegment == CROSSING)
+                    continue;
+
+                if (events[e].mInsert)
+                    active.push_back(events[e].mSegment);
+                else
+                {
+                    std::vector<uint32_t>::iterator it = std::find(active.begin(), active.end(), events[e].mSegment);
+                    if (it != active.end())
+                    {
+                        *it = active.back();
+                        active.pop_back();
+                    }
+                }
+            }
+
+            float after = nearest(dx, dy);
+
+            // An endpoint in front of or behind the wall it belongs to adds a step to the outline
+            if (before != std::numeric_limits<float>::max())
+                polygon.push_back({ position[0] + dx * before, position[1] + dy * before });
+
+            if (after != std::numeric_limits<float>::max() && std::fabs(after - before) > 1e-5f * std::max(after, before))
+                polygon.push_back({ position[0] + dx * after, position[1] + dy * after });
+
+            first = last;
+        }
+    }
+
+    void ShadowCaster::gatherOccluders(const Light& light, std::vector<std::array<float, 4>>& segments)
+    {
+        segments.clear();
+
+        std::array<float, 2> position = light.getLightPosition();
+        float radius = light.getLightRadius();
+        float x1 = position[0] - radius, y1 = position[1] - radius;
+        float x2 = position[0] + radius, y2 = position[1] + radius;
+
+        // Cells are walked in order, so the same occluders always come out in the same order
+        mGatherStamp++;
+        int32_t cellX1 = (int32_t)std::floor(x1 / OCCLUDER_CELL_SIZE), cellY1 = (int32_t)std::floor(y1 / OCCLUDER_CELL_SIZE);
+        int32_t cellX2 = (int32_t)std::floor(x2 / OCCLUDER_CELL_SIZE), cellY2 = (int32_t)std::floor(y2 / OCCLUDER_CELL_SIZE);
+
+        for (int32_t y = cellY1; y <= cellY2 && mOccluders.empty() == false; y++)
+        {
+            for (int32_t x = cellX1; x <= cellX2; x++)
+            {
+                std::unordered_map<uint64_t, std::vector<uint32_t>>::const_iterator cell =
+                    mOccluderCells.find(((uint64_t)(uint32_t)y << 32) | (uint32_t)x);
+                if (cell == mOccluderCells.end())
+                    continue;
+
+                for (uint32_t index : cell->second)
+                {
+                    const std::array<float, 4>& segment = mOccluders[index];
+                    if (mOccluderStamps[index] == mGatherStamp ||
+                        std::max(segment[0], segment[2]) < x1 || std::min(segment[0], segment[2]) > x2 ||
+                        std::max(segment[1], segment[3]) < y1 || std::min(segment[1], segment[3]) > y2)
+                        continue;
+
+                    mOccluderStamps[index] = mGatherStamp;
+                    segments.push_back(segment);
+                }
+            }
+        }
+
+        if (mLayer == nullptr)
+            return;
+
+        std::vector<common::Entity*> entities;
+        if (mLayer->getSpatialHash() != nullptr)
+        {
+            if (mEntityType >= 0)
+                entities = mLayer->getSpatialHash()->query({ x1, y1, x2 - x1, y2 - y1 }, mEntityType);
+            else
+                entities = mLayer->getSpatialHash()->query({ x1, y1, x2 - x1, y2 - y1 });
+        }
+        else
+        {
+            for (common::Entity* entity : mLayer->getEntities())
+            {
+                if (mEntityType < 0 || entity->getEntityType() == mEntityType)
+                    entities.push_back(entity);
+            }
+        }
+
+        for (common::Entity* entity : entities)
+        {
+            utilities::Span<utilities::Vertex2* const> vertices = entity->getVertices();
+            for (uint32_t q = 0; q + 4 <= vertices.size(); q += 4)
+            {
+                std::array<std::array<float, 2>, 4> corners;
+                float minX = std::numeric_limits<float>::max(), maxX = -std::numeric_limits<float>::max();
+                float minY = std::numeric_limits<float>::max(), maxY = -std::numeric_limits<float>::max();
+                for (uint32_t c = 0; c < 4; c++)
+                {
+                    corners[c] = vertices[q + c]->getPosition();
+                    minX = std::min(minX, corners[c][0]);
+                    maxX = std::max(maxX, corners[c][0]);
+                    minY = std::min(minY, corners[c][1]);
+                    maxY = std::max(maxY, corners[c][1]);
+                }
+
+                if (maxX < x1 || minX > x2 || maxY < y1 || minY > y2)
+                    continue;
+
+                // Quads wind around their corners, so consecutive corners form the outline
+                for (uint32_t c = 0; c < 4; c++)
+                {
+                    const std::array<float, 2>& a = corners[c];
+                    const std::array<float, 2>& b = corners[(c + 1) % 4];
+                    segments.push_back({ a[0], a[1], b[0], b[1] });
+                }
+            }
+        }
+    }
+
+    void ShadowCaster::buildShadow(const Light& light, CachedShadow& shadow)
+    {
+        if (light.getLightMesh() == nullptr || light.getLightMesh()->size() < 4)
+        {
+            shadow.mMesh = nullptr;
+            return;
+        }
+
+        const std::vector<RenderVertex>& look = *light.getLightMesh();
+
+        std::vector<std::array<float, 2>> polygon;
+        std::array<float, 2> position = light.getLightPosition();
+        float radius = light.getLightRadius();
+        computeVisibility(position, radius, look.size() - 2, shadow.mSegments, polygon);
+
+        // Nothing in reach, the shared unoccluded mesh is drawn instead
+        if (polygon.empty() || shadow.mSegments.empty())
+        {
+            shadow.mMesh = nullptr;
+            return;
+        }
+
+        std::vector<RenderVertex> fan(polygon.size() + 2);
+        fan[0] = look[0];
+
+        // Fades with distance like the unoccluded fan, whose rim is fully transparent
+        for (uint32_t i = 0; i < polygon.size(); i++)
+        {
+            float x = polygon[i][0] - position[0];
+            float y = polygon[i][1] - position[1];
+            float fade = (radius > 0.0f) ? std::max(1.0f - std::sqrt(x * x + y * y) / radius, 0.0f) : 0.0f;
+
+            RenderVertex& vertex = fan[i + 1];
+            vertex.mPositionX = x;
+            vertex.mPositionY = y;
+            for (uint32_t c = 0; c < 4; c++)
+                vertex.mColour[c] = (uint8_t)(look[0].mColour[c] * fade);
+        }
+
+        fan.back() = fan[1];
+        shadow.mMesh = std::make_shared<const std::vector<RenderVertex>>(std::move(fan));
+    }
+
+}}
@@ -0,0 +1,139 @@
+#include <array>
+#include <unordered_map>
+#include <vector>
+#include <stdint.h>
+#include "Light.h"
+#include "../utilities/Span.h"
+
+namespace liquid { namespace common { class Layer; } }
+
+namespace liquid { namespace graphics {
+#ifndef _SHADOWCASTER_H
+#define _SHADOWCASTER_H
+
+/**
+ * \class ShadowCaster
+ *
+ * \ingroup Graphics
+ * \brief Stops lights from shining through occluders
+ *
+ * For every light the occluder segments within its radius are gathered, from the
+ * spatial index of a common::Layer and from segments added by hand, and the area the
+ * light can reach is found by an angular sweep around it. The result replaces the
+ * light's fan through Light::setShadowGeometry(), fading with distance the same way
+ * the unoccluded fan does, so backends draw shadowed lights like any other.
+ *
+ * Polygons are cached per light and only recomputed when the light moves or changes
+ * look, or when the occluders within its radius differ from the last update. The
+ * recomputed lights are spread across utilities::ThreadPool::instance().
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class ShadowCaster
+{
+public:
+    /// Width and height in 2D space of the grid cells addOccluder() segments are filed in
+    static constexpr float OCCLUDER_CELL_SIZE = 256.0f;
+
+public:
+    /// ShadowCaster Constructor
+    ShadowCaster();
+
+    /// ShadowCaster Destructor
+    ~ShadowCaster();
+
+    /** \brief Gathers occluders from the Entities of a Layer
+      * \param layer Layer to query, nullptr to stop using one
+      * \param entityType Only Entities of this type occlude, -1 for every Entity
+      *
+      * Every quad of an occluding Entity's vertices casts shadows from its four edges.
+      * The spatial index of the Layer is used when it has one.
+      */
+    void setOccluderLayer(common::Layer* layer, int32_t entityType = -1);
+
+    /** \brief Adds a segment that casts shadows, like the side of a wall
+      * \param segment Segment as (x1, y1, x2, y2)
+      *
+      * Segments are filed in a uniform grid, so a light only looks at the segments of
+      * the cells under it.
+      */
+    void addOccluder(std::array<float, 4> segment);
+
+    /// \brief Removes every segment added with addOccluder()
+    void clearOccluders();
+
+    /** \brief Brings the shadows of lights up to date, call once per frame after updating
+      * \param lights Lights to shadow, lights missing from the list are forgotten
+      */
+    void update(utilities::Span<Light* const> lights);
+
+    /// \brief Recomputes every light on the next update()
+    void invalidate();
+
+    /// \return Number of lights recomputed by the last update()
+    const uint32_t getRecomputedCount() const;
+
+    /// \return Milliseconds spent in the last update()
+    const float getUpdateTime() const;
+
+    /** \brief Computes the area a light reaches by an angular sweep
+      * \param position Position of the light
+      * \param radius Radius of the light
+      * \param rimPoints Number of points on the rim of the light, as Light::generate()
+      * \param segments Occluder segments as (x1, y1, x2, y2)
+      * \param polygon Cleared, then filled with the polygon in counter-clockwise order
+      *
+      * The rim of the light is swept along with the occluders, so a light without any
+      * occluders in reach returns its own rim. Segments passing through the light are
+      * edge-on to it and ignored.
+      */
+    static void computeVisibility(std::array<float, 2> position, float radius, uint32_t rimPoints,
+                                  const std::vector<std::array<float, 4>>& segments,
+                                  std::vector<std::array<float, 2>>& polygon);
+
+protected:
+    /// Shadow of one light as of the last update that recomputed it
+    struct CachedShadow
+    {
+        std::array<float, 2>              mPosition;  ///< Position of the light
+        const std::vector<RenderVertex>*  mLook;      ///< Unoccluded mesh of the light, changes with its look
+        uint64_t                          mSignature; ///< Hash of the occluders within reach
+        std::vector<std::array<float, 4>> mSegments;  ///< Occluders within reach
+        LightMeshCache::Mesh              mMesh;      ///< Shadowed fan handed to the light
+        uint64_t                          mFrame;     ///< Last update() the light was seen in
+        bool                              mDirty;     ///< True if mMesh is out of date
+    };
+
+    /** \brief Collects the occluders that could shadow a light
+      * \param light Light to collect for
+      * \param segments Filled with the segments overlapping the light's bounds
+      */
+    void gatherOccluders(const Light& light, std::vector<std::array<float, 4>>& segments);
+
+    /** \brief Recomputes the shadowed fan of a light, safe to run for several lights at once
+      * \param light Light the shadow belongs to
+      * \param shadow Cache entry to fill
+      */
+    static void buildShadow(const Light& light, CachedShadow& shadow);
+
+protected:
+    common::Layer*                                      mLayer;          ///< Layer whose Entities occlude, nullptr if none
+    int32_t                                             mEntityType;     ///< Type of the occluding Entities, -1 for every type
+    std::vector<std::array<float, 4>>                   mOccluders;      ///< Segments added with addOccluder()
+    std::unordered_map<uint64_t, std::vector<uint32_t>> mOccluderCells;  ///< Indices into mOccluders by grid cell
+    std::vector<uint32_t>                               mOccluderStamps; ///< Last gather that took each segment, so spanning segments are taken once
+    uint32_t                                            mGatherStamp;    ///< Number of gatherOccluders() calls
+    std::unordered_map<const Light*, CachedShadow>      mShadows;        ///< Cached shadow of every light
+    std::vector<std::pair<Light*, CachedShadow*>>       mDirty;          ///< Lights recomputed this update and their entries
+    std::vector<std::array<float, 4>>                   mGathered;       ///< Scratch buffer for gatherOccluders()
+    uint64_t                                            mFrame;          ///< Number of update() calls
+    uint32_t                                            mRecomputed;     ///< Lights recomputed by the last update()
+    float                                               mUpdateTime;     ///< Milliseconds spent in the last update()
+};
+
+#endif // _SHADOWCASTER_H
+}}
@@ -0,0 +1,342 @@
+#include "SpriteExpander.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define LIQUID_SPRITE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define LIQUID_SPRITE_SSE
+#endif
+
+namespace liquid {
+namespace graphics {
+
+    namespace
+    {
+        static_assert(sizeof(SpriteInstance) == 12 * sizeof(float), "Vector kernels expect 12 packed fields per SpriteInstance");
+
+        const float DEGREES_TO_RADIANS = 3.14159265358979f / 180.0f;
+
+        /// Number of floats between two SpriteInstances
+        const int32_t INSTANCE_STRIDE = 12;
+
+        /// Writes the four vertices of one sprite from already computed corners
+        inline void writeQuad(RenderVertex* vertex, const float* x, const float* y,
+                              float u0, float v0, float u1, float v1, const uint8_t* colour)
+        {
+            const float u[4] = { u0, u1, u1, u0 };
+            const float v[4] = { v0, v0, v1, v1 };
+
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                vertex[c].mPositionX = x[c];
+                vertex[c].mPositionY = y[c];
+                std::memcpy(vertex[c].mColour, colour, 4);
+                vertex[c].mTexCoordX = u[c];
+                vertex[c].mTexCoordY = v[c];
+            }
+        }
+
+        /// Cosine and sine of a rotation in degrees, an unrotated sprite skips the trigonometry
+        inline void rotation(float degrees, float& cosine, float& sine)
+        {
+            if (degrees == 0.0f)
+            {
+                cosine = 1.0f;
+                sine = 0.0f;
+                return;
+            }
+
+            cosine = std::cos(degrees * DEGREES_TO_RADIANS);
+            sine = std::sin(degrees * DEGREES_TO_RADIANS);
+        }
+    }
+
+    void SpriteExpander::expandScalar(const SpriteInstance* instances, uint32_t count, RenderVertex* vertices)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const SpriteInstance& sprite = instances[i];
+            float cosine, sine;
+            rotation(sprite.mRotation, cosine, sine);
+
+            float left = -sprite.mOriginX * sprite.mWidth;
+            float top = -sprite.mOriginY * sprite.mHeight;
+            float right = left + sprite.mWidth;
+            float bottom = top + sprite.mHeight;
+
+            const float cornerX[4] = { left, right, right, left };
+            const float cornerY[4] = { top, top, bottom, bottom };
+            float x[4], y[4];
+
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                x[c] = sprite.mPositionX + (cornerX[c] * cosine - cornerY[c] * sine);
+                y[c] = sprite.mPositionY + (cornerX[c] * sine + cornerY[c] * cosine);
+            }
+
+            writeQuad(vertices + i * 4, x, y, sprite.mTexLeft, sprite.mTexTop,
+                      sprite.mTexLeft + sprite.mTexWidth, sprite.mTexTop + sprite.mTexHeight, sprite.mColour);
+        }
+    }
+
+#if defined(LIQUID_SPRITE_AVX2) || defined(LIQUID_SPRITE_SSE)
+
+    namespace
+    {
+        /** Writes one corner of 4 sprites, colour holds the packed RGBA8 bits. The fields are
+          * transposed back so each vertex is one 16 byte store of (x, y, colour, u) and v.
+          */
+        inline void storeCorner(RenderVertex* vertices, uint32_t corner, __m128 x, __m128 y,
+                                __m128 colour, __m128 u, __m128 v)
+        {
+            _MM_TRANSPOSE4_PS(x, y, colour, u);
+
+            alignas(16) float texCoordY[4];
+            _mm_store_ps(texCoordY, v);
+            const __m128 rows[4] = { x, y, colour, u };
+
+            for (uint32_t s = 0; s < 4; s++)
+            {
+                float* vertex = &vertices[s * 4 + corner].mPositionX;
+                _mm_storeu_ps(vertex, rows[s]);
+                vertex[4] = texCoordY[s];
+            }
+        }
+
+        /// Loads 4 sprites and transposes them into one register per field
+        inline void loadFields(const SpriteInstance* instances, __m128* fields)
+        {
+            const float* base = reinterpret_cast<const float*>(instances);
+
+            for (uint32_t f = 0; f < INSTANCE_STRIDE; f += 4)
+            {
+                __m128 row0 = _mm_loadu_ps(base + f);
+                __m128 row1 = _mm_loadu_ps(base + INSTANCE_STRIDE + f);
+                __m128 row2 = _mm_loadu_ps(base + INSTANCE_STRIDE * 2 + f);
+                __m128 row3 = _mm_loadu_ps(base + INSTANCE_STRIDE * 3 + f);
+                _MM_TRANSPOSE4_PS(row0, row1, row2, row3);
+
+                fields[f] = row0;
+                fields[f + 1] = row1;
+                fields[f + 2] = row2;
+                fields[f + 3] = row3;
+            }
+        }
+    }
+
+    static_assert(sizeof(RenderVertex) == 5 * sizeof(float), "Vector kernels write RenderVertex as 5 packed fields");
+
+#endif
+
+#if defined(LIQUID_SPRITE_AVX2)
+
+    namespace
+    {
+        /// Sine and cosine of 8 angles in radians, the same reduction as the 4 wide version
+        inline void sinCos(__m256 x, __m256& sine, __m256& cosine)
+        {
+            const __m256 signMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x80000000));
+            __m256 sineSign = _mm256_and_ps(x, signMask);
+            x = _mm256_andnot_ps(signMask, x);
+
+            __m256i octant = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(1.27323954473516f)));
+            octant = _mm256_and_si256(_mm256_add_epi32(octant, _mm256_set1_epi32(1)), _mm256_set1_epi32(~1));
+            __m256 y = _mm256_cvtepi32_ps(octant);
+
+            __m256 sineSwap = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(octant, _mm256_set1_epi32(4)), 29));
+            __m256 cosineSign = _mm256_castsi256_ps(_mm256_slli_epi32(
+                _mm256_andnot_si256(_mm256_sub_epi32(octant, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29));
+            __m256 polyMask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(
+                _mm256_and_si256(octant, _mm256_set1_epi32(2)), _mm256_setzero_si256()));
+            sineSign = _mm256_xor_ps(sineSign, sineSwap);
+
+            x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(0.78515625f)));
+            x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(2.4187564849853515625e-4f)));
+            x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(3.77489497744594108e-8f)));
+            __m256 z = _mm256_mul_ps(x, x);
+
+            __m256 cosinePoly = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(2.443315711809948e-5f), z), _mm256_set1_ps(-1.388731625493765e-3f));
+            cosinePoly = _mm256_add_ps(_mm256_mul_ps(cosinePoly, z), _mm256_set1_ps(4.166664568298827e-2f));
+            cosinePoly = _mm256_mul_ps(_mm256_mul_ps(cosinePoly, z), z);
+            cosinePoly = _mm256_add_ps(_mm256_sub_ps(cosinePoly, _mm256_mul_ps(z, _mm256_set1_ps(0.5f))), _mm256_set1_ps(1.0f));
+
+            __m256 sinePoly = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(-1.9515295891e-4f), z), _mm256_set1_ps(8.3321608736e-3f));
+            sinePoly = _mm256_add_ps(_mm256_mul_ps(sinePoly, z), _mm256_set1_ps(-1.6666654611e-1f));
+            sinePoly = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(sinePoly, z), x), x);
+
+            sine = _mm256_xor_ps(_mm256_blendv_ps(cosinePoly, sinePoly, polyMask), sineSign);
+            cosine = _mm256_xor_ps(_mm256_blendv_ps(sinePoly, cosinePoly, polyMask), cosineSign);
+        }
+    }
+
+    void SpriteExpander::expand(const SpriteInstance* instances, uint32_t count, RenderVertex* vertices)
+    {
+        uint32_t blocks = count / 8;
+
+        for (uint32_t b = 0; b < blocks; b++)
+        {
+            __m128 low[INSTANCE_STRIDE], high[INSTANCE_STRIDE];
+            loadFields(instances + b * 8, low);
+            loadFields(instances + b * 8 + 4, high);
+
+            __m256 fields[INSTANCE_STRIDE];
+            for (uint32_t f = 0; f < INSTANCE_STRIDE; f++)
+                fields[f] = _mm256_insertf128_ps(_mm256_castps128_ps256(low[f]), high[f], 1);
+
+            __m256 cosine = _mm256_set1_ps(1.0f);
+            __m256 sine = _mm256_setzero_ps();
+            __m256 degrees = fields[6];
+
+            if (_mm256_movemask_ps(_mm256_cmp_ps(degrees, _mm256_setzero_ps(), _CMP_NEQ_UQ)) != 0)
+                sinCos(_mm256_mul_ps(degrees, _mm256_set1_ps(DEGREES_TO_RADIANS)), sine, cosine);
+
+            __m256 left = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_mul_ps(fields[2], fields[4]));
+            __m256 top = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_mul_ps(fields[3], fields[5]));
+            __m256 right = _mm256_add_ps(left, fields[4]);
+            __m256 bottom = _mm256_add_ps(top, fields[5]);
+            __m128 texRight[2] = { _mm_add_ps(low[7], low[9]), _mm_add_ps(high[7], high[9]) };
+            __m128 texBottom[2] = { _mm_add_ps(low[8], low[10]), _mm_add_ps(high[8], high[10]) };
+
+            const __m256 cornerX[4] = { left, right, right, left };
+            const __m256 cornerY[4] = { top, top, bottom, bottom };
+            RenderVertex* vertex = vertices + b * 32;
+
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                __m256 x = _mm256_add_ps(fields[0], _mm256_sub_ps(_mm256_mul_ps(cornerX[c], cosine), _mm256_mul_ps(cornerY[c], sine)));
+                __m256 y = _mm256_add_ps(fields[1], _mm256_add_ps(_mm256_mul_ps(cornerX[c], sine), _mm256_mul_ps(cornerY[c], cosine)));
+                bool rightEdge = c == 1 || c == 2;
+                bool bottomEdge = c >= 2;
+
+                storeCorner(vertex, c, _mm256_castps256_ps128(x), _mm256_castps256_ps128(y), low[11],
+                            rightEdge ? texRight[0] : low[7], bottomEdge ? texBottom[0] : low[8]);
+                storeCorner(vertex + 16, c, _mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), high[11],
+                            rightEdge ? texRight[1] : high[7], bottomEdge ? texBottom[1] : high[8]);
+            }
+        }
+
+        expandScalar(instances + blocks * 8, count - blocks * 8, vertices + blocks * 32);
+    }
+
+    SpriteExpander::eInstructionSet SpriteExpander::getInstructionSet()
+    {
+        return INSTRUCTIONS_AVX2;
+    }
+
+#elif defined(LIQUID_SPRITE_SSE)
+
+    namespace
+    {
+        /// Sine and cosine of 4 angles in radians, Cephes polynomials with octant reduction
+        inline void sinCos(__m128 x, __m128& sine, __m128& cosine)
+        {
+            const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
+            __m128 sineSign = _mm_and_ps(x, signMask);
+            x = _mm_andnot_ps(signMask, x);
+
+            // Octant of each angle, rounded up to even
+            __m128i octant = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.27323954473516f)));
+            octant = _mm_and_si128(_mm_add_epi32(octant, _mm_set1_epi32(1)), _mm_set1_epi32(~1));
+            __m128 y = _mm_cvtepi32_ps(octant);
+
+            __m128 sineSwap = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(octant, _mm_set1_epi32(4)), 29));
+            __m128 cosineSign = _mm_castsi128_ps(_mm_slli_epi32(
+                _mm_andnot_si128(_mm_sub_epi32(octant, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+            __m128 polyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(
+                _mm_and_si128(octant, _mm_set1_epi32(2)), _mm_setzero_si128()));
+            sineSign = _mm_xor_ps(sineSign, sineSwap);
+
+            // Extended precision x - octant * pi / 4
+            x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(0.78515625f)));
+            x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(2.4187564849853515625e-4f)));
+            x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(3.77489497744594108e-8f)));
+            __m128 z = _mm_mul_ps(x, x);
+
+            __m128 cosinePoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(2.443315711809948e-5f), z), _mm_set1_ps(-1.388731625493765e-3f));
+            cosinePoly = _mm_add_ps(_mm_mul_ps(cosinePoly, z), _mm_set1_ps(4.166664568298827e-2f));
+            cosinePoly = _mm_mul_ps(_mm_mul_ps(cosinePoly, z), z);
+            cosinePoly = _mm_add_ps(_mm_sub_ps(cosinePoly, _mm_mul_ps(z, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+            __m128 sinePoly = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(-1.9515295891e-4f), z), _mm_set1_ps(8.3321608736e-3f));
+            sinePoly = _mm_add_ps(_mm_mul_ps(sinePoly, z), _mm_set1_ps(-1.6666654611e-1f));
+            sinePoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinePoly, z), x), x);
+
+            sine = _mm_or_ps(_mm_and_ps(polyMask, sinePoly), _mm_andnot_ps(polyMask, cosinePoly));
+            cosine = _mm_or_ps(_mm_and_ps(polyMask, cosinePoly), _mm_andnot_ps(polyMask, sinePoly));
+            sine = _mm_xor_ps(sine, sineSign);
+            cosine = _mm_xor_ps(cosine, cosineSign);
+        }
+
+    }
+
+    void SpriteExpander::expand(const SpriteInstance* instances, uint32_t count, RenderVertex* vertices)
+    {
+        uint32_t blocks = count / 4;
+
+        for (uint32_t b = 0; b < blocks; b++)
+        {
+            __m128 fields[INSTANCE_STRIDE];
+            loadFields(instances + b * 4, fields);
+
+            __m128 cosine = _mm_set1_ps(1.0f);
+            __m128 sine = _mm_setzero_ps();
+
+            if (_mm_movemask_ps(_mm_cmpneq_ps(fields[6], _mm_setzero_ps())) != 0)
+                sinCos(_mm_mul_ps(fields[6], _mm_set1_ps(DEGREES_TO_RADIANS)), sine, cosine);
+
+            __m128 left = _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(fields[2], fields[4]));
+            __m128 top = _mm_sub_ps(_mm_setzero_ps(), _mm_mul_ps(fields[3], fields[5]));
+            __m128 right = _mm_add_ps(left, fields[4]);
+            __m128 bottom = _mm_add_ps(top, fields[5]);
+            __m128 texRight = _mm_add_ps(fields[7], fields[9]);
+            __m128 texBottom = _mm_add_ps(fields[8], fields[10]);
+
+            const __m128 cornerX[4] = { left, right, right, left };
+            const __m128 cornerY[4] = { top, top, bottom, bottom };
+            const __m128 cornerU[4] = { fields[7], texRight, texRight, fields[7] };
+            const __m128 cornerV[4] = { fields[8], fields[8], texBottom, texBottom };
+
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                __m128 x = _mm_add_ps(fields[0], _mm_sub_ps(_mm_mul_ps(cornerX[c], cosine), _mm_mul_ps(cornerY[c], sine)));
+                __m128 y = _mm_add_ps(fields[1], _mm_add_ps(_mm_mul_ps(cornerX[c], sine), _mm_mul_ps(cornerY[c], cosine)));
+                storeCorner(vertices + b * 16, c, x, y, fields[11], cornerU[c], cornerV[c]);
+            }
+        }
+
+        expandScalar(instances + blocks * 4, count - blocks * 4, vertices + blocks * 16);
+    }
+
+    SpriteExpander::eInstructionSet SpriteExpander::getInstructionSet()
+    {
+        return INSTRUCTIONS_SSE;
+    }
+
+#else
+
+    void SpriteExpander::expand(const SpriteInstance* instances, uint32_t count, RenderVertex* vertices)
+    {
+        expandScalar(instances, count, vertices);
+    }
+
+    SpriteExpander::eInstructionSet SpriteExpander::getInstructionSet()
+    {
+        return INSTRUCTIONS_SCALAR;
+    }
+
+#endif
+
+    const char* SpriteExpander::getInstructionSetName()
+    {
+        switch (getInstructionSet())
+        {
+        case INSTRUCTIONS_AVX2: return "AVX2";
+        case INSTRUCTIONS_SSE:  return "SSE";
+        default:                return "Scalar";
+        }
+    }
+
+}}
@@ -0,0 +1,60 @@
+#include "SpriteInstance.h"
+#include "RenderVertex.h"
+#include <stdint.h>
+
+namespace liquid { namespace graphics {
+#ifndef _SPRITEEXPANDER_H
+#define _SPRITEEXPANDER_H
+
+/**
+ * \class SpriteExpander
+ *
+ * \ingroup Graphics
+ * \brief Expands SpriteInstances into four RenderVertex each, several sprites at a time
+ *
+ * expand() uses the widest kernel the engine was compiled for: AVX2 handles 8 sprites
+ * per step, SSE 4 and anything else falls back to expandScalar(), which is also used
+ * for the remainder of a batch. Corners are emitted in the same order as Entity
+ * vertices: top left, top right, bottom right, bottom left.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class SpriteExpander
+{
+public:
+    /// Instruction set used by expand()
+    enum eInstructionSet
+    {
+        INSTRUCTIONS_SCALAR = 0,
+        INSTRUCTIONS_SSE = 1,
+        INSTRUCTIONS_AVX2 = 2,
+    };
+
+public:
+    /** \brief Expands sprites with the widest available kernel
+      * \param instances Sprites to expand
+      * \param count Number of sprites
+      * \param vertices Destination of count * 4 vertices
+      */
+    static void expand(const SpriteInstance* instances, uint32_t count, RenderVertex* vertices);
+
+    /** \brief Expands sprites one at a time, the reference for the vector kernels
+      * \param instances Sprites to expand
+      * \param count Number of sprites
+      * \param vertices Destination of count * 4 vertices
+      */
+    static void expandScalar(const SpriteInstance* instances, uint32_t count, RenderVertex* vertices);
+
+    /// \return Instruction set expand() was compiled with
+    static eInstructionSet getInstructionSet();
+
+    /// \return Readable name of the instruction set expand() was compiled with
+    static const char* getInstructionSetName();
+};
+
+#endif // _SPRITEEXPANDER_H
+}}
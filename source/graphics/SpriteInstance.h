@@ -0,0 +1,41 @@
+#include <stdint.h>
+
+namespace liquid { namespace graphics {
+#ifndef _SPRITEINSTANCE_H
+#define _SPRITEINSTANCE_H
+
+/**
+ * \class SpriteInstance
+ *
+ * \ingroup Graphics
+ * \brief Compact description of one textured quad, expanded into vertices by SpriteExpander
+ *
+ * An Entity that draws plain quads can publish one SpriteInstance per quad (48 bytes)
+ * instead of four utilities::Vertex2 objects, rotation and scaling then cost nothing
+ * extra as the corners are only computed when the quad is expanded.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class SpriteInstance
+{
+public:
+    float   mPositionX; ///< Position of the origin on the X-Axis
+    float   mPositionY; ///< Position of the origin on the Y-Axis
+    float   mOriginX;   ///< Origin on the X-Axis relative to the size (0-1)
+    float   mOriginY;   ///< Origin on the Y-Axis relative to the size (0-1)
+    float   mWidth;     ///< Width of the quad
+    float   mHeight;    ///< Height of the quad
+    float   mRotation;  ///< Clockwise rotation around the origin in degrees
+    float   mTexLeft;   ///< Left of the atlas region in pixels
+    float   mTexTop;    ///< Top of the atlas region in pixels
+    float   mTexWidth;  ///< Width of the atlas region in pixels
+    float   mTexHeight; ///< Height of the atlas region in pixels
+    uint8_t mColour[4]; ///< Colour of the quad (r,g,b,a) as 0 - 255
+};
+
+#endif // _SPRITEINSTANCE_H
+}}
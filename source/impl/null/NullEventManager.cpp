@@ -0,0 +1,15 @@
+#include "NullEventManager.h"
+
+namespace liquid {
+namespace impl {
+
+    NullEventManager::NullEventManager()
+    {}
+
+    NullEventManager::~NullEventManager()
+    {}
+
+    void NullEventManager::updateEvents()
+    {}
+
+}}
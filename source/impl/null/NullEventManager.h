@@ -0,0 +1,36 @@
+#include "../../events/EventManager.h"
+
+namespace liquid { namespace impl {
+#ifndef _NULLEVENTMANAGER_H
+#define _NULLEVENTMANAGER_H
+
+/**
+ * \class NullEventManager
+ *
+ * \ingroup Impl
+ * \brief events::EventManager with no input source, used for headless simulation
+ *
+ * Polls nothing; anything that needs input in a headless run can trigger the
+ * events::EventDispatcher listeners directly.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class NullEventManager : public events::EventManager
+{
+public:
+    /// NullEventManager Constructor
+    NullEventManager();
+
+    /// NullEventManager Destructor
+    ~NullEventManager();
+
+    /// Override for processing events, does nothing
+    void updateEvents() override;
+};
+
+#endif // _NULLEVENTMANAGER_H
+}}
@@ -0,0 +1,35 @@
+#include "NullRenderer.h"
+
+namespace liquid {
+namespace impl {
+
+    NullRenderer::NullRenderer(data::Settings* settings) :
+        graphics::Renderer(settings)
+    {
+        mFrameCount = 0;
+    }
+
+    NullRenderer::~NullRenderer()
+    {}
+
+    void NullRenderer::draw(common::GameScene* /*gameScene*/)
+    {
+        mFrameCount++;
+    }
+
+    void NullRenderer::captureSnapshot(common::GameScene* /*gameScene*/, graphics::RenderSnapshot& snapshot)
+    {
+        snapshot.clear();
+    }
+
+    void NullRenderer::drawSnapshot(const graphics::RenderSnapshot& /*snapshot*/)
+    {
+        mFrameCount++;
+    }
+
+    const uint64_t NullRenderer::getFrameCount() const
+    {
+        return mFrameCount;
+    }
+
+}}
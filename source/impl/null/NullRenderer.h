@@ -0,0 +1,50 @@
+#include "../../graphics/Renderer.h"
+
+namespace liquid { namespace impl {
+#ifndef _NULLRENDERER_H
+#define _NULLRENDERER_H
+
+/**
+ * \class NullRenderer
+ *
+ * \ingroup Impl
+ * \brief graphics::Renderer that draws nothing, used for headless simulation
+ *
+ * Opens no window and creates no graphics context, so the GameManager can be run
+ * on servers and CI machines without a display. Frames are only counted.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class NullRenderer : public graphics::Renderer
+{
+public:
+    /** \brief NullRenderer Constructor
+      * \param settings Optional Settings of the game, unused beyond being stored
+      */
+    NullRenderer(data::Settings* settings = nullptr);
+
+    /// NullRenderer Destructor
+    ~NullRenderer();
+
+    /// \brief Draw override, only counts the frame
+    virtual void draw(common::GameScene* gameScene) override;
+
+    /// \brief Snapshot capture override, skipped as nothing is ever drawn
+    virtual void captureSnapshot(common::GameScene* gameScene, graphics::RenderSnapshot& snapshot) override;
+
+    /// \brief Snapshot draw override, only counts the frame
+    virtual void drawSnapshot(const graphics::RenderSnapshot& snapshot) override;
+
+    /// \return Number of frames that would have been drawn
+    const uint64_t getFrameCount() const;
+
+protected:
+    uint64_t mFrameCount; ///< Number of frames that would have been drawn
+};
+
+#endif // _NULLRENDERER_H
+}}
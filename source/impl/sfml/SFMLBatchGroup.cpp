@@ -1,4 +1,5 @@
 #include "SFMLBatchGroup.h"
+#include <algorithm>
 
 namespace liquid {
 namespace impl {
@@ -9,15 +10,105 @@ namespace impl {
         mShaderID = shaderID;
         mBlendMode = blendMode;
         mPrimitiveType = primitiveType;
+        mSlotCount = 0;
     }
 
     SFMLBatchGroup::~SFMLBatchGroup()
     {
     }
 
-    void SFMLBatchGroup::insertVertex(sf::Vertex& vertex)
+    uint32_t SFMLBatchGroup::getSizeClass(uint32_t vertexCount)
     {
-        mVertices.push_back(vertex);
+        uint32_t empty = static_cast<uint32_t>(mSizeClasses.size());
+        for (uint32_t c = 0; c < mSizeClasses.size(); c++)
+        {
+            if (mSizeClasses[c].mVertexCount == vertexCount)
+                return c;
+
+            if (mSizeClasses[c].mSlots.empty() && empty == mSizeClasses.size())
+                empty = c;
+        }
+
+        // Entities that keep changing size, such as ParticleEmitters, recycle emptied classes
+        if (empty == mSizeClasses.size())
+            mSizeClasses.emplace_back();
+
+        mSizeClasses[empty].mVertexCount = vertexCount;
+        return empty;
+    }
+
+    uint32_t SFMLBatchGroup::insertSlot(uint32_t sizeClass, const common::Entity* entity, uint32_t frame)
+    {
+        SizeClass& group = mSizeClasses[sizeClass];
+
+        Slot slot;
+        slot.mEntity = entity;
+        slot.mFirstVertex = static_cast<uint32_t>(group.mVertices.size());
+        slot.mVertexCount = group.mVertexCount;
+        slot.mFrame = frame;
+
+        group.mVertices.resize(group.mVertices.size() + group.mVertexCount);
+        group.mSlots.push_back(slot);
+        mSlotCount++;
+        return static_cast<uint32_t>(group.mSlots.size() - 1);
+    }
+
+    void SFMLBatchGroup::removeSlot(uint32_t sizeClass, uint32_t slot)
+    {
+        SizeClass& group = mSizeClasses[sizeClass];
+        Slot& last = group.mSlots.back();
+
+        // Every range of the class is the same size, so the last one always fits the hole
+        if (slot != group.mSlots.size() - 1)
+        {
+            std::copy(group.mVertices.begin() + last.mFirstVertex,
+                      group.mVertices.begin() + last.mFirstVertex + last.mVertexCount,
+                      group.mVertices.begin() + group.mSlots[slot].mFirstVertex);
+
+            last.mFirstVertex = group.mSlots[slot].mFirstVertex;
+            group.mSlots[slot] = last;
+        }
+
+        group.mVertices.resize(group.mVertices.size() - group.mVertexCount);
+        group.mSlots.pop_back();
+        mSlotCount--;
+    }
+
+    void SFMLBatchGroup::clear()
+    {
+        mSizeClasses.clear();
+        mSlotCount = 0;
+    }
+
+    SFMLBatchGroup::Slot& SFMLBatchGroup::getSlot(uint32_t sizeClass, uint32_t slot)
+    {
+        return mSizeClasses[sizeClass].mSlots[slot];
+    }
+
+    sf::Vertex* SFMLBatchGroup::getSlotVertices(uint32_t sizeClass, uint32_t slot)
+    {
+        SizeClass& group = mSizeClasses[sizeClass];
+        return group.mVertices.data() + group.mSlots[slot].mFirstVertex;
+    }
+
+    const uint32_t SFMLBatchGroup::getSizeClassCount() const
+    {
+        return static_cast<uint32_t>(mSizeClasses.size());
+    }
+
+    const uint32_t SFMLBatchGroup::getSlotCount(uint32_t sizeClass) const
+    {
+        return static_cast<uint32_t>(mSizeClasses[sizeClass].mSlots.size());
+    }
+
+    const uint32_t SFMLBatchGroup::getSlotCount() const
+    {
+        return mSlotCount;
+    }
+
+    const std::vector<sf::Vertex>& SFMLBatchGroup::getVertices(uint32_t sizeClass) const
+    {
+        return mSizeClasses[sizeClass].mVertices;
     }
 
     const int32_t SFMLBatchGroup::getAtlasID() const
@@ -40,9 +131,4 @@ namespace impl {
         return mPrimitiveType;
     }
 
-    const std::vector<sf::Vertex> SFMLBatchGroup::getVertices() const
-    {
-        return mVertices;
-    }
-
 }}
@@ -2,30 +2,110 @@
 #include <vector>
 #include <SFML/Graphics.hpp>
 
-namespace liquid { namespace impl {
+namespace liquid {
+namespace common { class Entity; }
+namespace impl {
 #ifndef _SFMLBATCHGROUP_H
 #define _SFMLBATCHGROUP_H
 
+/**
+ * \class SFMLBatchGroup
+ *
+ * \ingroup Impl
+ * \brief Retained vertices of every Entity drawn with one render state
+ *
+ * Slots are grouped into size classes by their vertex count, each class keeping its
+ * ranges back to back in its own vertex array. As every Slot of a class is the same
+ * size, removing one always moves the last Slot of its class into the hole, so a
+ * removal costs one range copy however mixed the Entities of the batch are. Each
+ * class with any Slots is one draw call.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
 class SFMLBatchGroup
 {
+public:
+    /// Range of a size class owned by one Entity while it stays in the batch
+    struct Slot
+    {
+        const common::Entity* mEntity;      ///< Entity that owns the range, never dereferenced
+        uint32_t              mFirstVertex; ///< Index of the first vertex of the range in its size class
+        uint32_t              mVertexCount; ///< Number of vertices in the range
+        uint32_t              mFrame;       ///< Last frame the Entity was drawn in
+    };
+
+    /// Slots sharing one vertex count and one vertex array
+    struct SizeClass
+    {
+        uint32_t                mVertexCount; ///< Number of vertices in every Slot of the class
+        std::vector<sf::Vertex> mVertices;    ///< Ranges of the Slots in Slot order
+        std::vector<Slot>       mSlots;       ///< Slots of the class
+    };
+
 public:
     SFMLBatchGroup(int32_t atlasID, int32_t shaderID, int32_t blendMode, int32_t primitiveType);
     ~SFMLBatchGroup();
 
-    void insertVertex(sf::Vertex& vertex);
+    /** \brief Finds the size class for a vertex count, reusing an empty class if there is none
+      * \param vertexCount Number of vertices of the Slot to insert
+      * \return Index of the size class
+      */
+    uint32_t getSizeClass(uint32_t vertexCount);
+
+    /** \brief Appends a range of vertices owned by an Entity to a size class
+      * \param sizeClass Index of the size class, from getSizeClass()
+      * \param entity Entity that owns the range
+      * \param frame Frame the Entity is being drawn in
+      * \return Index of the new Slot in the size class
+      */
+    uint32_t insertSlot(uint32_t sizeClass, const common::Entity* entity, uint32_t frame);
+
+    /** \brief Gives back the range of a Slot
+      * \param sizeClass Index of the size class
+      * \param slot Index of the Slot to remove
+      *
+      * The last Slot of the class is moved into its place, so if slot is still below
+      * getSlotCount(sizeClass) afterwards, it is the only index that changed owner.
+      */
+    void removeSlot(uint32_t sizeClass, uint32_t slot);
+
+    /// \brief Removes every vertex and Slot
+    void clear();
+
+    /// \return Slot at the given index of a size class, unchecked
+    Slot& getSlot(uint32_t sizeClass, uint32_t slot);
+
+    /// \return First vertex of the range of a Slot, unchecked
+    sf::Vertex* getSlotVertices(uint32_t sizeClass, uint32_t slot);
+
+    /// \return Number of size classes, including empty ones
+    const uint32_t getSizeClassCount() const;
+
+    /// \return Number of Slots in a size class
+    const uint32_t getSlotCount(uint32_t sizeClass) const;
+
+    /// \return Number of Slots in the batch across every size class
+    const uint32_t getSlotCount() const;
+
+    /// \return Vertices of every Slot in a size class, drawn as one call
+    const std::vector<sf::Vertex>& getVertices(uint32_t sizeClass) const;
 
     const int32_t getAtlasID() const;
     const int32_t getShaderID() const;
     const int32_t getBlendMode() const;
     const int32_t getPrimitiveType() const;
-    const std::vector<sf::Vertex> getVertices() const;
 
 protected:
     int32_t mAtlasID;
     int32_t mShaderID;
     int32_t mBlendMode;
     int32_t mPrimitiveType;
-    std::vector<sf::Vertex> mVertices;
+    std::vector<SizeClass> mSizeClasses; ///< Slots grouped by vertex count
+    uint32_t               mSlotCount;   ///< Number of Slots across every size class
 };
 
 #endif // _SFMLBATCHGROUP_H
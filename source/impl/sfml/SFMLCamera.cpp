@@ -142,6 +142,16 @@ namespace impl {
             mSFMLView.setCenter(cameraX, cameraY);
     }
 
+    const std::array<float, 2> SFMLCamera::getViewCentre() const
+    {
+        return { mSFMLView.getCenter().x, mSFMLView.getCenter().y };
+    }
+
+    const std::array<float, 2> SFMLCamera::getViewDimensions() const
+    {
+        return { mSFMLView.getSize().x, mSFMLView.getSize().y };
+    }
+
     sf::View SFMLCamera::getSFMLView() const
     {
         return mSFMLView;
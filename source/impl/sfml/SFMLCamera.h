@@ -86,6 +86,12 @@ public:
       */
     virtual void shake(float duration, float radius, eShakeAxis axis) override;
 
+    /// \return Gets the centre of the sf::View, including any screenshake
+    virtual const std::array<float, 2> getViewCentre() const override;
+
+    /// \return Gets the size of the sf::View, including any zoom
+    virtual const std::array<float, 2> getViewDimensions() const override;
+
     /// \return Gets the sf::View of this Camera
     sf::View getSFMLView() const;
 
@@ -20,8 +20,9 @@ namespace impl {
 
     void SFMLEventManager::updateEvents()
     {
-        sf::Event nextEvent;
-        while (mParentRenderer->getRenderWindow()->pollEvent(nextEvent))
+        // Positions come from the event, the live cursor may have moved since
+        mParentRenderer->pollEvents(mEvents);
+        for (const sf::Event& nextEvent : mEvents)
         {
             if (nextEvent.type == sf::Event::KeyPressed)
             {
@@ -35,24 +36,21 @@ namespace impl {
             }
             else if (nextEvent.type == sf::Event::MouseButtonPressed)
             {
-                sf::Vector2i mouse = sf::Mouse::getPosition(*mParentRenderer->getRenderWindow());
                 events::MouseEventData data((int32_t)nextEvent.mouseButton.button,
-                    mouse.x, mouse.y, true, false);
+                    nextEvent.mouseButton.x, nextEvent.mouseButton.y, true, false);
 
                 events::EventDispatcher<events::MouseEventData>::triggerListeners(data);
             }
             else if (nextEvent.type == sf::Event::MouseButtonReleased)
             {
-                sf::Vector2i mouse = sf::Mouse::getPosition(*mParentRenderer->getRenderWindow());
                 events::MouseEventData data((int32_t)nextEvent.mouseButton.button,
-                    mouse.x, mouse.y, false, false);
+                    nextEvent.mouseButton.x, nextEvent.mouseButton.y, false, false);
 
                 events::EventDispatcher<events::MouseEventData>::triggerListeners(data);
             }
             else if (nextEvent.type == sf::Event::MouseMoved)
             {
-                sf::Vector2i mouse = sf::Mouse::getPosition(*mParentRenderer->getRenderWindow());
-                events::MouseEventData data(0, mouse.x, mouse.y, false, true);
+                events::MouseEventData data(0, nextEvent.mouseMove.x, nextEvent.mouseMove.y, false, true);
 
                 events::EventDispatcher<events::MouseEventData>::triggerListeners(data);
             }
@@ -1,4 +1,6 @@
 #ifdef SFML
+#include <SFML/Graphics.hpp>
+#include <vector>
 #include "../../events/EventManager.h"
 
 namespace liquid { namespace impl {
@@ -11,6 +13,9 @@ namespace liquid { namespace impl {
  * \ingroup Impl
  * \brief Defines how the events::EventManager should function when using SFML
  *
+ * Events are taken from SFMLRenderer::pollEvents(), so updateEvents() has to be called
+ * on the thread that created the renderer, even while a render thread draws to it.
+ *
  * \author Jamie Massey
  * \version 1.0
  * \date 17/04/2017
@@ -33,7 +38,8 @@ public:
     void updateEvents() override;
 
 protected:
-    SFMLRenderer* mParentRenderer; ///< Pointer to te Parent Renderer of the EventManager
+    SFMLRenderer*          mParentRenderer; ///< Pointer to te Parent Renderer of the EventManager
+    std::vector<sf::Event> mEvents;         ///< Events taken this frame, kept to reuse its memory
 };
 
 #endif // _SFMLEVENTMANAGER_H
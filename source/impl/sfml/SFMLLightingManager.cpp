@@ -14,6 +14,7 @@ namespace impl {
 
         mAcummulationBuffer = new sf::RenderTexture();
         mAcummulationBuffer->create(screenWidth, screenHeight);
+        mBufferSize = mAcummulationBuffer->getSize();
     }
 
     SFMLLightingManager::~SFMLLightingManager()
@@ -29,31 +30,61 @@ namespace impl {
         mAcummulationBuffer->clear(sf::Color(mAmbientColour[0], mAmbientColour[1], 
                                              mAmbientColour[2], mAmbientColour[3]));
 
-        for (int32_t i = 0; i < mLights.size(); i++)
-        {
-            std::array<float, 2> lightPosition = mLights[i]->getLightPosition();
-            std::vector<utilities::Vertex2> geom = mLights[i]->getLightGeometry();
-            sf::VertexArray vertexArray;
-            vertexArray.setPrimitiveType(sf::TrianglesFan);
-
-            for (int32_t z = 0; z < geom.size(); z++)
-            {
-                sf::Vertex vertex;
-                vertex.position.x = geom[z].getPosition()[0];
-                vertex.position.y = geom[z].getPosition()[1];
-                vertex.color.r = geom[z].getColour()[0];
-                vertex.color.g = geom[z].getColour()[1];
-                vertex.color.b = geom[z].getColour()[2];
-                vertex.color.a = geom[z].getColour()[3];
-                vertexArray.append(vertex);
-            }
-            
-            sf::RenderStates states;
-            states.blendMode = sf::BlendMode(sf::BlendMode::One, sf::BlendMode::One);
-            states.transform.translate(lightPosition[0], lightPosition[1]);
-            mAcummulationBuffer->draw(vertexArray, states);
-        }
+        mLightCuller.cull(mLights, getViewRegion(renderer), { mBufferSize.x, mBufferSize.y });
+        for (uint32_t light : mLightCuller.getVisibleLights())
+            accumulateLight(*mLights[light]);
 
+        reportCulling(renderer);
+        composite(renderer);
+    }
+
+    void SFMLLightingManager::drawLights(graphics::Renderer* renderer, const std::array<float, 4>& ambientColour,
+                                         const graphics::Light* lights, uint32_t lightCount)
+    {
+        if (lightCount == 0)
+            return;
+
+        mAcummulationBuffer->clear(sf::Color(ambientColour[0], ambientColour[1], ambientColour[2], ambientColour[3]));
+
+        mLightCuller.cull(lights, lightCount, getViewRegion(renderer), { mBufferSize.x, mBufferSize.y });
+        for (uint32_t light : mLightCuller.getVisibleLights())
+            accumulateLight(lights[light]);
+
+        reportCulling(renderer);
+        composite(renderer);
+    }
+
+    void SFMLLightingManager::setRenderThreadActive(bool active)
+    {
+        // The accumulation texture has a context of its own, created on the main thread
+        mAcummulationBuffer->setActive(active);
+    }
+
+    void SFMLLightingManager::accumulateLight(const graphics::Light& light)
+    {
+        // Drawn straight from the shared mesh, RenderVertex has the layout of sf::Vertex
+        const std::vector<graphics::RenderVertex>& mesh = light.getLightGeometry();
+        if (mesh.empty())
+            return;
+
+        std::array<float, 2> lightPosition = light.getLightPosition();
+        sf::RenderStates states;
+        states.blendMode = sf::BlendMode(sf::BlendMode::One, sf::BlendMode::One);
+        states.transform.translate(lightPosition[0], lightPosition[1]);
+        mAcummulationBuffer->draw(reinterpret_cast<const sf::Vertex*>(mesh.data()), mesh.size(),
+                                  sf::TrianglesFan, states);
+    }
+
+    std::array<float, 4> SFMLLightingManager::getViewRegion(graphics::Renderer* renderer) const
+    {
+        // Bounds in 2D space of the clip rectangle, so a rotated camera culls against its whole extent
+        const sf::View& view = static_cast<SFMLRenderer*>(renderer)->getRenderWindow()->getView();
+        sf::FloatRect region = view.getInverseTransform().transformRect(sf::FloatRect(-1.0f, -1.0f, 2.0f, 2.0f));
+        return { region.left, region.top, region.left + region.width, region.top + region.height };
+    }
+
+    void SFMLLightingManager::composite(graphics::Renderer* renderer)
+    {
         SFMLRenderer* sfmlRenderer = static_cast<SFMLRenderer*>(renderer);
         sfmlRenderer->getRenderWindow()->draw(sf::Sprite(mAcummulationBuffer->getTexture()),
             sf::RenderStates(sf::BlendMode(sf::BlendMode::Zero, sf::BlendMode::SrcColor)));
@@ -14,9 +14,18 @@ public:
     ~SFMLLightingManager();
 
     virtual void draw(graphics::Renderer* renderer) override;
+    virtual void drawLights(graphics::Renderer* renderer, const std::array<float, 4>& ambientColour,
+                            const graphics::Light* lights, uint32_t lightCount) override;
+    virtual void setRenderThreadActive(bool active) override;
+
+protected:
+    void accumulateLight(const graphics::Light& light);
+    std::array<float, 4> getViewRegion(graphics::Renderer* renderer) const;
+    void composite(graphics::Renderer* renderer);
 
 protected:
     sf::RenderTexture* mAcummulationBuffer;
+    sf::Vector2u       mBufferSize;
 };
 
 #endif // _SFMLLIGHTINGMANAGER_H
@@ -1,9 +1,12 @@
 #ifdef SFML
 #include "SFMLRenderer.h"
-#include "../../utilities/DeltaTime.h"
+#include "../../utilities/ThreadPool.h"
 #include "../../common/Entity.h"
 #include "../../common/ResourceManager.h"
 #include "../../data/TextureAtlas.h"
+#include <cstdio>
+
+static_assert(sizeof(liquid::graphics::RenderVertex) == sizeof(sf::Vertex), "RenderVertex must match sf::Vertex");
 
 namespace liquid {
 namespace impl {
@@ -29,7 +32,10 @@ namespace impl {
         mRenderBuffer->create(mode.width, mode.height);
         mRenderBufferSpr->setTexture(mRenderBuffer->getTexture());
         mRenderWindow = new sf::RenderWindow(mode, "Window", 
-            settings->getFullscreen() ? sf::Style::Fullscreen : sf::Style::Titlebar);
+            (settings != nullptr && settings->getFullscreen()) ? sf::Style::Fullscreen : sf::Style::Titlebar);
+        mRetainedFrame = 0;
+        mTitleFrames = 0;
+        mTitleUpdated = std::chrono::steady_clock::now();
     }
 
     SFMLRenderer::~SFMLRenderer()
@@ -37,33 +43,192 @@ namespace impl {
 
     void SFMLRenderer::draw(common::GameScene* gameScene)
     {
+        mStats.beginFrame(gameScene->getLayers().size());
+        mStats.beginPhase(graphics::RenderStats::PHASE_PREPROCESS);
         mRenderBuffer->clear(sf::Color::Black);
         mRenderWindow->clear(sf::Color::Black);
 
         drawPreprocess(gameScene);
+        mStats.beginPhase(graphics::RenderStats::PHASE_BATCH);
         drawBatched(gameScene);
 
         Renderer::draw(gameScene);
+        mStats.beginPhase(graphics::RenderStats::PHASE_PRESENT);
         mRenderBuffer->display();
         mRenderWindow->draw(*mRenderBufferSpr);
         mRenderWindow->display();
-
-        std::string dt = std::to_string(1000.0f / utilities::DELTA);
-        mRenderWindow->setTitle("Window - " + dt);
+        mTextureCache.update();
+        updateTitle();
 
         if (gameScene->getCamera() != nullptr)
         {
             SFMLCamera* sfmlCamera = static_cast<SFMLCamera*>(gameScene->getCamera());
             mRenderWindow->setView(sfmlCamera->getSFMLView());
         }
+
+        mStats.endFrame();
+    }
+
+    void SFMLRenderer::captureSnapshot(common::GameScene* gameScene, graphics::RenderSnapshot& snapshot)
+    {
+        Renderer::captureSnapshot(gameScene, snapshot);
+
+        // The render thread cannot touch the ResourceManager, so it gets the paths from the cache
+        int32_t lastAtlas = -1;
+        for (uint32_t l = 0; l < snapshot.mLayerCount; l++)
+        {
+            for (const graphics::RenderSnapshot::Sprite& sprite : snapshot.mLayers[l].mSprites)
+            {
+                if (sprite.mAtlasID != lastAtlas)
+                {
+                    mTextureCache.resolveAtlas(sprite.mAtlasID);
+                    lastAtlas = sprite.mAtlasID;
+                }
+            }
+        }
+    }
+
+    void SFMLRenderer::execute(const graphics::RenderCommandBuffer& commands)
+    {
+        mStats.beginPhase(graphics::RenderStats::PHASE_BATCH);
+        clearRetained();
+        mRenderBuffer->clear(sf::Color::Black);
+        mRenderWindow->clear(sf::Color::Black);
+
+        mBatchCount = 0;
+        mVertexCount = 0;
+
+        // RenderVertex shares sf::Vertex's layout so the recorded vertices are submitted as is
+        const sf::Vertex* vertices = reinterpret_cast<const sf::Vertex*>(commands.getVertices().data());
+        sf::RenderTarget* target = mRenderBuffer;
+        sf::RenderStates states;
+        sf::PrimitiveType primitiveType = sf::Quads;
+
+        for (const graphics::RenderCommandBuffer::Command& command : commands.getCommands())
+        {
+            switch (command.mType)
+            {
+            case graphics::RenderCommandBuffer::COMMAND_SETTARGET:
+                if (command.mArgument == graphics::RenderCommandBuffer::RENDERTARGET_SCENE)
+                    target = mRenderBuffer;
+                else
+                    target = mRenderWindow;
+                break;
+            case graphics::RenderCommandBuffer::COMMAND_SETVIEW:
+            {
+                // The camera moves the window's view of the buffer, as with draw()
+                const graphics::RenderSnapshot::CameraSnapshot& camera = commands.getViews()[command.mArgument];
+                if (camera.mValid)
+                {
+                    sf::View view;
+                    view.setCenter(camera.mCentre[0], camera.mCentre[1]);
+                    view.setSize(camera.mDimensions[0], camera.mDimensions[1]);
+                    view.setRotation(camera.mRotation);
+
+                    std::lock_guard<std::mutex> lock(mWindowMutex);
+                    mRenderWindow->setView(view);
+                }
+                break;
+            }
+            case graphics::RenderCommandBuffer::COMMAND_SETSTATE:
+            {
+                const graphics::RenderCommandBuffer::State& state = commands.getStates()[command.mArgument];
+                const sf::Texture* texture = mTextureCache.getTexture(state.mAtlasID);
+                if (texture != states.texture)
+                    mStats.countTextureSwitch();
+
+                states.texture = texture;
+                states.blendMode = convertBlendMode(state.mBlendMode);
+                primitiveType = convertPrimitiveType(state.mPrimitiveType);
+                mStats.countBatch();
+                break;
+            }
+            case graphics::RenderCommandBuffer::COMMAND_DRAW:
+                mStats.beginPhase(graphics::RenderStats::PHASE_BATCH);
+                target->draw(vertices + command.mFirst, command.mCount, primitiveType, states);
+                mStats.countDrawCall(command.mCount);
+                mBatchCount++;
+                mVertexCount += command.mCount;
+                break;
+            case graphics::RenderCommandBuffer::COMMAND_LIGHTING:
+                executeLighting(commands, command);
+                break;
+            case graphics::RenderCommandBuffer::COMMAND_POSTPROCESS:
+                executePostProcess();
+                break;
+            }
+        }
+
+        mStats.beginPhase(graphics::RenderStats::PHASE_PRESENT);
+        mRenderBuffer->display();
+        {
+            // Polling a resize on the window's thread replaces the view this draw reads
+            std::lock_guard<std::mutex> lock(mWindowMutex);
+            mRenderWindow->draw(*mRenderBufferSpr);
+        }
+        mRenderWindow->display();
+        mTextureCache.update();
+        updateTitle();
+    }
+
+    void SFMLRenderer::updateTitle()
+    {
+        // Formatted into a fixed buffer and only twice a second, the stats carry the per-frame numbers.
+        // The rate is counted from the frames presented here, as this may run on the render thread
+        mTitleFrames++;
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        float elapsed = std::chrono::duration<float>(now - mTitleUpdated).count();
+        if (elapsed < 0.5f)
+            return;
+
+        // Only the window's thread may set the title, Windows would block on it otherwise
+        char title[64];
+        std::snprintf(title, sizeof(title), "Window - %.1f", mTitleFrames / elapsed);
+        mTitleUpdated = now;
+        mTitleFrames = 0;
+
+        std::lock_guard<std::mutex> lock(mWindowMutex);
+        mTitle = title;
+    }
+
+    void SFMLRenderer::setRenderThreadActive(bool active)
+    {
+        // Only the contexts move, the window stays with the thread that created it
+        mRenderBuffer->setActive(active);
+        mRenderWindow->setActive(active);
+
+        if (mLightingManager != nullptr)
+            mLightingManager->setRenderThreadActive(active);
+    }
+
+    void SFMLRenderer::pollEvents(std::vector<sf::Event>& events)
+    {
+        events.clear();
+
+        std::lock_guard<std::mutex> lock(mWindowMutex);
+        if (mTitle.empty() == false)
+        {
+            mRenderWindow->setTitle(mTitle);
+            mTitle.clear();
+        }
+
+        sf::Event event;
+        while (mRenderWindow->pollEvent(event))
+            events.push_back(event);
     }
 
     void SFMLRenderer::drawPreprocess(common::GameScene* gameScene)
     {
-        std::vector<common::Layer*> layers = gameScene->getLayers();
-        mBatchGroups.clear();
-        mBatchGroups.resize(layers.size());
-        int32_t layerCounter = -1;
+        utilities::Span<common::Layer* const> layers = gameScene->getLayers();
+        if (layers.size() != mRetainedLayers.size() || !std::equal(layers.begin(), layers.end(), mRetainedLayers.begin()))
+        {
+            clearRetained();
+            mRetainedLayers = layers.toVector();
+            mBatchGroups.resize(layers.size());
+            mBatchIndices.resize(layers.size());
+        }
+
+        mRetainedFrame++;
 
         float x1 = 0.f, y1 = 0.f;
         float x2 = 0.f, y2 = 0.f;
@@ -77,45 +242,89 @@ namespace impl {
             y2 = camera->getCentre()[1] + camera->getDimensions()[1];
         }
 
-        for (common::Layer* layer : layers)
+        // Split every Layer into chunks, only a spatial query narrows the Entities
+        // otherwise they are viewed in place
+        mRetainChunks.clear();
+        mLayerQueries.resize(layers.size());
+        mLayerGeometry.resize(layers.size());
+        mSortedLayers.resize(layers.size());
+
+        for (uint32_t l = 0; l < layers.size(); l++)
         {
-            std::vector<common::Entity*> entities = layer->getEntities({ x1,y1,x2,y2 });
-            layerCounter++;
+            utilities::Span<common::Entity* const> entities = layers[l]->getEntities();
+            uint32_t entityCount = entities.size();
 
-            for (int32_t i = 0; i < entities.size(); i++)
+            // Static layers are drawn from their baked geometry, their Entities lose their ranges
+            if (layers[l]->isStatic())
             {
-                if (entities[i]->getEntityState() != common::Entity::ENTITYSTATE_ACTIVE)
-                    continue;
+                entities = utilities::Span<common::Entity* const>();
+                entityCount = 0;
+            }
+            else if (layers[l]->getSpatialHash() != nullptr)
+            {
+                mLayerQueries[l] = layers[l]->getEntities({ x1,y1,x2,y2 });
+                entities = mLayerQueries[l];
+            }
 
-                std::vector<SFMLBatchGroup>::iterator it;
-                int32_t atlasID = entities[i]->mAtlasID;
-                int32_t shaderID = entities[i]->mShaderID;
-                int32_t blendMode = entities[i]->mBlendMode;
-                int32_t primitiveType = entities[i]->mPrimitiveType;
+            mStats.setLayer(l, entities.size(), entityCount - entities.size());
+            mLayerGeometry[l].clear();
+            layers[l]->getGeometry({ x1, y1, x2, y2 }, mLayerGeometry[l]);
 
-                it = std::find_if(mBatchGroups[layerCounter].begin(), mBatchGroups[layerCounter].end(),
-                    std::bind(&SFMLRenderer::predicateFunc, this, std::placeholders::_1, atlasID, shaderID, blendMode, primitiveType));
+            // Retained batches group Entities by state, sorted Layers are drawn by depth instead
+            // and their Entities give back any retained range in the sweep below
+            mSortedLayers[l].mDrawList.clear();
+            if (layers[l]->getSortMode() != common::Layer::SORTMODE_NONE)
+            {
+                sortLayer(layers[l], entities, mSortedLayers[l]);
+                continue;
+            }
 
-                if (it == mBatchGroups[layerCounter].end())
-                {
-                    SFMLBatchGroup batchGroup(atlasID, shaderID, blendMode, primitiveType);
-                    for (auto vertex : entities[i]->getVertices())
-                        batchGroup.insertVertex(convertSFMLVertex(vertex));
-                    mBatchGroups[layerCounter].push_back(batchGroup);
-                }
-                else
-                {
-                    for (auto vertex : entities[i]->getVertices())
-                        (*it).insertVertex(convertSFMLVertex(vertex));
-                }
+            for (uint32_t first = 0; first < entities.size(); first += RETAIN_CHUNK_SIZE)
+            {
+                uint32_t count = entities.size() - first;
+                if (count > RETAIN_CHUNK_SIZE)
+                    count = RETAIN_CHUNK_SIZE;
+
+                RetainChunk chunk;
+                chunk.mLayer = l;
+                chunk.mEntities = utilities::Span<common::Entity* const>(entities.data() + first, count);
+                mRetainChunks.push_back(chunk);
+            }
+        }
+
+        // Entities keeping their range are refreshed in parallel, each chunk only writes the
+        // ranges of its own Entities. The rest need the shared maps and are handled after
+        if (mDeferredEntities.size() < mRetainChunks.size())
+            mDeferredEntities.resize(mRetainChunks.size());
+
+        utilities::ThreadPool::instance().parallelFor(mRetainChunks.size(), [this](uint32_t c) {
+            mDeferredEntities[c].clear();
+            for (common::Entity* entity : mRetainChunks[c].mEntities)
+            {
+                if (!refreshEntity(mRetainChunks[c].mLayer, entity))
+                    mDeferredEntities[c].push_back(entity);
+            }
+        });
+
+        for (uint32_t c = 0; c < mRetainChunks.size(); c++)
+        {
+            for (common::Entity* entity : mDeferredEntities[c])
+                retainEntity(mRetainChunks[c].mLayer, entity);
+        }
 
-                if (atlasID != -1 && mTextures.find(atlasID) == mTextures.end())
+        // Entities not drawn this frame (culled, asleep, removed or deleted) give their range back
+        for (uint32_t l = 0; l < mBatchGroups.size(); l++)
+        {
+            for (uint32_t b = 0; b < mBatchGroups[l].size(); b++)
+            {
+                SFMLBatchGroup& batch = mBatchGroups[l][b];
+                for (uint32_t c = 0; c < batch.getSizeClassCount(); c++)
                 {
-                    sf::Texture texture;
-                    data::TextureAtlas* atlas = nullptr;
-                    atlas = common::ResourceManager<data::TextureAtlas>::getResource(atlasID);
-                    texture.loadFromFile(atlas->getTexturePath());
-                    mTextures[atlasID] = texture;
+                    for (int32_t s = batch.getSlotCount(c) - 1; s >= 0; s--)
+                    {
+                        if (batch.getSlot(c, s).mFrame != mRetainedFrame)
+                            releaseSlot(l, b, c, s);
+                    }
                 }
             }
         }
@@ -123,36 +332,217 @@ namespace impl {
 
     void SFMLRenderer::drawBatched(common::GameScene* gameScene)
     {
-        int32_t layerCount = gameScene->getLayers().size();
+        drawBatched(gameScene->getLayers().size());
+    }
+
+    void SFMLRenderer::drawBatched(uint32_t layerCount)
+    {
+        mBatchCount = 0;
+        mVertexCount = 0;
+        const sf::Texture* boundTexture = nullptr;
 
         for (int32_t i = 0; i < layerCount; i++)
         {
+            // Cached geometry goes beneath the Entities and shares sf::Vertex's layout
+            for (const common::Layer::GeometryBlock& block : mLayerGeometry[i])
+            {
+                sf::RenderStates states;
+                states.texture = mTextureCache.getTexture(block.mAtlasID);
+                states.blendMode = convertBlendMode(block.mBlendMode);
+
+                if (states.texture != boundTexture)
+                {
+                    mStats.countTextureSwitch();
+                    boundTexture = states.texture;
+                }
+
+                mRenderBuffer->draw(reinterpret_cast<const sf::Vertex*>(block.mVertices), block.mVertexCount,
+                                    convertPrimitiveType(block.mPrimitiveType), states);
+                mStats.countDrawCall(block.mVertexCount);
+                mBatchCount++;
+                mVertexCount += block.mVertexCount;
+            }
+
+            const SortedLayer& sorted = mSortedLayers[i];
+            for (const graphics::DrawList::DrawCall& call : sorted.mDrawList.getDrawCalls())
+            {
+                sf::RenderStates states;
+                states.texture = mTextureCache.getTexture(graphics::DrawList::getAtlasID(call.mKey));
+                states.blendMode = convertBlendMode(graphics::DrawList::getBlendMode(call.mKey));
+
+                if (states.texture != boundTexture)
+                {
+                    mStats.countTextureSwitch();
+                    boundTexture = states.texture;
+                }
+
+                mRenderBuffer->draw(sorted.mVertices.data() + call.mFirstVertex, call.mVertexCount,
+                                    convertPrimitiveType(graphics::DrawList::getPrimitiveType(call.mKey)), states);
+                mStats.countDrawCall(call.mVertexCount);
+                mBatchCount++;
+                mVertexCount += call.mVertexCount;
+            }
+
             for (int32_t b = 0; b < mBatchGroups[i].size(); b++)
             {
+                const SFMLBatchGroup& batch = mBatchGroups[i][b];
+                if (batch.getSlotCount() == 0)
+                    continue;
+
                 sf::RenderStates states;
-                std::vector<sf::Vertex> vertices;
+                states.texture = mTextureCache.getTexture(batch.getAtlasID());
+                states.blendMode = convertBlendMode(batch.getBlendMode());
 
-                if (mBatchGroups[i][b].getAtlasID() != -1)
-                    states.texture = &mTextures[mBatchGroups[i][b].getAtlasID()];
+                if (states.texture != boundTexture)
+                {
+                    mStats.countTextureSwitch();
+                    boundTexture = states.texture;
+                }
 
-                states.blendMode = convertBlendMode(mBatchGroups[i][b].getBlendMode());
-                vertices = mBatchGroups[i][b].getVertices();
+                mStats.countBatch();
 
-                sf::PrimitiveType type;
-                int32_t pType = mBatchGroups[i][b].getPrimitiveType();
+                // Each size class is its own vertex array, so one draw call per class in use
+                for (uint32_t c = 0; c < batch.getSizeClassCount(); c++)
+                {
+                    const std::vector<sf::Vertex>& vertices = batch.getVertices(c);
+                    if (vertices.empty())
+                        continue;
+
+                    mRenderBuffer->draw(vertices.data(), vertices.size(), 
+                                        convertPrimitiveType(batch.getPrimitiveType()), states);
+                    mStats.countDrawCall(vertices.size());
+                    mBatchCount++;
+                    mVertexCount += vertices.size();
+                }
+            }
+        }
+    }
 
-                if (pType == 0)
-                    type = sf::PrimitiveType::Quads;
-                else if (pType == 1)
-                    type = sf::PrimitiveType::Lines;
-                else if (pType == 2)
-                    type = sf::PrimitiveType::Points;
-                else
-                    type = sf::PrimitiveType::Quads;
+    bool SFMLRenderer::refreshEntity(uint32_t layer, common::Entity* entity)
+    {
+        if (entity->getEntityState() != common::Entity::ENTITYSTATE_ACTIVE)
+            return true;
+
+        std::unordered_map<const common::Entity*, RetainedSlot>::const_iterator retained = mRetainedSlots.find(entity);
+        if (retained == mRetainedSlots.end() || (*retained).second.mLayer != layer)
+            return false;
+
+        RetainedSlot location = (*retained).second;
+        SFMLBatchGroup& batch = mBatchGroups[location.mLayer][location.mBatch];
+        SFMLBatchGroup::Slot& slot = batch.getSlot(location.mClass, location.mSlot);
+        utilities::Span<utilities::Vertex2* const> vertices = entity->getVertices();
+
+        if (slot.mVertexCount != vertices.size() ||
+            !predicateFunc(batch, entity->mAtlasID, entity->mShaderID, entity->mBlendMode, entity->mPrimitiveType))
+            return false;
+
+        slot.mFrame = mRetainedFrame;
+        sf::Vertex* destination = batch.getSlotVertices(location.mClass, location.mSlot);
+
+        for (uint32_t v = 0; v < vertices.size(); v++)
+        {
+            if (vertices[v]->hasChanged())
+            {
+                destination[v] = convertSFMLVertex(vertices[v]);
+                vertices[v]->resetChanged();
+            }
+        }
+
+        return true;
+    }
+
+    void SFMLRenderer::retainEntity(uint32_t layer, common::Entity* entity)
+    {
+        utilities::Span<utilities::Vertex2* const> vertices = entity->getVertices();
+        int32_t atlasID = entity->mAtlasID;
+        int32_t shaderID = entity->mShaderID;
+        int32_t blendMode = entity->mBlendMode;
+        int32_t primitiveType = entity->mPrimitiveType;
+
+        std::unordered_map<const common::Entity*, RetainedSlot>::iterator retained = mRetainedSlots.find(entity);
+        if (retained != mRetainedSlots.end())
+        {
+            RetainedSlot location = (*retained).second;
+            releaseSlot(location.mLayer, location.mBatch, location.mClass, location.mSlot);
+        }
+
+        // Batches are found by their state key in the Layer's own map, the key only has room
+        // for 128 layers so the layer is left out of it
+        std::unordered_map<uint64_t, uint32_t>& indices = mBatchIndices[layer];
+        uint64_t key = graphics::DrawList::makeKey(0, shaderID, atlasID, blendMode, primitiveType);
+        std::unordered_map<uint64_t, uint32_t>::iterator index = indices.find(key);
+
+        if (index == indices.end())
+        {
+            mBatchGroups[layer].emplace_back(atlasID, shaderID, blendMode, primitiveType);
+            index = indices.emplace(key, static_cast<uint32_t>(mBatchGroups[layer].size() - 1)).first;
+        }
+
+        SFMLBatchGroup& batch = mBatchGroups[layer][(*index).second];
+        RetainedSlot location;
+        location.mLayer = layer;
+        location.mBatch = (*index).second;
+        location.mClass = batch.getSizeClass(vertices.size());
+        location.mSlot = batch.insertSlot(location.mClass, entity, mRetainedFrame);
+        mRetainedSlots[entity] = location;
+
+        sf::Vertex* destination = batch.getSlotVertices(location.mClass, location.mSlot);
+        for (uint32_t v = 0; v < vertices.size(); v++)
+        {
+            destination[v] = convertSFMLVertex(vertices[v]);
+            vertices[v]->resetChanged();
+        }
+    }
 
-                mRenderBuffer->draw(vertices.data(), vertices.size(), type, states);
+    void SFMLRenderer::sortLayer(const common::Layer* layer, utilities::Span<common::Entity* const> entities, SortedLayer& sorted)
+    {
+        sorted.mDrawList.clear();
+        sorted.mSource.clear();
+
+        for (common::Entity* entity : entities)
+        {
+            if (entity->getEntityState() != common::Entity::ENTITYSTATE_ACTIVE)
+                continue;
+
+            utilities::Span<utilities::Vertex2* const> vertices = entity->getVertices();
+            if (vertices.size() == 0)
+                continue;
+
+            // Same depth as graphics::RenderSnapshot, the top 24 bits of the order preserving key
+            uint32_t depth = utilities::DepthSorter<common::Entity*>::toKey(layer->getSortDepth(entity)) >> 8;
+            uint64_t key = graphics::DrawList::makeDepthKey(0, depth, entity->mShaderID, entity->mAtlasID,
+                                                            entity->mBlendMode, entity->mPrimitiveType);
+            sorted.mDrawList.insert(key, sorted.mSource.size(), vertices.size());
+
+            for (uint32_t v = 0; v < vertices.size(); v++)
+            {
+                sorted.mSource.push_back(convertSFMLVertex(vertices[v]));
+                vertices[v]->resetChanged();
             }
         }
+
+        sorted.mDrawList.sort();
+        sorted.mVertices.resize(sorted.mDrawList.getVertexCount());
+        sorted.mDrawList.gather(sorted.mSource.data(), sorted.mVertices.data());
+    }
+
+    void SFMLRenderer::releaseSlot(uint32_t layer, uint32_t batch, uint32_t sizeClass, uint32_t slot)
+    {
+        SFMLBatchGroup& group = mBatchGroups[layer][batch];
+        mRetainedSlots.erase(group.getSlot(sizeClass, slot).mEntity);
+
+        // The last Slot of the class was swapped in, it is the only one that moved
+        group.removeSlot(sizeClass, slot);
+        if (slot < group.getSlotCount(sizeClass))
+            mRetainedSlots[group.getSlot(sizeClass, slot).mEntity].mSlot = slot;
+    }
+
+    void SFMLRenderer::clearRetained()
+    {
+        mBatchGroups.clear();
+        mBatchIndices.clear();
+        mRetainedSlots.clear();
+        mRetainedLayers.clear();
     }
 
     bool SFMLRenderer::predicateFunc(SFMLBatchGroup& batch, int32_t atlasID, int32_t shaderID, int32_t blendMode, int32_t primitiveType)
@@ -183,6 +573,18 @@ namespace impl {
         return vertex;
     }
 
+    sf::PrimitiveType SFMLRenderer::convertPrimitiveType(int32_t primitiveType)
+    {
+        if (primitiveType == 0)
+            return sf::PrimitiveType::Quads;
+        else if (primitiveType == 1)
+            return sf::PrimitiveType::Lines;
+        else if (primitiveType == 2)
+            return sf::PrimitiveType::Points;
+
+        return sf::PrimitiveType::Quads;
+    }
+
     sf::BlendMode SFMLRenderer::convertBlendMode(int32_t blendMode)
     {
         if (blendMode == 0)
@@ -202,6 +604,11 @@ namespace impl {
         return mRenderWindow;
     }
 
+    SFMLTextureCache& SFMLRenderer::getTextureCache()
+    {
+        return mTextureCache;
+    }
+
     sf::RenderTexture* SFMLRenderer::getRenderBuffer() const
     {
         return mRenderBuffer;
@@ -1,9 +1,15 @@
 #ifdef SFML
 #include <SFML/Graphics.hpp>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 #include "SFMLCamera.h"
 #include "SFMLBatchGroup.h"
+#include "SFMLTextureCache.h"
 #include "../../data/Settings.h"
 #include "../../graphics/Renderer.h"
+#include "../../graphics/DrawList.h"
 #include "../../common/GameScene.h"
 
 namespace liquid { namespace impl {
@@ -16,6 +22,12 @@ namespace liquid { namespace impl {
  * \ingroup Impl
  * \brief SFML specific implementation of the graphics::Renderer class
  *
+ * When common::GameManager pipelines rendering, the render thread takes over the window
+ * and buffer contexts and draws the snapshots handed to it. The window itself stays with
+ * the thread that created it, which keeps polling it through pollEvents(), as Windows and
+ * macOS only deliver events to that thread. The frame rate the render thread measures is
+ * put in the title by the same call.
+ *
  * \author Jamie Massey
  * \version 1.1
  * \date 17/04/2017
@@ -29,6 +41,33 @@ public:
     typedef std::vector<SFMLBatchGroup> BatchGroup;
     typedef std::vector<BatchGroup> LayeredBatchGroup;
 
+    /// Where an Entity's vertices live in the retained batches
+    struct RetainedSlot
+    {
+        uint32_t mLayer; ///< Index of the Layer in mBatchGroups
+        uint32_t mBatch; ///< Index of the SFMLBatchGroup in the Layer
+        uint32_t mClass; ///< Index of the size class in the SFMLBatchGroup
+        uint32_t mSlot;  ///< Index of the Slot in the size class
+    };
+
+    /// Run of a Layer's Entities refreshed by one parallel task
+    struct RetainChunk
+    {
+        uint32_t                               mLayer;    ///< Index of the Layer
+        utilities::Span<common::Entity* const> mEntities; ///< Entities of the chunk
+    };
+
+    /// Geometry of a depth sorted Layer, rebuilt in draw order every frame
+    struct SortedLayer
+    {
+        graphics::DrawList      mDrawList; ///< Ranges of mSource keyed by state and depth
+        std::vector<sf::Vertex> mSource;   ///< Vertices of the drawn Entities in Layer order
+        std::vector<sf::Vertex> mVertices; ///< mSource gathered in draw order
+    };
+
+    /// Number of Entities refreshed by each parallel task
+    static const uint32_t RETAIN_CHUNK_SIZE = 2048;
+
 public:
     /** \brief SFMLRenderer Constructor
       * \param sceneParent Pointer the parent GameScene for this Renderer
@@ -42,8 +81,37 @@ public:
     /// \brief Allows drawing to the sf::RenderWindow, call from GameScene
     virtual void draw(common::GameScene* gameScene) override;
 
+    /// \brief Captures a GameScene and resolves the atlases it uses while still on the simulation thread
+    virtual void captureSnapshot(common::GameScene* gameScene, graphics::RenderSnapshot& snapshot) override;
+
+    /// \brief Draws the commands of a frame into the render buffer and presents it
+    virtual void execute(const graphics::RenderCommandBuffer& commands) override;
+
+    /// \brief Moves the sf::RenderWindow and buffer contexts to or from the calling thread
+    virtual void setRenderThreadActive(bool active) override;
+
+    /** \brief Takes the window events received since the last call
+      * \param events Cleared, then filled with the events in the order they arrived
+      *
+      * Call from the thread that created the renderer, also while a render thread draws.
+      */
+    void pollEvents(std::vector<sf::Event>& events);
+
+    /** \brief Brings the retained batches up to date with a GameScene
+      * \param gameScene Scene to be drawn
+      *
+      * Batches persist across frames and every drawn Entity keeps a stable range of
+      * vertices in its batch. Only vertices whose utilities::Vertex2::hasChanged() flag
+      * is set are converted again, Entities that change batch or vertex count move to
+      * a new range, and Entities no longer drawn give their range back through
+      * swap-compaction. A scene of static sprites costs a lookup per Entity per frame.
+      *
+      * Layers with a common::Layer::eSortMode other than SORTMODE_NONE are not retained,
+      * their Entities are sorted by depth through a graphics::DrawList every frame.
+      */
     virtual void drawPreprocess(common::GameScene* gameScene);
     virtual void drawBatched(common::GameScene* gameScene);
+    virtual void drawBatched(uint32_t layerCount);
 
     bool predicateFunc(SFMLBatchGroup& batch, int32_t atlasID, int32_t shaderID, int32_t blendMode, int32_t primitiveType);
 
@@ -51,21 +119,82 @@ public:
 
     sf::BlendMode convertBlendMode(int32_t blendMode);
 
+    sf::PrimitiveType convertPrimitiveType(int32_t primitiveType);
+
+    /// \brief Drops every retained batch, the next frame rebuilds them from scratch
+    void clearRetained();
+
     /// \return Pointer to the running sf::RenderWindow for this Renderer
     sf::RenderWindow* getRenderWindow() const;
 
     /// \return Pointer to the current sf::RenderTexture that is the buffer
     sf::RenderTexture* getRenderBuffer() const;
 
+    /// \return The cache that loads and keeps the atlas textures resident
+    SFMLTextureCache& getTextureCache();
+
     /// \brief Updates the mRenderWindow with the current Camera
     void updateCamera() const;
 
+    /// \brief Counts a presented frame and, at most twice a second, passes the frame rate to pollEvents() for the title
+    void updateTitle();
+
 protected:
     sf::RenderWindow* mRenderWindow; ///< Pointer to the stored sf::Renderwindow
     sf::RenderTexture* mRenderBuffer;
     sf::Sprite* mRenderBufferSpr;
-    std::map<int32_t, sf::Texture> mTextures;
+    SFMLTextureCache mTextureCache; ///< Atlas textures, loaded in the background on first use
     LayeredBatchGroup mBatchGroups;
+
+protected:
+    /** \brief Updates the dirty vertices of an Entity whose range is still valid
+      * \param layer Index of the Layer the Entity is drawn in
+      * \param entity Entity being drawn this frame
+      * \return False if the Entity needs a new range from retainEntity()
+      *
+      * Only reads the shared maps and writes the Entity's own range, so it is safe to
+      * call for different Entities from several threads at once.
+      */
+    bool refreshEntity(uint32_t layer, common::Entity* entity);
+
+    /** \brief Moves an Entity into a new range of the right retained batch
+      * \param layer Index of the Layer the Entity is drawn in
+      * \param entity Entity being drawn this frame
+      */
+    void retainEntity(uint32_t layer, common::Entity* entity);
+
+    /** \brief Rebuilds the depth ordered geometry of a sorted Layer
+      * \param layer Layer the Entities belong to, gives their depth
+      * \param entities Entities drawn this frame
+      * \param sorted Geometry to rebuild
+      */
+    void sortLayer(const common::Layer* layer, utilities::Span<common::Entity* const> entities, SortedLayer& sorted);
+
+    /** \brief Gives back the range of an Entity in a retained batch
+      * \param layer Index of the Layer
+      * \param batch Index of the SFMLBatchGroup in the Layer
+      * \param sizeClass Index of the size class in the SFMLBatchGroup
+      * \param slot Index of the Slot to release
+      */
+    void releaseSlot(uint32_t layer, uint32_t batch, uint32_t sizeClass, uint32_t slot);
+
+    std::unordered_map<const common::Entity*, RetainedSlot> mRetainedSlots;  ///< Range of every Entity in the retained batches
+    std::vector<common::Layer*>                             mRetainedLayers; ///< Layers the retained batches were built from
+    uint32_t                                                mRetainedFrame;  ///< Frame counter used to find Entities no longer drawn
+    std::vector<std::unordered_map<uint64_t, uint32_t>>     mBatchIndices;   ///< Retained batch index of each render state key, one map per Layer
+    std::vector<SortedLayer>                                mSortedLayers;   ///< Depth ordered geometry of each sorted Layer this frame
+
+    std::vector<RetainChunk>                  mRetainChunks;      ///< Chunks refreshed in parallel this frame
+    std::vector<std::vector<common::Entity*>> mDeferredEntities;  ///< Per chunk arena of Entities that need a new range
+    std::vector<std::vector<common::Entity*>> mLayerQueries;      ///< Spatial query result of each Layer this frame
+
+    std::vector<std::vector<common::Layer::GeometryBlock>> mLayerGeometry; ///< Visible cached geometry of each Layer this frame
+
+    std::chrono::steady_clock::time_point mTitleUpdated; ///< When updateTitle() last changed the title
+    uint32_t                              mTitleFrames;  ///< Frames presented since mTitleUpdated
+
+    std::mutex  mWindowMutex; ///< Guards the window's view and mTitle between the render thread and pollEvents()
+    std::string mTitle;       ///< Title waiting for pollEvents() to set it, empty if unchanged
 };
 
 #endif // _SFMLRENDERER_H
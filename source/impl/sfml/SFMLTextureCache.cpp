@@ -0,0 +1,262 @@
+#ifdef SFML
+#include "SFMLTextureCache.h"
+#include "../../common/ResourceManager.h"
+#include "../../data/TextureAtlas.h"
+#include <algorithm>
+
+namespace liquid {
+namespace impl {
+
+    SFMLTextureCache::SFMLTextureCache(uint32_t threadCount)
+    {
+        mUploadBudget = 8 * 1024 * 1024;
+        mMemoryBudget = 0;
+        mMemoryUsage = 0;
+        mPendingCount = 0;
+        mFrame = 0;
+        mOwnerThread = std::this_thread::get_id();
+        mThreadPool = new utilities::ThreadPool(std::max(threadCount, 1u));
+
+        // Grey checkerboard, repeated so any texture coordinates show the pattern
+        sf::Image checker;
+        checker.create(8, 8);
+        for (uint32_t y = 0; y < 8; y++)
+        {
+            for (uint32_t x = 0; x < 8; x++)
+                checker.setPixel(x, y, ((x / 4 + y / 4) % 2 == 0) ? sf::Color(96, 96, 96) : sf::Color(160, 160, 160));
+        }
+
+        mPlaceholder.loadFromImage(checker);
+        mPlaceholder.setRepeated(true);
+    }
+
+    SFMLTextureCache::~SFMLTextureCache()
+    {
+        clear();
+
+        delete mThreadPool;
+        mThreadPool = nullptr;
+    }
+
+    const sf::Texture* SFMLTextureCache::getTexture(int32_t atlasID)
+    {
+        if (atlasID == -1)
+            return nullptr;
+
+        std::unordered_map<int32_t, Entry>::iterator found = mEntries.find(atlasID);
+        if (found == mEntries.end())
+        {
+            // Not resolved by the owning thread yet, asked for again next frame
+            std::string path;
+            if (findPath(atlasID, path))
+                requestTexture(atlasID, path, mEntries[atlasID]);
+
+            return &mPlaceholder;
+        }
+
+        Entry& entry = (*found).second;
+        entry.mLastUsed = mFrame;
+
+        if (entry.mState != TEXTURESTATE_RESIDENT)
+            return &mPlaceholder;
+
+        mUsageOrder.splice(mUsageOrder.begin(), mUsageOrder, entry.mUsage);
+        return &entry.mTexture;
+    }
+
+    void SFMLTextureCache::resolveAtlas(int32_t atlasID)
+    {
+        if (atlasID == -1 || mResolved.count(atlasID) > 0)
+            return;
+
+        mResolved.insert(atlasID);
+        data::TextureAtlas* atlas = common::ResourceManager<data::TextureAtlas>::getResource(atlasID);
+        std::string path = (atlas != nullptr) ? atlas->getTexturePath() : std::string();
+
+        std::lock_guard<std::mutex> lock(mPathMutex);
+        mPaths[atlasID] = path;
+    }
+
+    void SFMLTextureCache::update()
+    {
+        std::vector<Decode> finished;
+        {
+            std::lock_guard<std::mutex> lock(mFinishedMutex);
+            finished.swap(mFinished);
+        }
+
+        for (Decode& decode : finished)
+        {
+            Entry& entry = mEntries[decode.mAtlasID];
+            if (decode.mImage == nullptr)
+            {
+                entry.mState = TEXTURESTATE_FAILED;
+                mPendingCount--;
+                continue;
+            }
+
+            entry.mState = TEXTURESTATE_DECODED;
+            entry.mImage = decode.mImage;
+            mDecoded.push_back(decode.mAtlasID);
+        }
+
+        // Upload the oldest decoded images until this frame's budget is spent
+        uint64_t uploaded = 0;
+        uint32_t count = 0;
+
+        for (; count < mDecoded.size(); count++)
+        {
+            Entry& entry = mEntries[mDecoded[count]];
+            sf::Vector2u size = entry.mImage->getSize();
+            uint64_t bytes = (uint64_t)size.x * size.y * 4;
+
+            if (uploaded > 0 && uploaded + bytes > mUploadBudget)
+                break;
+
+            if (entry.mTexture.loadFromImage(*entry.mImage))
+            {
+                entry.mState = TEXTURESTATE_RESIDENT;
+                entry.mBytes = bytes;
+                mUsageOrder.push_front(mDecoded[count]);
+                entry.mUsage = mUsageOrder.begin();
+                mMemoryUsage += bytes;
+            }
+            else
+                entry.mState = TEXTURESTATE_FAILED;
+
+            delete entry.mImage;
+            entry.mImage = nullptr;
+            uploaded += bytes;
+            mPendingCount--;
+        }
+
+        mDecoded.erase(mDecoded.begin(), mDecoded.begin() + count);
+
+        evictTextures();
+        mFrame++;
+    }
+
+    void SFMLTextureCache::setUploadBudget(uint64_t bytes)
+    {
+        mUploadBudget = bytes;
+    }
+
+    void SFMLTextureCache::setMemoryBudget(uint64_t bytes)
+    {
+        mMemoryBudget = bytes;
+    }
+
+    void SFMLTextureCache::clear()
+    {
+        mThreadPool->waitIdle();
+
+        for (Decode& decode : mFinished)
+            delete decode.mImage;
+
+        for (auto& entry : mEntries)
+            delete entry.second.mImage;
+
+        mFinished.clear();
+        mEntries.clear();
+        mUsageOrder.clear();
+        mDecoded.clear();
+        mMemoryUsage = 0;
+        mPendingCount = 0;
+    }
+
+    bool SFMLTextureCache::isResident(int32_t atlasID) const
+    {
+        std::unordered_map<int32_t, Entry>::const_iterator found = mEntries.find(atlasID);
+        return found != mEntries.end() && (*found).second.mState == TEXTURESTATE_RESIDENT;
+    }
+
+    const uint64_t SFMLTextureCache::getMemoryUsage() const
+    {
+        return mMemoryUsage;
+    }
+
+    const uint32_t SFMLTextureCache::getResidentCount() const
+    {
+        return mUsageOrder.size();
+    }
+
+    const uint32_t SFMLTextureCache::getPendingCount() const
+    {
+        return mPendingCount;
+    }
+
+    const sf::Texture& SFMLTextureCache::getPlaceholder() const
+    {
+        return mPlaceholder;
+    }
+
+    bool SFMLTextureCache::findPath(int32_t atlasID, std::string& path)
+    {
+        // The ResourceManager is not thread safe, only the owning thread may resolve
+        if (std::this_thread::get_id() == mOwnerThread)
+            resolveAtlas(atlasID);
+
+        std::lock_guard<std::mutex> lock(mPathMutex);
+        std::unordered_map<int32_t, std::string>::const_iterator found = mPaths.find(atlasID);
+        if (found == mPaths.end())
+            return false;
+
+        path = (*found).second;
+        return true;
+    }
+
+    void SFMLTextureCache::requestTexture(int32_t atlasID, const std::string& path, Entry& entry)
+    {
+        entry.mImage = nullptr;
+        entry.mBytes = 0;
+        entry.mLastUsed = mFrame;
+
+        if (path.empty())
+        {
+            entry.mState = TEXTURESTATE_FAILED;
+            return;
+        }
+
+        entry.mState = TEXTURESTATE_DECODING;
+        mPendingCount++;
+
+        mThreadPool->submit([this, atlasID, path]()
+        {
+            Decode decode;
+            decode.mAtlasID = atlasID;
+            decode.mImage = new sf::Image();
+
+            if (decode.mImage->loadFromFile(path) == false)
+            {
+                delete decode.mImage;
+                decode.mImage = nullptr;
+            }
+
+            std::lock_guard<std::mutex> lock(mFinishedMutex);
+            mFinished.push_back(decode);
+        });
+    }
+
+    void SFMLTextureCache::evictTextures()
+    {
+        if (mMemoryBudget == 0)
+            return;
+
+        // Most recently used first, so stop at the first texture drawn this frame
+        while (mMemoryUsage > mMemoryBudget && mUsageOrder.empty() == false)
+        {
+            int32_t atlasID = mUsageOrder.back();
+            Entry& entry = mEntries[atlasID];
+
+            if (entry.mLastUsed == mFrame)
+                break;
+
+            mMemoryUsage -= entry.mBytes;
+            mUsageOrder.pop_back();
+            mEntries.erase(atlasID);
+        }
+    }
+
+}}
+
+#endif // SFML
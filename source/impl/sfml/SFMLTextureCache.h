@@ -0,0 +1,169 @@
+#ifdef SFML
+#include <SFML/Graphics.hpp>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <list>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <stdint.h>
+#include "../../utilities/ThreadPool.h"
+
+namespace liquid { namespace impl {
+#ifndef _SFMLTEXTURECACHE_H
+#define _SFMLTEXTURECACHE_H
+
+/**
+ * \class SFMLTextureCache
+ *
+ * \ingroup Impl
+ * \brief Loads atlas textures in the background and keeps the recently used ones resident
+ *
+ * The first getTexture() of an atlas queues its image to be decoded on a background
+ * thread from data::TextureAtlas::getTexturePath() and returns a placeholder. Decoded
+ * images are uploaded by update(), which the renderer calls once per frame, until the
+ * upload budget for that frame is spent. Once the resident textures exceed the memory
+ * budget the least recently drawn ones are evicted, they load again when next drawn.
+ *
+ * Everything except the decoding runs on the thread that owns the render context. The
+ * ResourceManager is only touched on the thread that created the cache: resolveAtlas()
+ * copies the texture path of an atlas into a table the render thread reads, and
+ * SFMLRenderer calls it for every atlas a snapshot uses while capturing it.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class SFMLTextureCache
+{
+public:
+    /// Residency of one atlas texture
+    enum eTextureState
+    {
+        TEXTURESTATE_DECODING = 0,
+        TEXTURESTATE_DECODED = 1,
+        TEXTURESTATE_RESIDENT = 2,
+        TEXTURESTATE_FAILED = 3,
+    };
+
+    /// One atlas known to the cache
+    struct Entry
+    {
+        eTextureState                mState;    ///< Where the texture is in its lifetime
+        sf::Texture                  mTexture;  ///< Uploaded texture, valid when resident
+        sf::Image*                   mImage;    ///< Decoded image waiting for upload, owned
+        uint64_t                     mBytes;    ///< Size of the texture in bytes
+        uint32_t                     mLastUsed; ///< Last frame the texture was asked for
+        std::list<int32_t>::iterator mUsage;    ///< Position in mUsageOrder, valid when resident
+    };
+
+    /// An image finished by a background thread
+    struct Decode
+    {
+        int32_t    mAtlasID; ///< Atlas the image belongs to
+        sf::Image* mImage;   ///< Decoded image, nullptr if decoding failed
+    };
+
+public:
+    /** \brief SFMLTextureCache Constructor
+      * \param threadCount Number of background threads used for decoding
+      */
+    SFMLTextureCache(uint32_t threadCount = 1);
+
+    /// SFMLTextureCache Destructor, waits for images still being decoded
+    ~SFMLTextureCache();
+
+    /** \brief Gets the texture of an atlas, requesting it if it is not resident
+      * \param atlasID Atlas of the texture
+      * \return The texture when resident, otherwise the placeholder texture
+      */
+    const sf::Texture* getTexture(int32_t atlasID);
+
+    /** \brief Looks up the texture path of an atlas so any thread can load it
+      * \param atlasID Atlas to resolve, ignored if -1 or already resolved
+      *
+      * Call on the thread that created the cache, the one that owns the ResourceManager.
+      */
+    void resolveAtlas(int32_t atlasID);
+
+    /** \brief Uploads decoded images and evicts textures over the memory budget
+      *
+      * Call once per frame on the render thread, after the frame has been displayed.
+      */
+    void update();
+
+    /** \brief Sets the bytes of decoded images that may be uploaded per frame
+      * \param bytes Budget in bytes, at least one image is always uploaded
+      */
+    void setUploadBudget(uint64_t bytes);
+
+    /** \brief Sets the bytes resident textures may use before the least recently used are evicted
+      * \param bytes Budget in bytes, 0 for unlimited
+      */
+    void setMemoryBudget(uint64_t bytes);
+
+    /// \brief Releases every texture, images still decoding are finished first
+    void clear();
+
+    /** \brief Checks if the texture of an atlas can be drawn
+      * \param atlasID Atlas of the texture
+      * \return True if resident, False if loading, evicted or never requested
+      */
+    bool isResident(int32_t atlasID) const;
+
+    /// \return Bytes used by resident textures
+    const uint64_t getMemoryUsage() const;
+
+    /// \return Number of resident textures
+    const uint32_t getResidentCount() const;
+
+    /// \return Number of images decoding or waiting for upload
+    const uint32_t getPendingCount() const;
+
+    /// \return The texture drawn in place of one that is not resident yet
+    const sf::Texture& getPlaceholder() const;
+
+protected:
+    /** \brief Finds the texture path resolved for an atlas
+      * \param atlasID Atlas to look up, resolved first when called on the owning thread
+      * \param path Set to the path, empty if the atlas does not exist
+      * \return True if the atlas has been resolved
+      */
+    bool findPath(int32_t atlasID, std::string& path);
+
+    /** \brief Queues the image of an atlas to be decoded in the background
+      * \param atlasID Atlas to load
+      * \param path Texture path of the atlas, empty if the atlas does not exist
+      * \param entry Entry of the atlas
+      */
+    void requestTexture(int32_t atlasID, const std::string& path, Entry& entry);
+
+    /// \brief Evicts least recently used textures until within the memory budget
+    void evictTextures();
+
+protected:
+    std::unordered_map<int32_t, Entry>       mEntries;       ///< Every requested atlas keyed by atlas ID
+    std::unordered_map<int32_t, std::string> mPaths;         ///< Texture path of every resolved atlas, empty if missing
+    std::mutex                               mPathMutex;     ///< Guards mPaths
+    std::unordered_set<int32_t>              mResolved;      ///< Atlases already resolved, read by the owning thread only
+    std::thread::id                          mOwnerThread;   ///< Thread that created the cache and may use the ResourceManager
+    std::list<int32_t>                       mUsageOrder;    ///< Resident atlases, most recently used first
+    std::vector<Decode>                      mFinished;      ///< Decodes finished by the background threads
+    std::mutex                               mFinishedMutex; ///< Guards mFinished
+    std::vector<int32_t>                     mDecoded;       ///< Atlases decoded and waiting for upload, oldest first
+    sf::Texture                              mPlaceholder;   ///< Drawn until a texture is resident
+    uint64_t                                 mUploadBudget;  ///< Bytes uploaded per frame
+    uint64_t                                 mMemoryBudget;  ///< Resident bytes allowed, 0 for unlimited
+    uint64_t                                 mMemoryUsage;   ///< Bytes used by resident textures
+    uint32_t                                 mPendingCount;  ///< Images decoding or waiting for upload
+    uint32_t                                 mFrame;         ///< Frame counter used for the usage order
+    utilities::ThreadPool*                   mThreadPool;    ///< Background threads for decoding
+};
+
+#endif // _SFMLTEXTURECACHE_H
+}}
+
+#endif // SFML
@@ -0,0 +1,409 @@
+#include "SoftwareLightingManager.h"
+#include "SoftwareRenderer.h"
+#include "../../utilities/ThreadPool.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define LIQUID_SOFTWARE_SSE
+#endif
+
+namespace liquid {
+namespace impl {
+
+    namespace
+    {
+#if defined(LIQUID_SOFTWARE_SSE)
+
+        /// Adds a run of interpolated colours to lightmap texels, one texel per register
+        inline void addSpan(float* texels, int32_t count, const float* start, const float* step)
+        {
+            __m128 colour = _mm_loadu_ps(start);
+            __m128 colourStep = _mm_loadu_ps(step);
+
+            for (int32_t i = 0; i < count; i++)
+            {
+                _mm_storeu_ps(texels, _mm_add_ps(_mm_loadu_ps(texels), colour));
+                colour = _mm_add_ps(colour, colourStep);
+                texels += 4;
+            }
+        }
+
+        /** Multiplies a row of the framebuffer by the lightmap, blending two lightmap rows
+          * by rowWeight and neighbouring columns by the weight of every pixel's column.
+          */
+        inline void multiplyRow(uint32_t* pixels, uint32_t count, const float* row0, const float* row1, float rowWeight,
+                                const uint32_t* columnTexels, const float* columnWeights, uint32_t lightmapWidth)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128 limit = _mm_set1_ps(255.0f);
+            const __m128 inverse255 = _mm_set1_ps(1.0f / 255.0f);
+            const __m128 weight1 = _mm_set1_ps(rowWeight);
+            const __m128 weight0 = _mm_set1_ps(1.0f - rowWeight);
+
+            for (uint32_t x = 0; x < count; x++)
+            {
+                uint32_t left = columnTexels[x] * 4;
+                uint32_t right = (columnTexels[x] + 1 < lightmapWidth) ? left + 4 : left;
+
+                __m128 a = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(row0 + left), weight0), _mm_mul_ps(_mm_loadu_ps(row1 + left), weight1));
+                __m128 b = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(row0 + right), weight0), _mm_mul_ps(_mm_loadu_ps(row1 + right), weight1));
+                __m128 light = _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), _mm_set1_ps(columnWeights[x])));
+
+                // The accumulation texture of the SFML backend saturates, so light never brightens
+                light = _mm_mul_ps(_mm_min_ps(light, limit), inverse255);
+
+                __m128 target = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pixels[x]), zero), zero));
+                __m128i packed = _mm_cvtps_epi32(_mm_mul_ps(target, light));
+                packed = _mm_packs_epi32(packed, packed);
+                packed = _mm_packus_epi16(packed, packed);
+                pixels[x] = (uint32_t)_mm_cvtsi128_si32(packed);
+            }
+        }
+
+#else
+
+        /// Adds a run of interpolated colours to lightmap texels
+        inline void addSpan(float* texels, int32_t count, const float* start, const float* step)
+        {
+            float colour[4] = { start[0], start[1], start[2], start[3] };
+
+            for (int32_t i = 0; i < count; i++)
+            {
+                for (uint32_t c = 0; c < 4; c++)
+                {
+                    texels[c] += colour[c];
+                    colour[c] += step[c];
+                }
+
+                texels += 4;
+            }
+        }
+
+        /// Multiplies a row of the framebuffer by the bilinearly sampled lightmap
+        inline void multiplyRow(uint32_t* pixels, uint32_t count, const float* row0, const float* row1, float rowWeight,
+                                const uint32_t* columnTexels, const float* columnWeights, uint32_t lightmapWidth)
+        {
+            for (uint32_t x = 0; x < count; x++)
+            {
+                uint32_t left = columnTexels[x] * 4;
+                uint32_t right = (columnTexels[x] + 1 < lightmapWidth) ? left + 4 : left;
+                uint32_t result = 0;
+
+                for (uint32_t c = 0; c < 4; c++)
+                {
+                    float a = row0[left + c] + (row1[left + c] - row0[left + c]) * rowWeight;
+                    float b = row0[right + c] + (row1[right + c] - row0[right + c]) * rowWeight;
+                    float light = std::min(a + (b - a) * columnWeights[x], 255.0f) / 255.0f;
+                    float target = (float)((pixels[x] >> (c * 8)) & 0xFF);
+                    result |= (uint32_t)std::min(std::max(target * light + 0.5f, 0.0f), 255.0f) << (c * 8);
+                }
+
+                pixels[x] = result;
+            }
+        }
+
+#endif
+    }
+
+    SoftwareLightingManager::SoftwareLightingManager(std::array<float, 4> ambientColour, uint32_t downscale) :
+        LightingManager(ambientColour)
+    {
+        mDownscale = std::max(downscale, 1u);
+        mWidth = mHeight = 0;
+        mTransform.fill(0.0f);
+        mAccumulateTime = 0.0f;
+        mCompositeTime = 0.0f;
+    }
+
+    SoftwareLightingManager::~SoftwareLightingManager()
+    {}
+
+    void SoftwareLightingManager::draw(graphics::Renderer* renderer)
+    {
+        if (getLightCount() == 0)
+            return;
+
+        SoftwareRenderer* softwareRenderer = static_cast<SoftwareRenderer*>(renderer);
+        std::array<float, 4> region = beginFrame(softwareRenderer);
+
+        mLightCuller.cull(mLights, region, { mWidth, mHeight });
+        for (uint32_t light : mLightCuller.getVisibleLights())
+            addFan(*mLights[light]);
+
+        reportCulling(renderer);
+        finishFrame(softwareRenderer, mAmbientColour);
+    }
+
+    void SoftwareLightingManager::drawLights(graphics::Renderer* renderer, const std::array<float, 4>& ambientColour,
+                                             const graphics::Light* lights, uint32_t lightCount)
+    {
+        if (lightCount == 0)
+            return;
+
+        SoftwareRenderer* softwareRenderer = static_cast<SoftwareRenderer*>(renderer);
+        std::array<float, 4> region = beginFrame(softwareRenderer);
+
+        mLightCuller.cull(lights, lightCount, region, { mWidth, mHeight });
+        for (uint32_t light : mLightCuller.getVisibleLights())
+            addFan(lights[light]);
+
+        reportCulling(renderer);
+        finishFrame(softwareRenderer, ambientColour);
+    }
+
+    void SoftwareLightingManager::setDownscale(uint32_t downscale)
+    {
+        mDownscale = std::max(downscale, 1u);
+    }
+
+    const uint32_t SoftwareLightingManager::getDownscale() const
+    {
+        return mDownscale;
+    }
+
+    const float* SoftwareLightingManager::getLightmap() const
+    {
+        return mLightmap.data();
+    }
+
+    const uint32_t SoftwareLightingManager::getLightmapWidth() const
+    {
+        return mWidth;
+    }
+
+    const uint32_t SoftwareLightingManager::getLightmapHeight() const
+    {
+        return mHeight;
+    }
+
+    const float SoftwareLightingManager::getAccumulateTime() const
+    {
+        return mAccumulateTime;
+    }
+
+    const float SoftwareLightingManager::getCompositeTime() const
+    {
+        return mCompositeTime;
+    }
+
+    std::array<float, 4> SoftwareLightingManager::beginFrame(SoftwareRenderer* renderer)
+    {
+        uint32_t framebufferWidth = renderer->getWidth();
+        uint32_t framebufferHeight = renderer->getHeight();
+        float inverseScale = 1.0f / mDownscale;
+
+        mWidth = (framebufferWidth + mDownscale - 1) / mDownscale;
+        mHeight = (framebufferHeight + mDownscale - 1) / mDownscale;
+        mLightmap.resize((size_t)mWidth * mHeight * 4);
+        mVertices.clear();
+        mFans.clear();
+
+        // Texel centres line up with pixel centres, so a downscale of 1 samples texels exactly
+        mColumnTexels.resize(framebufferWidth);
+        mColumnWeights.resize(framebufferWidth);
+        for (uint32_t x = 0; x < framebufferWidth; x++)
+        {
+            float column = std::max((x + 0.5f) * inverseScale - 0.5f, 0.0f);
+            mColumnTexels[x] = std::min((uint32_t)column, mWidth - 1);
+            mColumnWeights[x] = std::min(column - mColumnTexels[x], 1.0f);
+        }
+
+        // Lights are drawn through the view of the scene, as the SFML window view does
+        const std::array<float, 6>& view = renderer->getCurrentViewTransform();
+        for (uint32_t i = 0; i < 6; i++)
+            mTransform[i] = view[i] * inverseScale;
+
+        std::array<float, 4> region = { 0.0f, 0.0f, 0.0f, 0.0f };
+        float determinant = view[0] * view[4] - view[1] * view[3];
+        if (std::fabs(determinant) < 1e-12f)
+            return region;
+
+        region = { FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX };
+        float corners[4][2] = { { 0.0f, 0.0f }, { (float)framebufferWidth, 0.0f },
+                                { 0.0f, (float)framebufferHeight }, { (float)framebufferWidth, (float)framebufferHeight } };
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            float dx = corners[c][0] - view[2], dy = corners[c][1] - view[5];
+            float x = (view[4] * dx - view[1] * dy) / determinant;
+            float y = (view[0] * dy - view[3] * dx) / determinant;
+            region[0] = std::min(region[0], x);
+            region[1] = std::min(region[1], y);
+            region[2] = std::max(region[2], x);
+            region[3] = std::max(region[3], y);
+        }
+
+        return region;
+    }
+
+    void SoftwareLightingManager::addFan(const graphics::Light& light)
+    {
+        const std::vector<graphics::RenderVertex>& mesh = light.getLightGeometry();
+        if (mesh.size() < 3)
+            return;
+
+        std::array<float, 2> position = light.getLightPosition();
+        Fan fan;
+        fan.mFirst = mVertices.size();
+        fan.mCount = mesh.size();
+        fan.mTop = FLT_MAX;
+        fan.mBottom = -FLT_MAX;
+
+        for (const graphics::RenderVertex& vertex : mesh)
+        {
+            float x = position[0] + vertex.mPositionX, y = position[1] + vertex.mPositionY;
+
+            FanVertex transformed;
+            transformed.mPositionX = mTransform[0] * x + mTransform[1] * y + mTransform[2];
+            transformed.mPositionY = mTransform[3] * x + mTransform[4] * y + mTransform[5];
+            for (uint32_t c = 0; c < 4; c++)
+                transformed.mColour[c] = vertex.mColour[c];
+
+            fan.mTop = std::min(fan.mTop, transformed.mPositionY);
+            fan.mBottom = std::max(fan.mBottom, transformed.mPositionY);
+            mVertices.push_back(transformed);
+        }
+
+        mFans.push_back(fan);
+    }
+
+    void SoftwareLightingManager::finishFrame(SoftwareRenderer* renderer, const std::array<float, 4>& ambientColour)
+    {
+        utilities::ThreadPool& threadPool = utilities::ThreadPool::instance();
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+
+        threadPool.parallelFor((mHeight + BAND_HEIGHT - 1) / BAND_HEIGHT, [this, &ambientColour](uint32_t band) {
+            accumulateBand(band, ambientColour);
+        });
+
+        std::chrono::high_resolution_clock::time_point accumulated = std::chrono::high_resolution_clock::now();
+        threadPool.parallelFor((renderer->getHeight() + BAND_HEIGHT - 1) / BAND_HEIGHT, [this, renderer](uint32_t band) {
+            compositeBand(renderer, band);
+        });
+
+        std::chrono::high_resolution_clock::time_point composited = std::chrono::high_resolution_clock::now();
+        mAccumulateTime = std::chrono::duration<float, std::milli>(accumulated - start).count();
+        mCompositeTime = std::chrono::duration<float, std::milli>(composited - accumulated).count();
+    }
+
+    void SoftwareLightingManager::accumulateBand(uint32_t band, const std::array<float, 4>& ambientColour)
+    {
+        int32_t rowStart = band * BAND_HEIGHT;
+        int32_t rowEnd = std::min(rowStart + (int32_t)BAND_HEIGHT, (int32_t)mHeight);
+
+        float* texels = &mLightmap[(size_t)rowStart * mWidth * 4];
+        for (size_t t = 0; t < (size_t)(rowEnd - rowStart) * mWidth; t++)
+            std::copy(ambientColour.begin(), ambientColour.end(), texels + t * 4);
+
+        for (const Fan& fan : mFans)
+        {
+            if (fan.mBottom < rowStart || fan.mTop >= rowEnd)
+                continue;
+
+            const FanVertex* vertices = &mVertices[fan.mFirst];
+            for (uint32_t v = 1; v + 1 < fan.mCount; v++)
+                accumulateTriangle(vertices[0], vertices[v], vertices[v + 1], rowStart, rowEnd);
+        }
+    }
+
+    void SoftwareLightingManager::accumulateTriangle(const FanVertex& v0, const FanVertex& v1, const FanVertex& v2,
+                                                     int32_t rowStart, int32_t rowEnd)
+    {
+        const FanVertex* vertices[3] = { &v0, &v1, &v2 };
+        float x0 = v0.mPositionX, y0 = v0.mPositionY;
+
+        // Most triangles of a fan miss a given band, so they are rejected before any setup
+        float minY = std::min(std::min(y0, v1.mPositionY), v2.mPositionY);
+        float maxY = std::max(std::max(y0, v1.mPositionY), v2.mPositionY);
+        rowStart = std::max(rowStart, (int32_t)std::ceil(minY - 0.5f));
+        rowEnd = std::min(rowEnd, (int32_t)std::ceil(maxY - 0.5f));
+        if (rowStart >= rowEnd)
+            return;
+
+        float area = (v1.mPositionX - x0) * (v2.mPositionY - y0) - (v2.mPositionX - x0) * (v1.mPositionY - y0);
+        if (std::fabs(area) < 1e-6f)
+            return;
+
+        // Colour is affine across the triangle, so each channel has a constant gradient
+        float stepX[4], stepY[4];
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            float delta1 = v1.mColour[c] - v0.mColour[c], delta2 = v2.mColour[c] - v0.mColour[c];
+            stepX[c] = (delta1 * (v2.mPositionY - y0) - delta2 * (v1.mPositionY - y0)) / area;
+            stepY[c] = (delta2 * (v1.mPositionX - x0) - delta1 * (v2.mPositionX - x0)) / area;
+        }
+
+        // Fan triangles are thin slivers a few texels wide, so the edges are set up once
+        // rather than per row. Edges run top to bottom so the spokes shared by neighbouring
+        // triangles give both the same x and, being half open, are not added twice
+        float edgeTop[3], edgeBottom[3], edgeX[3], edgeSlope[3];
+        for (uint32_t e = 0; e < 3; e++)
+        {
+            const FanVertex* top = vertices[e];
+            const FanVertex* bottom = vertices[(e + 1) % 3];
+            if (top->mPositionY > bottom->mPositionY)
+                std::swap(top, bottom);
+
+            edgeTop[e] = top->mPositionY;
+            edgeBottom[e] = bottom->mPositionY;
+            edgeX[e] = top->mPositionX;
+            edgeSlope[e] = (edgeBottom[e] > edgeTop[e]) ?
+                (bottom->mPositionX - top->mPositionX) / (edgeBottom[e] - edgeTop[e]) : 0.0f;
+        }
+
+        for (int32_t y = rowStart; y < rowEnd; y++)
+        {
+            float centreY = y + 0.5f;
+            float left = FLT_MAX, right = -FLT_MAX;
+
+            for (uint32_t e = 0; e < 3; e++)
+            {
+                if (centreY < edgeTop[e] || centreY >= edgeBottom[e])
+                    continue;
+
+                float x = edgeX[e] + (centreY - edgeTop[e]) * edgeSlope[e];
+                left = std::min(left, x);
+                right = std::max(right, x);
+            }
+
+            if (left >= right)
+                continue;
+
+            int32_t columnStart = std::max(0, (int32_t)std::ceil(left - 0.5f));
+            int32_t columnEnd = std::min((int32_t)mWidth, (int32_t)std::ceil(right - 0.5f));
+            if (columnStart >= columnEnd)
+                continue;
+
+            float start[4];
+            for (uint32_t c = 0; c < 4; c++)
+                start[c] = v0.mColour[c] + stepX[c] * (columnStart + 0.5f - x0) + stepY[c] * (centreY - y0);
+
+            addSpan(&mLightmap[((size_t)y * mWidth + columnStart) * 4], columnEnd - columnStart, start, stepX);
+        }
+    }
+
+    void SoftwareLightingManager::compositeBand(SoftwareRenderer* renderer, uint32_t band)
+    {
+        uint32_t width = renderer->getWidth();
+        uint32_t rowStart = band * BAND_HEIGHT;
+        uint32_t rowEnd = std::min(rowStart + BAND_HEIGHT, renderer->getHeight());
+        uint32_t* pixels = renderer->getPixels();
+        float inverseScale = 1.0f / mDownscale;
+
+        for (uint32_t y = rowStart; y < rowEnd; y++)
+        {
+            float row = std::max((y + 0.5f) * inverseScale - 0.5f, 0.0f);
+            uint32_t row0 = std::min((uint32_t)row, mHeight - 1);
+            uint32_t row1 = std::min(row0 + 1, mHeight - 1);
+            float rowWeight = std::min(row - row0, 1.0f);
+
+            multiplyRow(&pixels[(size_t)y * width], width, &mLightmap[(size_t)row0 * mWidth * 4],
+                        &mLightmap[(size_t)row1 * mWidth * 4], rowWeight, mColumnTexels.data(),
+                        mColumnWeights.data(), mWidth);
+        }
+    }
+
+}}
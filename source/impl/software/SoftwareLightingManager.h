@@ -0,0 +1,159 @@
+#include <array>
+#include <vector>
+#include <stdint.h>
+#include "../../graphics/LightingManager.h"
+
+namespace liquid { namespace impl {
+#ifndef _SOFTWARELIGHTINGMANAGER_H
+#define _SOFTWARELIGHTINGMANAGER_H
+
+class SoftwareRenderer;
+
+/**
+ * \class SoftwareLightingManager
+ *
+ * \ingroup Impl
+ * \brief graphics::LightingManager that lights the framebuffer of a SoftwareRenderer on the CPU
+ *
+ * Follows SFMLLightingManager: the lightmap is cleared to the ambient colour, the fan of
+ * every light that survives culling is added on top, and the framebuffer is multiplied
+ * by the lightmap, the BlendMode(Zero, SrcColor) composite of the SFML backend. Light
+ * values saturate at 255 like the 8-bit accumulation texture does.
+ *
+ * The lightmap holds RGBA floats at a fraction of the framebuffer resolution and is
+ * upsampled bilinearly when composited. Both passes are split into horizontal bands
+ * spread across utilities::ThreadPool::instance(), each band only rasterising the fans
+ * that overlap it, and texels are blended one per SSE register where available. The
+ * bands test the rows of each transformed fan rather than graphics::LightCuller tiles,
+ * which are laid over the bounding box of a rotated view and would not match the rows,
+ * so tile binning is left off.
+ *
+ * The renderer passed to draw() and drawLights() must be a SoftwareRenderer.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class SoftwareLightingManager : public graphics::LightingManager
+{
+public:
+    /// Rows of the lightmap or framebuffer handled by each parallel task
+    static const uint32_t BAND_HEIGHT = 16;
+
+public:
+    /** \brief SoftwareLightingManager Constructor
+      * \param ambientColour Colour the lightmap is cleared to (r,g,b,a) as 0 - 255
+      * \param downscale Framebuffer pixels per lightmap texel in each direction
+      */
+    SoftwareLightingManager(std::array<float, 4> ambientColour, uint32_t downscale = 2);
+
+    /// SoftwareLightingManager Destructor
+    ~SoftwareLightingManager();
+
+    /// \brief Lights the framebuffer with the lights of this manager
+    virtual void draw(graphics::Renderer* renderer) override;
+
+    /// \brief Lights the framebuffer with the lights of a snapshot
+    virtual void drawLights(graphics::Renderer* renderer, const std::array<float, 4>& ambientColour,
+                            const graphics::Light* lights, uint32_t lightCount) override;
+
+    /** \brief Sets the resolution of the lightmap relative to the framebuffer
+      * \param downscale Framebuffer pixels per lightmap texel in each direction, 1 for full resolution
+      */
+    void setDownscale(uint32_t downscale);
+
+    /// \return Framebuffer pixels per lightmap texel in each direction
+    const uint32_t getDownscale() const;
+
+    /// \return Lightmap of the last draw as RGBA floats, top row first
+    const float* getLightmap() const;
+
+    /// \return Width of the lightmap in texels
+    const uint32_t getLightmapWidth() const;
+
+    /// \return Height of the lightmap in texels
+    const uint32_t getLightmapHeight() const;
+
+    /// \return Milliseconds spent accumulating lights in the last draw
+    const float getAccumulateTime() const;
+
+    /// \return Milliseconds spent multiplying the lightmap over the framebuffer in the last draw
+    const float getCompositeTime() const;
+
+protected:
+    /// Fan vertex in lightmap space
+    struct FanVertex
+    {
+        float mPositionX; ///< Column in texels
+        float mPositionY; ///< Row in texels
+        float mColour[4]; ///< Colour (r,g,b,a) as 0 - 255
+    };
+
+    /// Culled light ready to rasterise
+    struct Fan
+    {
+        uint32_t mFirst;  ///< Index of the centre in mVertices
+        uint32_t mCount;  ///< Number of vertices, centre included
+        float    mTop;    ///< Topmost row the fan reaches
+        float    mBottom; ///< Bottommost row the fan reaches
+    };
+
+    /** \brief Sizes the lightmap to the framebuffer and takes the view of the renderer
+      * \param renderer Renderer being lit
+      * \return Region of the world the framebuffer shows as (x1, y1, x2, y2)
+      */
+    std::array<float, 4> beginFrame(SoftwareRenderer* renderer);
+
+    /** \brief Moves the fan of a light into lightmap space and queues it
+      * \param light Light to queue
+      */
+    void addFan(const graphics::Light& light);
+
+    /** \brief Accumulates the queued fans and composites the lightmap
+      * \param renderer Renderer being lit
+      * \param ambientColour Colour the lightmap is cleared to
+      */
+    void finishFrame(SoftwareRenderer* renderer, const std::array<float, 4>& ambientColour);
+
+    /** \brief Clears a band of the lightmap and adds every fan overlapping it
+      * \param band Index of the band
+      * \param ambientColour Colour the band is cleared to
+      */
+    void accumulateBand(uint32_t band, const std::array<float, 4>& ambientColour);
+
+    /** \brief Adds a triangle to the rows of the lightmap in a band
+      * \param v0 First vertex
+      * \param v1 Second vertex
+      * \param v2 Third vertex
+      * \param rowStart First row that may be written
+      * \param rowEnd Row past the last that may be written
+      */
+    void accumulateTriangle(const FanVertex& v0, const FanVertex& v1, const FanVertex& v2,
+                            int32_t rowStart, int32_t rowEnd);
+
+    /** \brief Multiplies a band of the framebuffer by the upsampled lightmap
+      * \param renderer Renderer being lit
+      * \param band Index of the band
+      */
+    void compositeBand(SoftwareRenderer* renderer, uint32_t band);
+
+protected:
+    uint32_t               mDownscale;      ///< Framebuffer pixels per lightmap texel
+    uint32_t               mWidth;          ///< Width of the lightmap
+    uint32_t               mHeight;         ///< Height of the lightmap
+    std::vector<float>     mLightmap;       ///< RGBA floats, top row first
+    std::array<float, 6>   mTransform;      ///< World to lightmap transform of the frame, 2x3 row major
+
+    std::vector<FanVertex> mVertices;       ///< Fans of the frame in lightmap space
+    std::vector<Fan>       mFans;           ///< Culled lights of the frame
+    std::vector<uint32_t>  mColumnTexels;   ///< Left lightmap column sampled by every framebuffer column
+    std::vector<float>     mColumnWeights;  ///< Weight of the right column for every framebuffer column
+
+    float                  mAccumulateTime; ///< Milliseconds spent accumulating in the last draw
+    float                  mCompositeTime;  ///< Milliseconds spent compositing in the last draw
+};
+
+#endif // _SOFTWARELIGHTINGMANAGER_H
+}}
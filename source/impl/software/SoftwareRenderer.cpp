@@ -0,0 +1,708 @@
+#include "SoftwareRenderer.h"
+#include "../../common/ResourceManager.h"
+#include "../../data/TextureAtlas.h"
+#include "../../utilities/PNGWriter.h"
+#include "../../utilities/ThreadPool.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#ifdef SFML
+    #include <SFML/Graphics.hpp>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define LIQUID_SOFTWARE_SSE
+#endif
+
+namespace liquid {
+namespace impl {
+
+    namespace
+    {
+        /// Blend modes in the order of SFMLRenderer::convertBlendMode()
+        enum eBlendMode
+        {
+            BLEND_ALPHA = 0,
+            BLEND_ADD = 1,
+            BLEND_MULTIPLY = 2,
+            BLEND_NONE = 3,
+        };
+
+        /// Number of interpolated attributes: red, green, blue, alpha, u, v
+        const uint32_t ATTRIBUTE_COUNT = 6;
+
+        /// Texels around a texture coordinate in pixels weighted by their distance, clamped to the edges
+        inline uint32_t sampleLinear(const SoftwareRenderer::Texture* texture, float u, float v)
+        {
+            // Texel centres are at half pixels
+            float x = std::floor(u - 0.5f), y = std::floor(v - 0.5f);
+            float weightX = u - 0.5f - x, weightY = v - 0.5f - y;
+
+            int32_t maxX = (int32_t)texture->mWidth - 1, maxY = (int32_t)texture->mHeight - 1;
+            int32_t x0 = std::min(std::max((int32_t)x, 0), maxX), x1 = std::min(std::max((int32_t)x + 1, 0), maxX);
+            int32_t y0 = std::min(std::max((int32_t)y, 0), maxY), y1 = std::min(std::max((int32_t)y + 1, 0), maxY);
+
+            const uint32_t* pixels = texture->mPixels.data();
+            uint32_t topLeft = pixels[y0 * texture->mWidth + x0], topRight = pixels[y0 * texture->mWidth + x1];
+            uint32_t bottomLeft = pixels[y1 * texture->mWidth + x0], bottomRight = pixels[y1 * texture->mWidth + x1];
+
+            uint32_t texel = 0;
+            for (uint32_t c = 0; c < 32; c += 8)
+            {
+                float left = (float)((topLeft >> c) & 0xFF), right = (float)((topRight >> c) & 0xFF);
+                float top = left + (right - left) * weightX;
+                left = (float)((bottomLeft >> c) & 0xFF);
+                right = (float)((bottomRight >> c) & 0xFF);
+                float bottom = left + (right - left) * weightX;
+                texel |= (uint32_t)(top + (bottom - top) * weightY + 0.5f) << c;
+            }
+
+            return texel;
+        }
+
+        /// Texel at a texture coordinate in pixels, nearest unless the texture is smooth, clamped to the edges
+        inline uint32_t sampleTexel(const SoftwareRenderer::Texture* texture, float u, float v)
+        {
+            if (texture == nullptr)
+                return 0xFFFFFFFF;
+            else if (texture->mSmooth)
+                return sampleLinear(texture, u, v);
+
+            // Truncation only differs from floor below zero, which clamps to 0 either way
+            int32_t x = std::min(std::max((int32_t)u, 0), (int32_t)texture->mWidth - 1);
+            int32_t y = std::min(std::max((int32_t)v, 0), (int32_t)texture->mHeight - 1);
+            return texture->mPixels[y * texture->mWidth + x];
+        }
+
+        inline uint32_t packColour(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+        {
+            return (uint32_t)r | ((uint32_t)g << 8) | ((uint32_t)b << 16) | ((uint32_t)a << 24);
+        }
+
+#if defined(LIQUID_SOFTWARE_SSE)
+
+        inline __m128 unpackPixel(uint32_t pixel)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pixel), zero), zero));
+        }
+
+        inline uint32_t packPixel(__m128 colour)
+        {
+            // Both packs saturate, so out of range channels clamp to 0 - 255
+            __m128i packed = _mm_cvtps_epi32(colour);
+            packed = _mm_packs_epi32(packed, packed);
+            packed = _mm_packus_epi16(packed, packed);
+            return (uint32_t)_mm_cvtsi128_si32(packed);
+        }
+
+        /** Shades and blends a horizontal run of pixels, one pixel per register with the
+          * channels in the lanes. start and step hold the attributes at the first pixel and
+          * their change per pixel.
+          */
+        template <int32_t BlendMode, bool Textured>
+        void fillSpan(uint32_t* destination, int32_t count, const float* start, const float* step,
+                      const SoftwareRenderer::Texture* texture)
+        {
+            const __m128 inverse255 = _mm_set1_ps(1.0f / 255.0f);
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 alphaLane = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+
+            __m128 colour = _mm_loadu_ps(start);
+            __m128 colourStep = _mm_loadu_ps(step);
+            float u = start[4], v = start[5];
+            const float stepU = step[4], stepV = step[5];
+
+            for (int32_t i = 0; i < count; i++)
+            {
+                // The interpolated colour stays within 0 - 255 up to rounding, which packPixel saturates
+                __m128 source = colour;
+                if (Textured)
+                    source = _mm_mul_ps(_mm_mul_ps(unpackPixel(sampleTexel(texture, u, v)), colour), inverse255);
+
+                __m128 result;
+
+                if (BlendMode == BLEND_NONE)
+                    result = source;
+                else
+                {
+                    __m128 target = unpackPixel(destination[i]);
+
+                    if (BlendMode == BLEND_MULTIPLY)
+                        result = _mm_mul_ps(_mm_mul_ps(source, target), inverse255);
+                    else
+                    {
+                        // Colour is weighted by the source alpha, alpha itself is not
+                        __m128 alpha = _mm_mul_ps(_mm_shuffle_ps(source, source, _MM_SHUFFLE(3, 3, 3, 3)), inverse255);
+                        __m128 factor = _mm_or_ps(_mm_andnot_ps(alphaLane, alpha), _mm_and_ps(alphaLane, one));
+                        result = _mm_mul_ps(source, factor);
+
+                        if (BlendMode == BLEND_ALPHA)
+                            result = _mm_add_ps(result, _mm_mul_ps(target, _mm_sub_ps(one, alpha)));
+                        else
+                            result = _mm_add_ps(result, target);
+                    }
+                }
+
+                destination[i] = packPixel(result);
+                colour = _mm_add_ps(colour, colourStep);
+                u += stepU;
+                v += stepV;
+            }
+        }
+
+#else
+
+        /// Shades and blends a horizontal run of pixels, start and step hold the attributes
+        template <int32_t BlendMode, bool Textured>
+        void fillSpan(uint32_t* destination, int32_t count, const float* start, const float* step,
+                      const SoftwareRenderer::Texture* texture)
+        {
+            float attributes[ATTRIBUTE_COUNT];
+            std::memcpy(attributes, start, sizeof(attributes));
+
+            for (int32_t i = 0; i < count; i++)
+            {
+                uint32_t texel = Textured ? sampleTexel(texture, attributes[4], attributes[5]) : 0xFFFFFFFF;
+                float source[4], target[4], result[4];
+
+                for (uint32_t c = 0; c < 4; c++)
+                {
+                    float vertexColour = std::min(std::max(attributes[c], 0.0f), 255.0f);
+                    source[c] = (float)((texel >> (c * 8)) & 0xFF) * vertexColour / 255.0f;
+                    target[c] = (float)((destination[i] >> (c * 8)) & 0xFF);
+                }
+
+                float alpha = source[3] / 255.0f;
+                for (uint32_t c = 0; c < 4; c++)
+                {
+                    float weighted = (c == 3) ? source[c] : source[c] * alpha;
+
+                    if (BlendMode == BLEND_NONE)
+                        result[c] = source[c];
+                    else if (BlendMode == BLEND_MULTIPLY)
+                        result[c] = source[c] * target[c] / 255.0f;
+                    else if (BlendMode == BLEND_ALPHA)
+                        result[c] = weighted + target[c] * (1.0f - alpha);
+                    else
+                        result[c] = weighted + target[c];
+
+                    result[c] = std::min(std::max(result[c] + 0.5f, 0.0f), 255.0f);
+                }
+
+                destination[i] = packColour((uint8_t)result[0], (uint8_t)result[1], (uint8_t)result[2], (uint8_t)result[3]);
+
+                for (uint32_t a = 0; a < ATTRIBUTE_COUNT; a++)
+                    attributes[a] += step[a];
+            }
+        }
+
+#endif
+
+        /// Picks the fillSpan() instance for a blend mode
+        template <bool Textured>
+        inline void fillSpan(uint32_t* destination, int32_t count, const float* start, const float* step,
+                             const SoftwareRenderer::Texture* texture, int32_t blendMode)
+        {
+            switch (blendMode)
+            {
+            case BLEND_ALPHA:    fillSpan<BLEND_ALPHA, Textured>(destination, count, start, step, texture); break;
+            case BLEND_ADD:      fillSpan<BLEND_ADD, Textured>(destination, count, start, step, texture); break;
+            case BLEND_MULTIPLY: fillSpan<BLEND_MULTIPLY, Textured>(destination, count, start, step, texture); break;
+            default:             fillSpan<BLEND_NONE, Textured>(destination, count, start, step, texture); break;
+            }
+        }
+
+        /// Picks the fillSpan() instance for a blend mode and texture
+        inline void fillSpan(uint32_t* destination, int32_t count, const float* start, const float* step,
+                             const SoftwareRenderer::Texture* texture, int32_t blendMode)
+        {
+            if (texture != nullptr)
+                fillSpan<true>(destination, count, start, step, texture, blendMode);
+            else
+                fillSpan<false>(destination, count, start, step, texture, blendMode);
+        }
+
+        /// Copies the attributes of a vertex into an array
+        inline void getAttributes(const graphics::RenderVertex& vertex, float* attributes)
+        {
+            attributes[0] = vertex.mColour[0];
+            attributes[1] = vertex.mColour[1];
+            attributes[2] = vertex.mColour[2];
+            attributes[3] = vertex.mColour[3];
+            attributes[4] = vertex.mTexCoordX;
+            attributes[5] = vertex.mTexCoordY;
+        }
+
+        /// Number of vertices in one primitive of the given type
+        inline uint32_t getPrimitiveSize(int32_t primitiveType)
+        {
+            if (primitiveType == 1)
+                return 2;
+            else if (primitiveType == 2)
+                return 1;
+
+            return 4;
+        }
+    }
+
+    SoftwareRenderer::SoftwareRenderer(data::Settings* settings) :
+        graphics::Renderer(settings)
+    {
+        mClearColour = packColour(0, 0, 0, 255);
+        mFrameTime = 0.0f;
+        mBinChunkCount = 0;
+        mWidth = mHeight = 0;
+
+        if (settings != nullptr)
+            resize(settings->getScreenWidth(), settings->getScreenHeight());
+        else
+            resize(1920, 1080);
+
+#ifdef SFML
+        mTextureLoader = [](const std::string& path, uint32_t& width, uint32_t& height, std::vector<uint8_t>& pixels)
+        {
+            sf::Image image;
+            if (image.loadFromFile(path) == false)
+                return false;
+
+            width = image.getSize().x;
+            height = image.getSize().y;
+            pixels.assign(image.getPixelsPtr(), image.getPixelsPtr() + (size_t)width * height * 4);
+            return true;
+        };
+#endif
+    }
+
+    SoftwareRenderer::~SoftwareRenderer()
+    {}
+
+    void SoftwareRenderer::draw(common::GameScene* gameScene)
+    {
+        captureSnapshot(gameScene, mSnapshot);
+        drawSnapshot(mSnapshot);
+    }
+
+    void SoftwareRenderer::execute(const graphics::RenderCommandBuffer& commands)
+    {
+        std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+        mStats.beginPhase(graphics::RenderStats::PHASE_BATCH);
+
+        mDraws.clear();
+        mPrimitives.clear();
+        mViewTransforms.clear();
+
+        // Until the first SETVIEW the framebuffer shows the default view
+        graphics::RenderSnapshot::CameraSnapshot defaultView;
+        defaultView.mValid = false;
+        mViewTransforms.push_back(getViewTransform(defaultView));
+
+        // Resolve the state and view of every draw, both targets are the one framebuffer.
+        // Post processing is SFML specific and is skipped
+        const graphics::RenderVertex* vertices = commands.getVertices().data();
+        mScreenVertices.resize(commands.getVertices().size());
+        bool cleared = false;
+        Draw current;
+        current.mTexture = nullptr;
+        current.mBlendMode = 0;
+        current.mPrimitiveType = 0;
+        uint32_t vertexCount = 0;
+
+        for (const graphics::RenderCommandBuffer::Command& command : commands.getCommands())
+        {
+            if (command.mType == graphics::RenderCommandBuffer::COMMAND_LIGHTING && mLightingManager != nullptr)
+            {
+                // Lights multiply what is drawn so far, later draws are drawn over them
+                flushPrimitives(vertices, cleared == false);
+                cleared = true;
+                executeLighting(commands, command);
+                mStats.beginPhase(graphics::RenderStats::PHASE_BATCH);
+            }
+            else if (command.mType == graphics::RenderCommandBuffer::COMMAND_SETVIEW)
+                mViewTransforms.push_back(getViewTransform(commands.getViews()[command.mArgument]));
+            else if (command.mType == graphics::RenderCommandBuffer::COMMAND_SETSTATE)
+            {
+                const graphics::RenderCommandBuffer::State& state = commands.getStates()[command.mArgument];
+                const Texture* texture = getTexture(state.mAtlasID);
+                if (texture != current.mTexture)
+                    mStats.countTextureSwitch();
+
+                current.mTexture = texture;
+                current.mBlendMode = state.mBlendMode;
+                current.mPrimitiveType = state.mPrimitiveType;
+                mStats.countBatch();
+            }
+            else if (command.mType == graphics::RenderCommandBuffer::COMMAND_DRAW)
+            {
+                current.mView = mViewTransforms.size() - 1;
+                current.mVertexCount = command.mCount;
+                mDraws.push_back(current);
+                mStats.countDrawCall(command.mCount);
+                vertexCount += command.mCount;
+
+                uint32_t size = getPrimitiveSize(current.mPrimitiveType);
+                for (uint32_t v = 0; v + size <= command.mCount; v += size)
+                {
+                    Primitive primitive;
+                    primitive.mFirstVertex = command.mFirst + v;
+                    primitive.mDraw = mDraws.size() - 1;
+                    mPrimitives.push_back(primitive);
+                }
+            }
+        }
+
+        flushPrimitives(vertices, cleared == false);
+
+        mBatchCount = mDraws.size();
+        mVertexCount = vertexCount;
+        mFrameTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+
+    void SoftwareRenderer::flushPrimitives(const graphics::RenderVertex* vertices, bool clear)
+    {
+        utilities::ThreadPool& threadPool = utilities::ThreadPool::instance();
+
+        // Bins are kept between frames so their allocations are reused
+        uint32_t tileCount = mTilesX * mTilesY;
+        mBinChunkCount = (mPrimitives.size() + BIN_CHUNK_SIZE - 1) / BIN_CHUNK_SIZE;
+        if (mBins.size() < mBinChunkCount * tileCount)
+            mBins.resize(mBinChunkCount * tileCount);
+
+        threadPool.parallelFor(mBinChunkCount, [this, vertices](uint32_t chunk) {
+            binPrimitives(chunk, vertices);
+        });
+
+        threadPool.parallelFor(tileCount, [this, clear](uint32_t tile) {
+            rasteriseTile(tile, clear);
+        });
+
+        mPrimitives.clear();
+    }
+
+    void SoftwareRenderer::resize(uint32_t width, uint32_t height)
+    {
+        mWidth = width;
+        mHeight = height;
+        mTilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+        mTilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+        mPixels.assign((size_t)width * height, mClearColour);
+        mBins.clear();
+        mBinChunkCount = 0;
+    }
+
+    void SoftwareRenderer::setClearColour(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+    {
+        mClearColour = packColour(r, g, b, a);
+    }
+
+    void SoftwareRenderer::setTexture(int32_t atlasID, uint32_t width, uint32_t height, const uint8_t* pixels, bool smooth)
+    {
+        Texture& texture = mTextures[atlasID];
+        texture.mWidth = width;
+        texture.mHeight = height;
+        texture.mSmooth = smooth;
+        texture.mPixels.resize((size_t)width * height);
+
+        // Bytes are already in the R, G, B, A order of the packed pixels
+        std::memcpy(texture.mPixels.data(), pixels, texture.mPixels.size() * 4);
+    }
+
+    void SoftwareRenderer::setTextureLoader(TextureLoader loader)
+    {
+        mTextureLoader = loader;
+    }
+
+    bool SoftwareRenderer::savePNG(std::string file) const
+    {
+        return utilities::PNGWriter::write(file, mWidth, mHeight, reinterpret_cast<const uint8_t*>(mPixels.data()));
+    }
+
+    const uint32_t* SoftwareRenderer::getPixels() const
+    {
+        return mPixels.data();
+    }
+
+    uint32_t* SoftwareRenderer::getPixels()
+    {
+        return mPixels.data();
+    }
+
+    const std::array<float, 6>& SoftwareRenderer::getCurrentViewTransform() const
+    {
+        return mViewTransforms.back();
+    }
+
+    const uint32_t SoftwareRenderer::getWidth() const
+    {
+        return mWidth;
+    }
+
+    const uint32_t SoftwareRenderer::getHeight() const
+    {
+        return mHeight;
+    }
+
+    const float SoftwareRenderer::getFrameTime() const
+    {
+        return mFrameTime;
+    }
+
+    const SoftwareRenderer::Texture* SoftwareRenderer::getTexture(int32_t atlasID)
+    {
+        if (atlasID == -1)
+            return nullptr;
+
+        std::unordered_map<int32_t, Texture>::iterator found = mTextures.find(atlasID);
+        if (found == mTextures.end())
+        {
+            // Loaded once, a failure is remembered as an empty texture
+            Texture& texture = mTextures[atlasID];
+            texture.mWidth = texture.mHeight = 0;
+            texture.mSmooth = false;
+
+            data::TextureAtlas* atlas = common::ResourceManager<data::TextureAtlas>::getResource(atlasID);
+            std::vector<uint8_t> pixels;
+            uint32_t width = 0, height = 0;
+
+            if (atlas != nullptr && mTextureLoader && mTextureLoader(atlas->getTexturePath(), width, height, pixels) &&
+                pixels.size() >= (size_t)width * height * 4)
+                setTexture(atlasID, width, height, pixels.data());
+
+            found = mTextures.find(atlasID);
+        }
+
+        return ((*found).second.mWidth == 0) ? nullptr : &(*found).second;
+    }
+
+    std::array<float, 6> SoftwareRenderer::getViewTransform(const graphics::RenderSnapshot::CameraSnapshot& camera) const
+    {
+        float centreX = mWidth * 0.5f, centreY = mHeight * 0.5f;
+        float sizeX = (float)mWidth, sizeY = (float)mHeight;
+        float rotation = 0.0f;
+
+        if (camera.mValid)
+        {
+            centreX = camera.mCentre[0];
+            centreY = camera.mCentre[1];
+            sizeX = camera.mDimensions[0];
+            sizeY = camera.mDimensions[1];
+            rotation = camera.mRotation;
+        }
+
+        float radians = rotation * 3.14159265358979f / 180.0f;
+        float cosine = std::cos(radians), sine = std::sin(radians);
+        float scaleX = mWidth / sizeX, scaleY = mHeight / sizeY;
+
+        // Translate the centre to the origin, undo the view rotation, scale to pixels
+        std::array<float, 6> transform;
+        transform[0] = cosine * scaleX;
+        transform[1] = sine * scaleX;
+        transform[2] = -(centreX * cosine + centreY * sine) * scaleX + mWidth * 0.5f;
+        transform[3] = -sine * scaleY;
+        transform[4] = cosine * scaleY;
+        transform[5] = (centreX * sine - centreY * cosine) * scaleY + mHeight * 0.5f;
+        return transform;
+    }
+
+    void SoftwareRenderer::binPrimitives(uint32_t chunk, const graphics::RenderVertex* vertices)
+    {
+        uint32_t tileCount = mTilesX * mTilesY;
+        std::vector<uint32_t>* bins = &mBins[chunk * tileCount];
+        for (uint32_t t = 0; t < tileCount; t++)
+            bins[t].clear();
+
+        uint32_t last = std::min((chunk + 1) * BIN_CHUNK_SIZE, static_cast<uint32_t>(mPrimitives.size()));
+
+        for (uint32_t p = chunk * BIN_CHUNK_SIZE; p < last; p++)
+        {
+            const Primitive& primitive = mPrimitives[p];
+            const Draw& draw = mDraws[primitive.mDraw];
+            const float* view = mViewTransforms[draw.mView].data();
+            uint32_t size = getPrimitiveSize(draw.mPrimitiveType);
+            graphics::RenderVertex* vertex = &mScreenVertices[primitive.mFirstVertex];
+
+            // Into framebuffer space, the same transform the SFML view applies
+            for (uint32_t v = 0; v < size; v++)
+            {
+                vertex[v] = vertices[primitive.mFirstVertex + v];
+                float x = vertex[v].mPositionX, y = vertex[v].mPositionY;
+                vertex[v].mPositionX = view[0] * x + view[1] * y + view[2];
+                vertex[v].mPositionY = view[3] * x + view[4] * y + view[5];
+            }
+
+            float minX = vertex[0].mPositionX, maxX = vertex[0].mPositionX;
+            float minY = vertex[0].mPositionY, maxY = vertex[0].mPositionY;
+            for (uint32_t v = 1; v < size; v++)
+            {
+                minX = std::min(minX, vertex[v].mPositionX);
+                maxX = std::max(maxX, vertex[v].mPositionX);
+                minY = std::min(minY, vertex[v].mPositionY);
+                maxY = std::max(maxY, vertex[v].mPositionY);
+            }
+
+            if (maxX < 0.0f || maxY < 0.0f || minX >= mWidth || minY >= mHeight)
+                continue;
+
+            uint32_t tileX1 = (uint32_t)std::max(minX, 0.0f) / TILE_SIZE;
+            uint32_t tileY1 = (uint32_t)std::max(minY, 0.0f) / TILE_SIZE;
+            uint32_t tileX2 = (uint32_t)std::min(maxX, mWidth - 1.0f) / TILE_SIZE;
+            uint32_t tileY2 = (uint32_t)std::min(maxY, mHeight - 1.0f) / TILE_SIZE;
+
+            for (uint32_t ty = tileY1; ty <= tileY2; ty++)
+            {
+                for (uint32_t tx = tileX1; tx <= tileX2; tx++)
+                    bins[ty * mTilesX + tx].push_back(p);
+            }
+        }
+    }
+
+    void SoftwareRenderer::rasteriseTile(uint32_t tile, bool clear)
+    {
+        uint32_t tileCount = mTilesX * mTilesY;
+        int32_t clip[4];
+        clip[0] = (tile % mTilesX) * TILE_SIZE;
+        clip[1] = (tile / mTilesX) * TILE_SIZE;
+        clip[2] = std::min(clip[0] + (int32_t)TILE_SIZE, (int32_t)mWidth);
+        clip[3] = std::min(clip[1] + (int32_t)TILE_SIZE, (int32_t)mHeight);
+
+        for (int32_t y = clip[1]; clear && y < clip[3]; y++)
+            std::fill(&mPixels[(size_t)y * mWidth + clip[0]], &mPixels[(size_t)y * mWidth + clip[2]], mClearColour);
+
+        // Chunks were binned in draw order, so walking them in turn keeps the order
+        for (uint32_t chunk = 0; chunk < mBinChunkCount; chunk++)
+        {
+            for (uint32_t p : mBins[chunk * tileCount + tile])
+            {
+                const Primitive& primitive = mPrimitives[p];
+                const Draw& draw = mDraws[primitive.mDraw];
+                int32_t blendMode = draw.mBlendMode;
+                int32_t primitiveType = draw.mPrimitiveType;
+                const Texture* texture = draw.mTexture;
+                const graphics::RenderVertex* vertex = &mScreenVertices[primitive.mFirstVertex];
+
+                if (primitiveType == 1)
+                    rasteriseLine(vertex[0], vertex[1], texture, blendMode, clip);
+                else if (primitiveType == 2)
+                {
+                    int32_t x = (int32_t)std::floor(vertex[0].mPositionX);
+                    int32_t y = (int32_t)std::floor(vertex[0].mPositionY);
+
+                    if (x >= clip[0] && x < clip[2] && y >= clip[1] && y < clip[3])
+                    {
+                        float attributes[ATTRIBUTE_COUNT], step[ATTRIBUTE_COUNT] = { 0.0f };
+                        getAttributes(vertex[0], attributes);
+                        fillSpan(&mPixels[(size_t)y * mWidth + x], 1, attributes, step, texture, blendMode);
+                    }
+                }
+                else
+                {
+                    rasteriseTriangle(vertex[0], vertex[1], vertex[2], texture, blendMode, clip);
+                    rasteriseTriangle(vertex[0], vertex[2], vertex[3], texture, blendMode, clip);
+                }
+            }
+        }
+    }
+
+    void SoftwareRenderer::rasteriseTriangle(const graphics::RenderVertex& v0, const graphics::RenderVertex& v1,
+                                             const graphics::RenderVertex& v2, const Texture* texture,
+                                             int32_t blendMode, const int32_t* clip)
+    {
+        const graphics::RenderVertex* vertices[3] = { &v0, &v1, &v2 };
+        float x0 = v0.mPositionX, y0 = v0.mPositionY;
+        float area = (v1.mPositionX - x0) * (v2.mPositionY - y0) - (v2.mPositionX - x0) * (v1.mPositionY - y0);
+
+        if (std::fabs(area) < 1e-6f)
+            return;
+
+        // Attributes are affine across the triangle, so each has a constant gradient
+        float base[ATTRIBUTE_COUNT], a1[ATTRIBUTE_COUNT], a2[ATTRIBUTE_COUNT];
+        float stepX[ATTRIBUTE_COUNT], stepY[ATTRIBUTE_COUNT];
+        getAttributes(v0, base);
+        getAttributes(v1, a1);
+        getAttributes(v2, a2);
+
+        for (uint32_t a = 0; a < ATTRIBUTE_COUNT; a++)
+        {
+            float delta1 = a1[a] - base[a], delta2 = a2[a] - base[a];
+            stepX[a] = (delta1 * (v2.mPositionY - y0) - delta2 * (v1.mPositionY - y0)) / area;
+            stepY[a] = (delta2 * (v1.mPositionX - x0) - delta1 * (v2.mPositionX - x0)) / area;
+        }
+
+        float minY = std::min(std::min(y0, v1.mPositionY), v2.mPositionY);
+        float maxY = std::max(std::max(y0, v1.mPositionY), v2.mPositionY);
+        int32_t rowStart = std::max(clip[1], (int32_t)std::ceil(minY - 0.5f));
+        int32_t rowEnd = std::min(clip[3], (int32_t)std::ceil(maxY - 0.5f));
+
+        for (int32_t y = rowStart; y < rowEnd; y++)
+        {
+            float centreY = y + 0.5f;
+            float left = FLT_MAX, right = -FLT_MAX;
+
+            // Edges are evaluated top to bottom and half open, so the shared diagonal of
+            // a quad gives the same x to both triangles and no pixel is drawn twice
+            for (uint32_t e = 0; e < 3; e++)
+            {
+                const graphics::RenderVertex* top = vertices[e];
+                const graphics::RenderVertex* bottom = vertices[(e + 1) % 3];
+                if (top->mPositionY > bottom->mPositionY)
+                    std::swap(top, bottom);
+
+                if (centreY < top->mPositionY || centreY >= bottom->mPositionY)
+                    continue;
+
+                float x = top->mPositionX + (centreY - top->mPositionY) *
+                    (bottom->mPositionX - top->mPositionX) / (bottom->mPositionY - top->mPositionY);
+                left = std::min(left, x);
+                right = std::max(right, x);
+            }
+
+            if (left >= right)
+                continue;
+
+            int32_t columnStart = std::max(clip[0], (int32_t)std::ceil(left - 0.5f));
+            int32_t columnEnd = std::min(clip[2], (int32_t)std::ceil(right - 0.5f));
+            if (columnStart >= columnEnd)
+                continue;
+
+            float start[ATTRIBUTE_COUNT];
+            for (uint32_t a = 0; a < ATTRIBUTE_COUNT; a++)
+                start[a] = base[a] + stepX[a] * (columnStart + 0.5f - x0) + stepY[a] * (centreY - y0);
+
+            fillSpan(&mPixels[(size_t)y * mWidth + columnStart], columnEnd - columnStart, start, stepX, texture, blendMode);
+        }
+    }
+
+    void SoftwareRenderer::rasteriseLine(const graphics::RenderVertex& v0, const graphics::RenderVertex& v1,
+                                         const Texture* texture, int32_t blendMode, const int32_t* clip)
+    {
+        float deltaX = v1.mPositionX - v0.mPositionX;
+        float deltaY = v1.mPositionY - v0.mPositionY;
+        int32_t steps = std::max(1, (int32_t)std::ceil(std::max(std::fabs(deltaX), std::fabs(deltaY))));
+
+        float start[ATTRIBUTE_COUNT], end[ATTRIBUTE_COUNT], step[ATTRIBUTE_COUNT] = { 0.0f };
+        getAttributes(v0, start);
+        getAttributes(v1, end);
+
+        for (int32_t i = 0; i < steps; i++)
+        {
+            float t = (i + 0.5f) / steps;
+            int32_t x = (int32_t)std::floor(v0.mPositionX + deltaX * t);
+            int32_t y = (int32_t)std::floor(v0.mPositionY + deltaY * t);
+
+            if (x < clip[0] || x >= clip[2] || y < clip[1] || y >= clip[3])
+                continue;
+
+            float attributes[ATTRIBUTE_COUNT];
+            for (uint32_t a = 0; a < ATTRIBUTE_COUNT; a++)
+                attributes[a] = start[a] + (end[a] - start[a]) * t;
+
+            fillSpan(&mPixels[(size_t)y * mWidth + x], 1, attributes, step, texture, blendMode);
+        }
+    }
+
+}}
@@ -0,0 +1,231 @@
+#include <array>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <stdint.h>
+#include "../../graphics/Renderer.h"
+#include "../../graphics/RenderCommandBuffer.h"
+#include "../../graphics/RenderSnapshot.h"
+#include "../../graphics/RenderVertex.h"
+
+namespace liquid { namespace impl {
+#ifndef _SOFTWARERENDERER_H
+#define _SOFTWARERENDERER_H
+
+/**
+ * \class SoftwareRenderer
+ *
+ * \ingroup Impl
+ * \brief graphics::Renderer that rasterises on the CPU into an in-memory RGBA8 framebuffer
+ *
+ * Executes the same graphics::RenderCommandBuffer as the SFML backend without a window
+ * or graphics context, so frames can be rendered, compared and timed on machines without
+ * a GPU, including frames loaded from a file. Primitives are binned into screen tiles in parallel, then every tile is rasterised
+ * by one worker in draw order, spans are shaded with SSE where available. Quads,
+ * lines and points are supported with nearest or, for smooth textures, linear texture
+ * sampling (clamped, texture coordinates in pixels like SFML) and the alpha, add,
+ * multiply and none blend modes.
+ *
+ * LIGHTING commands go to the graphics::LightingManager, which should be a
+ * SoftwareLightingManager: the draws before the command are rasterised, the manager
+ * lights the framebuffer, then the remaining draws follow. Post processing is SFML
+ * specific and is not applied. Textures come from setTexture() or from the
+ * TextureLoader, which decodes through SFML when the engine is built with it; atlases
+ * without a texture are drawn with vertex colours.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class SoftwareRenderer : public graphics::Renderer
+{
+public:
+    /** \brief Decodes the image at a path into RGBA8 pixels
+      * \param path Path of the image, from data::TextureAtlas::getTexturePath()
+      * \param width Width of the decoded image
+      * \param height Height of the decoded image
+      * \param pixels Decoded rows, top row first
+      * \return True if the image was decoded
+      */
+    typedef std::function<bool(const std::string& path, uint32_t& width, uint32_t& height,
+                               std::vector<uint8_t>& pixels)> TextureLoader;
+
+    /// RGBA8 texture held in memory
+    struct Texture
+    {
+        uint32_t              mWidth;  ///< Width in pixels, 0 if the texture failed to load
+        uint32_t              mHeight; ///< Height in pixels
+        std::vector<uint32_t> mPixels; ///< Pixels as packed RGBA8, top row first
+        bool                  mSmooth; ///< True to sample linearly like a smooth sf::Texture
+    };
+
+    /// A DRAW command with the state and view it was issued with
+    struct Draw
+    {
+        const Texture* mTexture;       ///< Texture to sample, nullptr for none
+        int32_t        mBlendMode;     ///< Blend mode
+        int32_t        mPrimitiveType; ///< Primitive type of the vertices
+        uint32_t       mView;          ///< Index of the transform in mViewTransforms
+        uint32_t       mVertexCount;   ///< Number of vertices drawn
+    };
+
+    /// One quad, line or point of a Draw
+    struct Primitive
+    {
+        uint32_t mFirstVertex; ///< Index of the first vertex in mScreenVertices
+        uint32_t mDraw;        ///< Index of the Draw the primitive belongs to
+    };
+
+    /// Width and height of a screen tile in pixels
+    static const uint32_t TILE_SIZE = 64;
+
+    /// Number of primitives binned by each parallel task
+    static const uint32_t BIN_CHUNK_SIZE = 4096;
+
+public:
+    /** \brief SoftwareRenderer Constructor
+      * \param settings Optional Settings of the game, used for the framebuffer size
+      */
+    SoftwareRenderer(data::Settings* settings = nullptr);
+
+    /// SoftwareRenderer Destructor
+    ~SoftwareRenderer();
+
+    /// \brief Captures the GameScene and rasterises it like a snapshot
+    virtual void draw(common::GameScene* gameScene) override;
+
+    /// \brief Rasterises the commands of a frame into the framebuffer
+    virtual void execute(const graphics::RenderCommandBuffer& commands) override;
+
+    /** \brief Resizes the framebuffer, its contents are cleared
+      * \param width Width in pixels
+      * \param height Height in pixels
+      */
+    void resize(uint32_t width, uint32_t height);
+
+    /** \brief Sets the colour the framebuffer is cleared to before every frame
+      * \param r Red (0 - 255)
+      * \param g Green (0 - 255)
+      * \param b Blue (0 - 255)
+      * \param a Alpha (0 - 255)
+      */
+    void setClearColour(uint8_t r, uint8_t g, uint8_t b, uint8_t a);
+
+    /** \brief Provides the texture of an atlas directly
+      * \param atlasID Atlas the texture belongs to
+      * \param width Width in pixels
+      * \param height Height in pixels
+      * \param pixels Rows of RGBA8 pixels, top row first, copied
+      * \param smooth True to sample the texture linearly instead of the nearest texel
+      */
+    void setTexture(int32_t atlasID, uint32_t width, uint32_t height, const uint8_t* pixels, bool smooth = false);
+
+    /** \brief Sets how atlas textures not given to setTexture() are loaded
+      * \param loader Loader to use, an empty function disables loading
+      */
+    void setTextureLoader(TextureLoader loader);
+
+    /** \brief Writes the framebuffer to disk
+      * \param file Path of the PNG file to write
+      * \return True if the file was written
+      */
+    bool savePNG(std::string file) const;
+
+    /// \return Framebuffer pixels as packed RGBA8, top row first
+    const uint32_t* getPixels() const;
+
+    /// \return Framebuffer pixels as packed RGBA8 for passes that write to it, like lighting
+    uint32_t* getPixels();
+
+    /// \return World to framebuffer transform of the view the commands being executed are at, 2x3 row major
+    const std::array<float, 6>& getCurrentViewTransform() const;
+
+    /// \return Width of the framebuffer
+    const uint32_t getWidth() const;
+
+    /// \return Height of the framebuffer
+    const uint32_t getHeight() const;
+
+    /// \return Milliseconds spent rasterising the last frame
+    const float getFrameTime() const;
+
+protected:
+    /** \brief Finds or loads the texture of an atlas
+      * \param atlasID Atlas to look up
+      * \return The texture, nullptr for untextured or failed atlases
+      */
+    const Texture* getTexture(int32_t atlasID);
+
+    /** \brief Builds the transform that maps the world to framebuffer pixels the way the SFML view would
+      * \param camera Camera of the view
+      * \return World to framebuffer transform, 2x3 row major
+      */
+    std::array<float, 6> getViewTransform(const graphics::RenderSnapshot::CameraSnapshot& camera) const;
+
+    /** \brief Moves the vertices of a chunk of mPrimitives into framebuffer space and
+      *        adds the primitives to the bins of the tiles they touch
+      * \param chunk Index of the chunk of mPrimitives
+      * \param vertices Vertices of the RenderCommandBuffer being executed
+      */
+    void binPrimitives(uint32_t chunk, const graphics::RenderVertex* vertices);
+
+    /** \brief Bins and rasterises the primitives gathered since the last flush, then forgets them
+      * \param vertices Vertices of the RenderCommandBuffer being executed
+      * \param clear True to clear the framebuffer first
+      */
+    void flushPrimitives(const graphics::RenderVertex* vertices, bool clear);
+
+    /** \brief Rasterises every primitive binned for a tile, in draw order
+      * \param tile Index of the tile
+      * \param clear True to clear the tile first
+      */
+    void rasteriseTile(uint32_t tile, bool clear);
+
+    /** \brief Rasterises a triangle clipped to a rectangle of the framebuffer
+      * \param v0 First vertex in framebuffer space
+      * \param v1 Second vertex in framebuffer space
+      * \param v2 Third vertex in framebuffer space
+      * \param texture Texture to sample, nullptr for none
+      * \param blendMode Blend mode of the draw call
+      * \param clip Rectangle (x1, y1, x2, y2) that may be written, x2 and y2 exclusive
+      */
+    void rasteriseTriangle(const graphics::RenderVertex& v0, const graphics::RenderVertex& v1,
+                           const graphics::RenderVertex& v2, const Texture* texture,
+                           int32_t blendMode, const int32_t* clip);
+
+    /** \brief Rasterises a one pixel wide line clipped to a rectangle of the framebuffer
+      * \param v0 Start in framebuffer space
+      * \param v1 End in framebuffer space
+      * \param texture Texture to sample, nullptr for none
+      * \param blendMode Blend mode of the draw call
+      * \param clip Rectangle (x1, y1, x2, y2) that may be written, x2 and y2 exclusive
+      */
+    void rasteriseLine(const graphics::RenderVertex& v0, const graphics::RenderVertex& v1,
+                       const Texture* texture, int32_t blendMode, const int32_t* clip);
+
+protected:
+    std::vector<uint32_t>                mPixels;          ///< Framebuffer as packed RGBA8
+    uint32_t                             mWidth;           ///< Width of the framebuffer
+    uint32_t                             mHeight;          ///< Height of the framebuffer
+    uint32_t                             mClearColour;     ///< Packed RGBA8 clear colour
+    uint32_t                             mTilesX;          ///< Number of tile columns
+    uint32_t                             mTilesY;          ///< Number of tile rows
+    float                                mFrameTime;       ///< Milliseconds spent on the last frame
+
+    graphics::RenderSnapshot             mSnapshot;        ///< Snapshot used by draw()
+    std::vector<graphics::RenderVertex>  mScreenVertices;  ///< Command vertices in framebuffer space
+    std::vector<Draw>                    mDraws;           ///< DRAW commands of the frame in order
+    std::vector<std::array<float, 6>>    mViewTransforms;  ///< Transform of every SETVIEW command of the frame
+    std::vector<Primitive>               mPrimitives;      ///< Primitives of the frame in draw order
+    std::vector<std::vector<uint32_t>>   mBins;            ///< Per chunk and tile, primitives touching the tile
+    uint32_t                             mBinChunkCount;   ///< Chunks of mPrimitives binned this frame
+
+    std::unordered_map<int32_t, Texture> mTextures;        ///< Textures keyed by atlas ID
+    TextureLoader                        mTextureLoader;   ///< Loads textures not given to setTexture()
+};
+
+#endif // _SOFTWARERENDERER_H
+}}
@@ -1,4 +1,5 @@
 #include "DeltaTime.h"
+#include <algorithm>
 
 namespace liquid { 
 namespace utilities {
@@ -6,6 +7,12 @@ namespace utilities {
     DeltaTime::DeltaTime()
     {
         mDelta = 0.0f;
+        mFrameDelta = 0.0f;
+        mFixedStep = 0.0f;
+        mAlpha = 1.0f;
+        mOversleep = 1.0f;
+        mInjected = 0.0f;
+        mSimulated = 0.0;
         mDeltaCache.resize(DELTA_CACHE_SIZE, 0.0f);
     }
 
@@ -15,10 +22,20 @@ namespace utilities {
     void DeltaTime::start()
     {
         mTickTime = mStartTime = mClock.now();
+        mSimulated = 0.0;
     }
 
     void DeltaTime::tick()
     {
+        if (mInjected > 0.0f)
+        {
+            std::fill(mDeltaCache.begin(), mDeltaCache.end(), mInjected);
+            mDelta = mFrameDelta = mInjected;
+            mSimulated += mInjected;
+            mTickTime = mClock.now();
+            return;
+        }
+
         float delta = std::chrono::duration_cast<
                       std::chrono::duration<float, std::milli>>
                       (mClock.now() - mTickTime).count();
@@ -28,16 +45,96 @@ namespace utilities {
 
         std::copy(mDeltaCache.begin() + 1, mDeltaCache.end(), mDeltaCache.begin());
         mDeltaCache[mDeltaCache.size() - 1] = delta;
+        mFrameDelta = delta;
         mTickTime = mClock.now();
     }
 
+    void DeltaTime::limitFrame(int32_t frameLimit)
+    {
+        if (frameLimit <= 0)
+            return;
+
+        typedef std::chrono::duration<float, std::milli> Milliseconds;
+        std::chrono::high_resolution_clock::time_point frameEnd = mTickTime +
+            std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+                Milliseconds(1000.0f / (float)frameLimit));
+
+        while (Milliseconds(frameEnd - mClock.now()).count() > mOversleep)
+        {
+            std::chrono::high_resolution_clock::time_point before = mClock.now();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+            recordSleep(Milliseconds(mClock.now() - before).count());
+        }
+
+        while (mClock.now() < frameEnd)
+            std::this_thread::yield();
+    }
+
+    void DeltaTime::recordSleep(float slept)
+    {
+        mOversleep += (slept - mOversleep) * OVERSLEEP_SMOOTHING;
+    }
+
+    float DeltaTime::getOversleep() const
+    {
+        return mOversleep;
+    }
+
+    void DeltaTime::setInjectedDelta(float delta)
+    {
+        mInjected = std::max(delta, 0.0f);
+        mSimulated = 0.0;
+    }
+
+    float DeltaTime::getInjectedDelta() const
+    {
+        return mInjected;
+    }
+
+    void DeltaTime::setFixedStep(float step)
+    {
+        mFixedStep = step;
+    }
+
+    void DeltaTime::setInterpolation(float alpha)
+    {
+        mAlpha = std::max(std::min(alpha, 1.0f), 0.0f);
+    }
+
     float DeltaTime::getDelta() const
+    {
+        if (mFixedStep > 0.0f)
+            return mFixedStep;
+
+        return mDelta;
+    }
+
+    float DeltaTime::getFrameDelta() const
+    {
+        return mFrameDelta;
+    }
+
+    float DeltaTime::getSmoothedDelta() const
     {
         return mDelta;
     }
 
+    float DeltaTime::getFixedStep() const
+    {
+        return mFixedStep;
+    }
+
+    float DeltaTime::getInterpolation() const
+    {
+        return mAlpha;
+    }
+
     float DeltaTime::getTimeSinceStart() const
     {
+        if (mInjected > 0.0f)
+            return (float)mSimulated;
+
         return std::chrono::duration_cast<
                std::chrono::duration<float, std::milli>>
                (mClock.now() - mStartTime).count();
@@ -1,5 +1,7 @@
 #include <vector>
 #include <chrono>
+#include <cstdint>
+#include <thread>
 
 namespace liquid { namespace utilities {
 #ifndef _DELTATIME_H
@@ -21,6 +23,10 @@ namespace liquid { namespace utilities {
 
 class DeltaTime
 {
+public:
+    /// Weight of the newest sleep slice in the oversleep estimate, older slices fade out
+    static constexpr float OVERSLEEP_SMOOTHING = 0.125f;
+
 private:
     /// DeltaTime Constructor
     DeltaTime();
@@ -41,9 +47,65 @@ public:
       */
     void tick();
 
-    /// \return The current delta between current and last frame (in milliseconds)
+    /** \brief Sleeps until the current frame has taken as long as the frame limit allows
+      * \param frameLimit Maximum frames per second, 0 or less disables limiting
+      *
+      * Sleeps in small slices while the remaining frame time is larger than the typical
+      * oversleep of a slice, then yields for the remainder. This keeps the frame cap
+      * accurate without busy-spinning the whole frame away.
+      */
+    void limitFrame(int32_t frameLimit);
+
+    /** \brief Folds the length of one sleep slice into the oversleep estimate
+      * \param slept Time the slice actually slept (in milliseconds)
+      *
+      * The estimate is a moving average, so a single slow wake-up from the OS raises
+      * it briefly and it settles back once slices return to normal.
+      */
+    void recordSleep(float slept);
+
+    /// \return Typical length of a sleep slice used by limitFrame() (in milliseconds)
+    float getOversleep() const;
+
+    /** \brief Replaces the wall clock with a constant delta for deterministic runs (in milliseconds)
+      * \param delta Delta every tick() reports, 0 returns to the wall clock
+      *
+      * While a delta is injected tick() advances a simulated clock instead of reading
+      * mClock, and getTimeSinceStart() reports that simulated clock, so a run produces
+      * the same results no matter how fast or slow the machine executes it.
+      */
+    void setInjectedDelta(float delta);
+
+    /// \return The injected delta (in milliseconds), 0 if the wall clock is used
+    float getInjectedDelta() const;
+
+    /** \brief Sets the fixed simulation step reported by getDelta() (in milliseconds)
+      * \param step Length of one simulation tick, 0 returns to variable stepping
+      */
+    void setFixedStep(float step);
+
+    /** \brief Sets how far the simulation is between the last tick and the next one
+      * \param alpha Interpolation factor (0 - 1) for the Renderer to blend states with
+      */
+    void setInterpolation(float alpha);
+
+    /** \brief Gets the delta the simulation should step by (in milliseconds)
+      * \return The fixed step when fixed stepping is enabled, otherwise the smoothed frame delta
+      */
     float getDelta() const;
 
+    /// \return The raw delta between the current and last frame (in milliseconds)
+    float getFrameDelta() const;
+
+    /// \return The delta averaged over the last DELTA_CACHE_SIZE frames (in milliseconds)
+    float getSmoothedDelta() const;
+
+    /// \return The fixed simulation step (in milliseconds), 0 if stepping is variable
+    float getFixedStep() const;
+
+    /// \return Interpolation factor (0 - 1) between the last and next simulation tick
+    float getInterpolation() const;
+
     /// \return Time elapsed since DeltaTime::start() was called (in milliseconds)
     float getTimeSinceStart() const;
 
@@ -52,6 +114,12 @@ public:
 
 protected:
     float                                          mDelta;      ///< Current delta between this and last frame (in milliseconds)
+    float                                          mFrameDelta; ///< Raw delta of the last frame (in milliseconds)
+    float                                          mFixedStep;  ///< Fixed simulation step (in milliseconds), 0 when variable
+    float                                          mAlpha;      ///< Interpolation factor between simulation ticks
+    float                                          mOversleep;  ///< Moving average length of a sleep slice (in milliseconds)
+    float                                          mInjected;   ///< Injected delta (in milliseconds), 0 when using the wall clock
+    double                                         mSimulated;  ///< Simulated time since start while a delta is injected (in milliseconds)
     std::vector<float>                             mDeltaCache; ///< Cache of the last X frames
     std::chrono::high_resolution_clock             mClock;      ///< Clock to be accessed to ask for current time
     std::chrono::high_resolution_clock::time_point mTickTime;   ///< Tick time point of the last frame
@@ -60,6 +128,7 @@ protected:
 
 #define DELTA DeltaTime::instance().getDelta()
 #define TIME DeltaTime::instance().getTimeSinceStart()
+#define INTERPOLATION DeltaTime::instance().getInterpolation()
 
 #endif // _DELTATIME_H
 }}
@@ -0,0 +1,186 @@
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+
+namespace liquid { namespace utilities {
+#ifndef _DEPTHSORTER_H
+#define _DEPTHSORTER_H
+
+/**
+ * \class DepthSorter
+ *
+ * \ingroup Utilities
+ * \brief Stable sort by a float key that is cheap when the order barely changes
+ *
+ * Meant for collections that are sorted every frame, like Entities drawn by their Y
+ * coordinate. Between two frames only a few of them move past a neighbour, so the
+ * previous result is kept as the input of the next sort: an already sorted input
+ * costs one pass over the keys and a nearly sorted one is fixed by insertion sort.
+ * Only when insertion sort exceeds its budget of moves does it fall back to a least
+ * significant digit radix sort over the 32-bit keys.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+template <class T>
+class DepthSorter
+{
+public:
+    /// How the last sort() ordered the items
+    enum eSortMethod
+    {
+        SORTMETHOD_NONE = 0,      ///< Already in order
+        SORTMETHOD_INSERTION = 1, ///< Nearly in order, fixed in place
+        SORTMETHOD_RADIX = 2,     ///< Reordered by a full radix sort
+    };
+
+    /// Moves insertion sort may make per item before falling back to radix sort
+    static const uint32_t INSERTION_BUDGET = 4;
+
+public:
+    /// DepthSorter Constructor
+    DepthSorter()
+    {
+        mLastMethod = SORTMETHOD_NONE;
+    }
+
+    /** \brief Converts a float into a key with the same order
+      * \param depth Value to convert, any finite float
+      * \return Key that compares like depth does
+      */
+    static uint32_t toKey(float depth)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &depth, sizeof(float));
+
+        // Negative floats sort backwards, flipping every bit puts them below the positives
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+
+    /** \brief Sorts items by ascending key, equal keys keep their order
+      * \param items Items to sort in place
+      * \param keyFunc Callable returning the uint32_t key of an item, see toKey()
+      * \return True if the order of the items changed
+      */
+    template <typename KeyFunc>
+    bool sort(std::vector<T>& items, KeyFunc keyFunc)
+    {
+        uint32_t count = items.size();
+        mEntries.resize(count);
+
+        bool ordered = true;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            mEntries[i].mKey = keyFunc(items[i]);
+            mEntries[i].mIndex = i;
+            ordered = ordered && (i == 0 || mEntries[i - 1].mKey <= mEntries[i].mKey);
+        }
+
+        if (ordered)
+        {
+            mLastMethod = SORTMETHOD_NONE;
+            return false;
+        }
+
+        if (insertionSort())
+            mLastMethod = SORTMETHOD_INSERTION;
+        else
+        {
+            radixSort();
+            mLastMethod = SORTMETHOD_RADIX;
+        }
+
+        mItems.resize(count);
+        for (uint32_t i = 0; i < count; i++)
+            mItems[i] = items[mEntries[i].mIndex];
+
+        items.swap(mItems);
+        return true;
+    }
+
+    /// \return How the last sort() ordered the items
+    const eSortMethod getLastMethod() const
+    {
+        return mLastMethod;
+    }
+
+protected:
+    /// Key of an item and where it was before sorting
+    struct Entry
+    {
+        uint32_t mKey;   ///< Sort key of the item
+        uint32_t mIndex; ///< Index of the item in the input
+    };
+
+    /** \brief Insertion sorts mEntries, giving up after its budget of moves
+      * \return True if sorted, False if the budget ran out and mEntries is only partly sorted
+      */
+    bool insertionSort()
+    {
+        uint64_t budget = (uint64_t)mEntries.size() * INSERTION_BUDGET;
+        for (uint32_t i = 1; i < mEntries.size(); i++)
+        {
+            Entry entry = mEntries[i];
+            uint32_t j = i;
+            while (j > 0 && mEntries[j - 1].mKey > entry.mKey)
+            {
+                mEntries[j] = mEntries[j - 1];
+                j--;
+
+                if (budget-- == 0)
+                {
+                    mEntries[j] = entry;
+                    return false;
+                }
+            }
+
+            mEntries[j] = entry;
+        }
+
+        return true;
+    }
+
+    /// \brief Stable least significant digit radix sort of mEntries
+    void radixSort()
+    {
+        mScratch.resize(mEntries.size());
+        uint32_t counts[256];
+
+        for (uint32_t shift = 0; shift < 32; shift += 8)
+        {
+            std::fill(counts, counts + 256, 0);
+            for (const Entry& entry : mEntries)
+                counts[(entry.mKey >> shift) & 0xFF]++;
+
+            // Every key shares this byte, the pass would not move anything
+            if (counts[(mEntries[0].mKey >> shift) & 0xFF] == mEntries.size())
+                continue;
+
+            uint32_t offset = 0;
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                uint32_t bucket = counts[i];
+                counts[i] = offset;
+                offset += bucket;
+            }
+
+            for (const Entry& entry : mEntries)
+                mScratch[counts[(entry.mKey >> shift) & 0xFF]++] = entry;
+
+            mEntries.swap(mScratch);
+        }
+    }
+
+protected:
+    std::vector<Entry> mEntries;    ///< Keys of the items being sorted
+    std::vector<Entry> mScratch;    ///< Second buffer the radix sort ping-pongs with
+    std::vector<T>     mItems;      ///< Items in sorted order before being swapped in
+    eSortMethod        mLastMethod; ///< How the last sort() ordered the items
+};
+
+#endif // _DEPTHSORTER_H
+}}
@@ -0,0 +1,122 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace liquid {
+namespace utilities {
+
+    MappedFile::MappedFile()
+    {
+        mData = nullptr;
+        mSize = 0;
+        mFile = nullptr;
+        mMapping = nullptr;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    bool MappedFile::open(std::string file)
+    {
+        close();
+
+#ifdef _WIN32
+        HANDLE handle = CreateFileA(file.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                                    OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (handle == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size;
+        if (GetFileSizeEx(handle, &size) == FALSE || size.QuadPart == 0)
+        {
+            CloseHandle(handle);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            CloseHandle(handle);
+            return false;
+        }
+
+        mData = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (mData == nullptr)
+        {
+            CloseHandle(mapping);
+            CloseHandle(handle);
+            return false;
+        }
+
+        mFile = handle;
+        mMapping = mapping;
+        mSize = size.QuadPart;
+#else
+        int descriptor = ::open(file.c_str(), O_RDONLY);
+        if (descriptor < 0)
+            return false;
+
+        struct stat info;
+        if (fstat(descriptor, &info) != 0 || info.st_size == 0)
+        {
+            ::close(descriptor);
+            return false;
+        }
+
+        void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        ::close(descriptor);
+
+        if (data == MAP_FAILED)
+            return false;
+
+        mData = (const uint8_t*)data;
+        mSize = info.st_size;
+#endif
+
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if (mData == nullptr)
+            return;
+
+#ifdef _WIN32
+        UnmapViewOfFile(mData);
+        CloseHandle((HANDLE)mMapping);
+        CloseHandle((HANDLE)mFile);
+#else
+        munmap((void*)mData, mSize);
+#endif
+
+        mData = nullptr;
+        mSize = 0;
+        mFile = nullptr;
+        mMapping = nullptr;
+    }
+
+    const uint8_t* MappedFile::getData() const
+    {
+        return mData;
+    }
+
+    const uint64_t MappedFile::getSize() const
+    {
+        return mSize;
+    }
+
+    const bool MappedFile::isOpen() const
+    {
+        return mData != nullptr;
+    }
+
+}}
@@ -0,0 +1,62 @@
+#include <string>
+#include <stdint.h>
+
+namespace liquid { namespace utilities {
+#ifndef _MAPPEDFILE_H
+#define _MAPPEDFILE_H
+
+/**
+ * \class MappedFile
+ *
+ * \ingroup Utilities
+ * \brief Read-only memory mapping of a whole file
+ *
+ * Lets large binary files be read in place instead of copied into a buffer first,
+ * the operating system pages the contents in as they are touched.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class MappedFile
+{
+public:
+    /// MappedFile Constructor
+    MappedFile();
+
+    /// MappedFile Destructor, unmaps the file if still open
+    ~MappedFile();
+
+    /** \brief Maps the given file into memory
+      * \param file Path of the file to map
+      * \return True if the file was mapped, False otherwise
+      */
+    bool open(std::string file);
+
+    /// \brief Unmaps the file
+    void close();
+
+    /// \return Pointer to the first byte of the file, nullptr if not open
+    const uint8_t* getData() const;
+
+    /// \return Size of the mapped file in bytes
+    const uint64_t getSize() const;
+
+    /// \return True if a file is currently mapped
+    const bool isOpen() const;
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+protected:
+    const uint8_t* mData;    ///< First byte of the mapping
+    uint64_t       mSize;    ///< Size of the mapping in bytes
+    void*          mFile;    ///< Native file handle (Windows only)
+    void*          mMapping; ///< Native mapping handle (Windows only)
+};
+
+#endif // _MAPPEDFILE_H
+}}
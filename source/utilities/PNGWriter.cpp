@@ -0,0 +1,112 @@
+#include "PNGWriter.h"
+#include <array>
+#include <cstdio>
+#include <cstring>
+
+namespace liquid {
+namespace utilities {
+
+    bool PNGWriter::write(std::string file, uint32_t width, uint32_t height, const uint8_t* pixels)
+    {
+        if (width == 0 || height == 0 || pixels == nullptr)
+            return false;
+
+        std::vector<uint8_t> output = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+        // 8 bits per channel, colour type 6 (RGBA), no interlacing
+        std::vector<uint8_t> header;
+        appendUint32(header, width);
+        appendUint32(header, height);
+        header.insert(header.end(), { 8, 6, 0, 0, 0 });
+        appendChunk(output, "IHDR", header);
+
+        // Every row is prefixed with filter type 0, then split into stored deflate blocks
+        const size_t rowBytes = (size_t)width * 4 + 1;
+        const size_t rawBytes = rowBytes * height;
+        const size_t blockBytes = 65535;
+
+        std::vector<uint8_t> raw(rawBytes);
+        for (uint32_t y = 0; y < height; y++)
+        {
+            raw[y * rowBytes] = 0;
+            std::memcpy(&raw[y * rowBytes + 1], pixels + (size_t)y * width * 4, (size_t)width * 4);
+        }
+
+        std::vector<uint8_t> compressed = { 0x78, 0x01 };
+        compressed.reserve(rawBytes + (rawBytes / blockBytes + 1) * 5 + 6);
+
+        for (size_t offset = 0; offset < rawBytes; offset += blockBytes)
+        {
+            uint16_t length = (uint16_t)((rawBytes - offset < blockBytes) ? rawBytes - offset : blockBytes);
+            compressed.push_back((offset + length == rawBytes) ? 1 : 0);
+            compressed.push_back(length & 0xFF);
+            compressed.push_back(length >> 8);
+            compressed.push_back(~length & 0xFF);
+            compressed.push_back((~length >> 8) & 0xFF);
+            compressed.insert(compressed.end(), raw.begin() + offset, raw.begin() + offset + length);
+        }
+
+        uint32_t adlerA = 1, adlerB = 0;
+        for (uint8_t byte : raw)
+        {
+            adlerA = (adlerA + byte) % 65521;
+            adlerB = (adlerB + adlerA) % 65521;
+        }
+
+        appendUint32(compressed, (adlerB << 16) | adlerA);
+        appendChunk(output, "IDAT", compressed);
+        appendChunk(output, "IEND", std::vector<uint8_t>());
+
+        FILE* handle = std::fopen(file.c_str(), "wb");
+        if (handle == nullptr)
+            return false;
+
+        bool written = std::fwrite(output.data(), 1, output.size(), handle) == output.size();
+        std::fclose(handle);
+        return written;
+    }
+
+    void PNGWriter::appendChunk(std::vector<uint8_t>& output, const char* type, const std::vector<uint8_t>& data)
+    {
+        appendUint32(output, (uint32_t)data.size());
+        size_t start = output.size();
+
+        output.insert(output.end(), type, type + 4);
+        output.insert(output.end(), data.begin(), data.end());
+        appendUint32(output, crc32(0, &output[start], output.size() - start));
+    }
+
+    void PNGWriter::appendUint32(std::vector<uint8_t>& output, uint32_t value)
+    {
+        output.push_back((value >> 24) & 0xFF);
+        output.push_back((value >> 16) & 0xFF);
+        output.push_back((value >> 8) & 0xFF);
+        output.push_back(value & 0xFF);
+    }
+
+    uint32_t PNGWriter::crc32(uint32_t crc, const uint8_t* data, size_t size)
+    {
+        // Built once, function local statics are initialised thread safely
+        static const std::array<uint32_t, 256> table = []()
+        {
+            std::array<uint32_t, 256> entries;
+            for (uint32_t n = 0; n < 256; n++)
+            {
+                uint32_t c = n;
+                for (uint32_t k = 0; k < 8; k++)
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+
+                entries[n] = c;
+            }
+
+            return entries;
+        }();
+
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++)
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+
+        return ~crc;
+    }
+
+}}
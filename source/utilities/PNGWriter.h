@@ -0,0 +1,53 @@
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace liquid { namespace utilities {
+#ifndef _PNGWRITER_H
+#define _PNGWRITER_H
+
+/**
+ * \class PNGWriter
+ *
+ * \ingroup Utilities
+ * \brief Writes RGBA8 images as PNG files without any external library
+ *
+ * The image data is stored in uncompressed deflate blocks, files are larger than
+ * a compressed PNG but any viewer or image library reads them and writing costs no
+ * more than copying the pixels. Meant for frame dumps and golden images.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class PNGWriter
+{
+public:
+    /** \brief Writes an image to disk
+      * \param file Path of the file to write
+      * \param width Width of the image in pixels
+      * \param height Height of the image in pixels
+      * \param pixels Rows of RGBA8 pixels, top row first
+      * \return True if the file was written
+      */
+    static bool write(std::string file, uint32_t width, uint32_t height, const uint8_t* pixels);
+
+protected:
+    /** \brief Appends a chunk with its length and CRC
+      * \param output Bytes of the file so far
+      * \param type Four character chunk type
+      * \param data Contents of the chunk
+      */
+    static void appendChunk(std::vector<uint8_t>& output, const char* type, const std::vector<uint8_t>& data);
+
+    /// \brief Appends a 32-bit value in network byte order
+    static void appendUint32(std::vector<uint8_t>& output, uint32_t value);
+
+    /// \return CRC-32 of the given bytes continuing from crc, as used by PNG chunks
+    static uint32_t crc32(uint32_t crc, const uint8_t* data, size_t size);
+};
+
+#endif // _PNGWRITER_H
+}}
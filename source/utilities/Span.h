@@ -0,0 +1,216 @@
+#include <vector>
+#include <stdint.h>
+#include <type_traits>
+
+namespace liquid { namespace utilities {
+#ifndef _SPAN_H
+#define _SPAN_H
+
+/**
+ * \class Span
+ *
+ * \ingroup Utilities
+ * \brief Non-owning view over a contiguous run of T, returned instead of copying a std::vector
+ *
+ * A Span is only valid while the container it was taken from is alive and not
+ * resized, so keep it for the duration of a loop rather than storing it. Call
+ * toVector() when a copy that outlives the container is really needed.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+template <typename T>
+class Span
+{
+public:
+    typedef typename std::remove_const<T>::type ValueType;
+    typedef T* Iterator;
+
+public:
+    /// Span Constructor, empty view
+    Span() : mData(nullptr), mSize(0) {}
+
+    /** \brief Span Constructor
+      * \param data Pointer to the first element
+      * \param size Number of elements in the view
+      */
+    Span(T* data, uint32_t size) : mData(data), mSize(size) {}
+
+    /** \brief Span Constructor
+      * \param vector Container to view, must outlive the Span
+      */
+    Span(std::vector<ValueType>& vector) : mData(vector.data()), mSize(vector.size()) {}
+
+    /** \brief Span Constructor
+      * \param vector Container to view, must outlive the Span
+      */
+    template <typename U = T, typename = typename std::enable_if<std::is_const<U>::value>::type>
+    Span(const std::vector<ValueType>& vector) : mData(vector.data()), mSize(vector.size()) {}
+
+    /// \return Iterator to the first element
+    Iterator begin() const { return mData; }
+
+    /// \return Iterator one past the last element
+    Iterator end() const { return mData + mSize; }
+
+    /// \return Element at the given index, unchecked
+    T& operator[](uint32_t index) const { return mData[index]; }
+
+    /// \return First element, the Span must not be empty
+    T& front() const { return mData[0]; }
+
+    /// \return Last element, the Span must not be empty
+    T& back() const { return mData[mSize - 1]; }
+
+    /// \return Pointer to the first element
+    T* data() const { return mData; }
+
+    /// \return Number of elements in the view
+    const uint32_t size() const { return mSize; }
+
+    /// \return True if the view has no elements
+    const bool empty() const { return mSize == 0; }
+
+    /// \return Owning copy of the elements
+    std::vector<ValueType> toVector() const { return std::vector<ValueType>(mData, mData + mSize); }
+
+protected:
+    T*       mData; ///< First element of the view
+    uint32_t mSize; ///< Number of elements in the view
+};
+
+/**
+ * \class ConcatView
+ *
+ * \ingroup Utilities
+ * \brief Non-owning view that iterates several Spans back to back as if they were one
+ *
+ * The Spans are fetched lazily from each source through an accessor, for example
+ * every Entity of every Layer in a GameScene, so building and iterating the view
+ * never allocates. The sources can be visited last to first, the elements of each
+ * source are always visited in order.
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+template <typename Source, typename T>
+class ConcatView
+{
+public:
+    typedef typename std::remove_const<T>::type ValueType;
+    typedef Span<T> (*Accessor)(const Source*);
+
+    /// Forward iterator over every element of every source
+    class Iterator
+    {
+    public:
+        Iterator(const ConcatView* view, uint32_t source) : mView(view), mSource(source), mIndex(0)
+        {
+            skipEmpty();
+        }
+
+        T& operator*() const { return mCurrent[mIndex]; }
+        T* operator->() const { return &mCurrent[mIndex]; }
+
+        Iterator& operator++()
+        {
+            if (++mIndex >= mCurrent.size())
+            {
+                mSource++;
+                mIndex = 0;
+                skipEmpty();
+            }
+
+            return *this;
+        }
+
+        bool operator==(const Iterator& other) const { return mSource == other.mSource && mIndex == other.mIndex; }
+        bool operator!=(const Iterator& other) const { return (*this == other) == false; }
+
+    protected:
+        /// \brief Advances to the next source with any elements, or to the end
+        void skipEmpty()
+        {
+            while (mSource < mView->mSources.size())
+            {
+                mCurrent = mView->mAccessor(mView->getSource(mSource));
+                if (mCurrent.empty() == false)
+                    return;
+
+                mSource++;
+            }
+
+            mCurrent = Span<T>();
+        }
+
+    protected:
+        const ConcatView* mView;    ///< View being iterated
+        uint32_t          mSource;  ///< Position of the current source in visiting order
+        uint32_t          mIndex;   ///< Index into the current source's Span
+        Span<T>           mCurrent; ///< Span of the current source
+    };
+
+public:
+    /** \brief ConcatView Constructor
+      * \param sources Sources to concatenate, in order
+      * \param accessor Captureless function returning the Span of one source
+      * \param reversed True to visit the sources from the last to the first
+      */
+    ConcatView(Span<Source* const> sources, Accessor accessor, bool reversed = false) :
+        mSources(sources), mAccessor(accessor), mReversed(reversed) {}
+
+    /// \return Iterator to the first element of the first non-empty source
+    Iterator begin() const { return Iterator(this, 0); }
+
+    /// \return Iterator one past the last element
+    Iterator end() const { return Iterator(this, mSources.size()); }
+
+    /// \return Total number of elements across every source
+    const uint32_t size() const
+    {
+        uint32_t count = 0;
+        for (Source* source : mSources)
+            count += mAccessor(source).size();
+
+        return count;
+    }
+
+    /// \return True if no source has any elements
+    const bool empty() const { return begin() == end(); }
+
+    /// \return Owning copy of the elements, in order
+    std::vector<ValueType> toVector() const
+    {
+        std::vector<ValueType> elements;
+        elements.reserve(size());
+
+        for (uint32_t s = 0; s < mSources.size(); s++)
+        {
+            Span<T> span = mAccessor(getSource(s));
+            elements.insert(elements.end(), span.begin(), span.end());
+        }
+
+        return elements;
+    }
+
+protected:
+    /// \return Source visited at the given position
+    Source* getSource(uint32_t position) const
+    {
+        return mSources[mReversed ? mSources.size() - 1 - position : position];
+    }
+
+protected:
+    Span<Source* const> mSources;  ///< Sources to concatenate
+    Accessor            mAccessor; ///< Fetches the Span of a source
+    bool                mReversed; ///< Visits the sources from the last to the first
+};
+
+#endif // _SPAN_H
+}}
@@ -0,0 +1,172 @@
+#include "ThreadPool.h"
+
+namespace liquid {
+namespace utilities {
+
+    ThreadPool::ThreadPool(uint32_t threadCount)
+    {
+        mRunning = 0;
+        mStopping = false;
+        mParallelJob = nullptr;
+        mParallelGeneration = 0;
+
+        if (threadCount == 0)
+        {
+            uint32_t hardwareThreads = std::thread::hardware_concurrency();
+            threadCount = (hardwareThreads > 1) ? hardwareThreads - 1 : 1;
+        }
+
+        for (uint32_t i = 0; i < threadCount; i++)
+            mThreads.push_back(std::thread(&ThreadPool::workerLoop, this));
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+
+        mWake.notify_all();
+        for (std::thread& thread : mThreads)
+            thread.join();
+
+        mThreads.clear();
+    }
+
+    void ThreadPool::submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mTasks.push_back(std::move(task));
+        }
+
+        mWake.notify_one();
+    }
+
+    void ThreadPool::waitIdle()
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mIdle.wait(lock, [this]() { return mTasks.empty() && mRunning == 0; });
+    }
+
+    void ThreadPool::runParallel(uint32_t count, ParallelBody body, const void* context)
+    {
+        if (count == 0)
+            return;
+
+        if (count == 1 || mThreads.empty())
+        {
+            for (uint32_t i = 0; i < count; i++)
+                body(context, i);
+            return;
+        }
+
+        std::lock_guard<std::mutex> parallelLock(mParallelMutex);
+
+        ParallelJob job;
+        job.mBody = body;
+        job.mContext = context;
+        job.mCount = count;
+        job.mNext = 0;
+        job.mWorkers = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mParallelJob = &job;
+            mParallelGeneration++;
+        }
+
+        mWake.notify_all();
+        runParallelJob(job);
+
+        // Stop new workers joining, then wait for the ones that did as job is on this stack
+        std::unique_lock<std::mutex> lock(mMutex);
+        mParallelJob = nullptr;
+        mIdle.wait(lock, [&job]() { return job.mWorkers == 0; });
+    }
+
+    void ThreadPool::runParallelJob(ParallelJob& job)
+    {
+        uint32_t index;
+        while ((index = job.mNext.fetch_add(1)) < job.mCount)
+            job.mBody(job.mContext, index);
+    }
+
+    const uint32_t ThreadPool::getThreadCount() const
+    {
+        return mThreads.size();
+    }
+
+    const uint32_t ThreadPool::getPendingCount()
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        return mTasks.size() + mRunning;
+    }
+
+    ThreadPool& ThreadPool::instance()
+    {
+        static ThreadPool singleton;
+        return singleton;
+    }
+
+    void ThreadPool::workerLoop()
+    {
+        uint32_t generation = 0;
+
+        while (true)
+        {
+            std::function<void()> task;
+            ParallelJob* job = nullptr;
+
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mWake.wait(lock, [this, &generation]() {
+                    return mStopping || mTasks.empty() == false ||
+                           (mParallelJob != nullptr && mParallelGeneration != generation);
+                });
+
+                // A parallelFor() has someone waiting on it, so it goes before queued tasks
+                if (mParallelJob != nullptr && mParallelGeneration != generation)
+                {
+                    job = mParallelJob;
+                    generation = mParallelGeneration;
+                    job->mWorkers++;
+                }
+                else
+                {
+                    // Drain the queue before stopping so no submitted work is lost
+                    if (mTasks.empty())
+                        return;
+
+                    task = std::move(mTasks.front());
+                    mTasks.pop_front();
+                    mRunning++;
+                }
+            }
+
+            if (job != nullptr)
+            {
+                runParallelJob(*job);
+
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    job->mWorkers--;
+                }
+
+                mIdle.notify_all();
+                continue;
+            }
+
+            task();
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mRunning--;
+            }
+
+            mIdle.notify_all();
+        }
+    }
+
+}}
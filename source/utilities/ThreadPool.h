@@ -0,0 +1,118 @@
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <stdint.h>
+
+namespace liquid { namespace utilities {
+#ifndef _THREADPOOL_H
+#define _THREADPOOL_H
+
+/**
+ * \class ThreadPool
+ *
+ * \ingroup Utilities
+ * \brief Fixed set of worker threads that run queued tasks in submission order
+ *
+ * Systems that need background work (streaming, batching and so on) either create
+ * their own ThreadPool, when their tasks may block for a long time, or share the
+ * engine wide one returned by ThreadPool::instance().
+ *
+ * \author Jamie Massey
+ * \version 1.0
+ * \date 19/10/2026
+ *
+ */
+
+class ThreadPool
+{
+public:
+    /** \brief ThreadPool Constructor
+      * \param threadCount Number of worker threads, 0 picks one less than the hardware threads
+      */
+    ThreadPool(uint32_t threadCount = 0);
+
+    /// ThreadPool Destructor, finishes every queued task before joining the workers
+    ~ThreadPool();
+
+    /** \brief Queues a task to be run on one of the worker threads
+      * \param task Function to run, must not throw
+      */
+    void submit(std::function<void()> task);
+
+    /// \brief Blocks until the queue is empty and no task is running
+    void waitIdle();
+
+    /** \brief Runs body(i) for every i in [0, count) across the workers and the calling thread
+      * \param count Number of indices to run
+      * \param body Callable taking a uint32_t index, must not throw
+      *
+      * Returns once every index has run. Idle workers pick indices up ahead of any
+      * queued task, busy ones are not waited for, and nothing is allocated so it is
+      * safe to call every frame. Calls are serialised and must not be nested.
+      */
+    template <typename Function>
+    void parallelFor(uint32_t count, const Function& body)
+    {
+        runParallel(count, [](const void* context, uint32_t index) {
+            (*static_cast<const Function*>(context))(index);
+        }, &body);
+    }
+
+    /// \return Number of worker threads
+    const uint32_t getThreadCount() const;
+
+    /// \return Number of tasks queued or running
+    const uint32_t getPendingCount();
+
+    /// \return The engine wide ThreadPool (singleton)
+    static ThreadPool& instance();
+
+protected:
+    /// Type-erased body of a parallelFor()
+    typedef void(*ParallelBody)(const void* context, uint32_t index);
+
+    /// The parallelFor() currently running, lives on the caller's stack
+    struct ParallelJob
+    {
+        ParallelBody          mBody;    ///< Function run for every index
+        const void*           mContext; ///< Callable passed to parallelFor()
+        uint32_t              mCount;   ///< Number of indices
+        std::atomic<uint32_t> mNext;    ///< Next index to be claimed
+        uint32_t              mWorkers; ///< Workers still running the job, guarded by mMutex
+    };
+
+    /** \brief Shares indices of a body between the caller and idle workers
+      * \param count Number of indices
+      * \param body Function run for every index
+      * \param context Passed through to body
+      */
+    void runParallel(uint32_t count, ParallelBody body, const void* context);
+
+    /** \brief Claims and runs indices of a ParallelJob until none are left
+      * \param job Job to work on
+      */
+    static void runParallelJob(ParallelJob& job);
+
+    /// \brief Body of each worker thread
+    void workerLoop();
+
+protected:
+    std::vector<std::thread>          mThreads;   ///< Worker threads
+    std::deque<std::function<void()>> mTasks;     ///< Tasks waiting for a worker
+    std::mutex                        mMutex;     ///< Guards mTasks, mRunning and mStopping
+    std::condition_variable           mWake;      ///< Signalled when a task is queued or on shutdown
+    std::condition_variable           mIdle;      ///< Signalled when a task finishes
+    uint32_t                          mRunning;   ///< Number of tasks currently running
+    bool                              mStopping;  ///< Set when the workers should exit
+
+    std::mutex   mParallelMutex;      ///< Serialises parallelFor() callers
+    ParallelJob* mParallelJob;        ///< Job workers may join, nullptr once the caller is done
+    uint32_t     mParallelGeneration; ///< Incremented per job so a worker joins each one once
+};
+
+#endif // _THREADPOOL_H
+}}
@@ -8,6 +8,7 @@ namespace utilities {
         mPosition = { 0.0f, 0.0f };
         mColour = { 255.0f, 255.0f, 255.0f, 255.0f };
         mTexCoord = { 0.0f, 0.0f };
+        mChanged = true;
     }
 
     Vertex2::Vertex2(std::array<float, 2> position, std::array<float, 4> colour, std::array<float, 2> texCoord)
@@ -15,6 +16,7 @@ namespace utilities {
         mPosition = position;
         mColour = colour;
         mTexCoord = texCoord;
+        mChanged = true;
     }
 
     Vertex2::~Vertex2()